@@ -47,7 +47,7 @@ extern "C" {
 
 #define FX_APP_MEM_POOL_SIZE                     65536
 
-#define UX_HOST_APP_MEM_POOL_SIZE                65536
+#define UX_HOST_APP_MEM_POOL_SIZE                81920
 
 #define TOUCHGFX_APP_MEM_POOL_SIZE               32768
 
@@ -163,6 +163,7 @@ int main(void)
   log_msg(3, "Configuring media...");
   fs_register_type(FS_MEDIA_SD, FS_SD_ROOT, fx_stm32_sd_driver);
   fs_register_type(FS_MEDIA_USB, FS_USB_ROOT, _ux_host_class_storage_driver_entry);
+  fs_register_type(FS_MEDIA_RAM, FS_RAM_ROOT, fs_ram_driver);
   log_msg(3, "Starting RTOS...");
   /* USER CODE END 2 */
 
@@ -22,6 +22,7 @@
 #include "stm32u5xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "os_bindings.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -181,11 +182,11 @@ void DebugMon_Handler(void)
 void EXTI6_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI6_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END EXTI6_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(CTP_INT_Pin);
   /* USER CODE BEGIN EXTI6_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END EXTI6_IRQn 1 */
 }
 
@@ -195,11 +196,11 @@ void EXTI6_IRQHandler(void)
 void GPDMA1_Channel0_IRQHandler(void)
 {
   /* USER CODE BEGIN GPDMA1_Channel0_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END GPDMA1_Channel0_IRQn 0 */
   HAL_DMA_IRQHandler(&handle_GPDMA1_Channel0);
   /* USER CODE BEGIN GPDMA1_Channel0_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END GPDMA1_Channel0_IRQn 1 */
 }
 
@@ -209,11 +210,11 @@ void GPDMA1_Channel0_IRQHandler(void)
 void GPDMA1_Channel1_IRQHandler(void)
 {
   /* USER CODE BEGIN GPDMA1_Channel1_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END GPDMA1_Channel1_IRQn 0 */
   HAL_DMA_IRQHandler(&handle_GPDMA1_Channel1);
   /* USER CODE BEGIN GPDMA1_Channel1_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END GPDMA1_Channel1_IRQn 1 */
 }
 
@@ -223,11 +224,11 @@ void GPDMA1_Channel1_IRQHandler(void)
 void GPDMA1_Channel2_IRQHandler(void)
 {
   /* USER CODE BEGIN GPDMA1_Channel2_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END GPDMA1_Channel2_IRQn 0 */
   HAL_DMA_IRQHandler(&handle_GPDMA1_Channel2);
   /* USER CODE BEGIN GPDMA1_Channel2_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END GPDMA1_Channel2_IRQn 1 */
 }
 
@@ -237,12 +238,12 @@ void GPDMA1_Channel2_IRQHandler(void)
 void ADC1_2_IRQHandler(void)
 {
   /* USER CODE BEGIN ADC1_2_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END ADC1_2_IRQn 0 */
   HAL_ADC_IRQHandler(&hadc1);
   HAL_ADC_IRQHandler(&hadc2);
   /* USER CODE BEGIN ADC1_2_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END ADC1_2_IRQn 1 */
 }
 
@@ -252,11 +253,11 @@ void ADC1_2_IRQHandler(void)
 void DAC1_IRQHandler(void)
 {
   /* USER CODE BEGIN DAC1_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END DAC1_IRQn 0 */
   HAL_DAC_IRQHandler(&hdac1);
   /* USER CODE BEGIN DAC1_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END DAC1_IRQn 1 */
 }
 
@@ -266,11 +267,11 @@ void DAC1_IRQHandler(void)
 void TIM2_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM2_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END TIM2_IRQn 0 */
   HAL_TIM_IRQHandler(&htim2);
   /* USER CODE BEGIN TIM2_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END TIM2_IRQn 1 */
 }
 
@@ -280,11 +281,11 @@ void TIM2_IRQHandler(void)
 void OTG_HS_IRQHandler(void)
 {
   /* USER CODE BEGIN OTG_HS_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END OTG_HS_IRQn 0 */
   HAL_HCD_IRQHandler(&hhcd_USB_OTG_HS);
   /* USER CODE BEGIN OTG_HS_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END OTG_HS_IRQn 1 */
 }
 
@@ -294,11 +295,11 @@ void OTG_HS_IRQHandler(void)
 void SDMMC1_IRQHandler(void)
 {
   /* USER CODE BEGIN SDMMC1_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END SDMMC1_IRQn 0 */
   HAL_SD_IRQHandler(&hsd1);
   /* USER CODE BEGIN SDMMC1_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END SDMMC1_IRQn 1 */
 }
 
@@ -308,11 +309,11 @@ void SDMMC1_IRQHandler(void)
 void GPU2D_IRQHandler(void)
 {
   /* USER CODE BEGIN GPU2D_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END GPU2D_IRQn 0 */
   HAL_GPU2D_IRQHandler(&hgpu2d);
   /* USER CODE BEGIN GPU2D_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END GPU2D_IRQn 1 */
 }
 
@@ -322,11 +323,11 @@ void GPU2D_IRQHandler(void)
 void GPU2D_ER_IRQHandler(void)
 {
   /* USER CODE BEGIN GPU2D_ER_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END GPU2D_ER_IRQn 0 */
   HAL_GPU2D_ER_IRQHandler(&hgpu2d);
   /* USER CODE BEGIN GPU2D_ER_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END GPU2D_ER_IRQn 1 */
 }
 
@@ -336,11 +337,11 @@ void GPU2D_ER_IRQHandler(void)
 void LTDC_IRQHandler(void)
 {
   /* USER CODE BEGIN LTDC_IRQn 0 */
-
+  os_profiler_isr_enter();
   /* USER CODE END LTDC_IRQn 0 */
   HAL_LTDC_IRQHandler(&hltdc);
   /* USER CODE BEGIN LTDC_IRQn 1 */
-
+  os_profiler_isr_exit();
   /* USER CODE END LTDC_IRQn 1 */
 }
 
@@ -63,6 +63,10 @@ ALIGN_32BYTES (uint32_t fx_sd_media_memory[FX_STM32_SD_DEFAULT_SECTOR_SIZE / siz
 FX_MEDIA        sdio_disk;
 
 /* USER CODE BEGIN PV */
+
+// The SD sector cache, FileX uses the whole buffer up to FX_MAX_SECTOR_CACHE sectors.
+ALIGN_32BYTES (uint32_t fx_sd_media_cache[WTK_FS_MEDIA_CACHE / sizeof(uint32_t)]) __attribute__((section(WTK_FS_MEDIA_CACHE_SECTION)));
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -85,8 +89,8 @@ bool fx_mount_sd_card()
     FX_SD_VOLUME_NAME,          // Pointer to media name string.
     fx_stm32_sd_driver,         // Media driver entry function.
     NULL,                       // Optional information pointer supplied to media driver.
-    (void*)fx_sd_media_memory,  // Pointer to memory used by the FileX for this media.
-    sizeof(fx_sd_media_memory)  // Size of media memory - must be at least 512 bytes and one sector size.
+    (void*)fx_sd_media_cache,   // Pointer to memory used by the FileX for this media.
+    sizeof(fx_sd_media_cache)   // Size of media memory - must be at least 512 bytes and one sector size.
   );
   if (status == FX_SUCCESS)
   {
@@ -167,6 +171,8 @@ UINT MX_FileX_Init(VOID *memory_ptr)
 /* USER CODE BEGIN fx_app_thread_entry 0*/
   // We initialize SD card here, to avoid crashing the app if SD card is not present.
   fx_mount_sd_card();
+  if (fs_ram_mount()) log_msg(3, "FILEX: RAM disk mounted as \"%s\".", FS_RAM_ROOT);
+  else log_msg(0, "FILEX: RAM disk ERROR.");
   HMI_SD_OK // So we can have it initialized even without SD card.
   return;
 /* USER CODE END fx_app_thread_entry 0*/
@@ -18,6 +18,7 @@ EXTERN_C_BEGIN
 EXTERN_C_END
 #include "Action.hpp"
 #include "IData.hpp"
+#include "Seqlock.hpp"
 
 /// @brief ADC observer API.
 /// @tparam TSample Sample type.
@@ -31,6 +32,13 @@ public:
 
     static constexpr size_t channelsMax = 4;    // Maximum number of channels that can be set set.
 
+    /// @brief A consistent snapshot of the last reported change.
+    struct Reading
+    {
+        double value;   ///< Voltage [mV].
+        double change;  ///< Change [mV] from the previous reported value.
+    };
+
     /// @brief Configures ADC observer.
     /// @param hadc ADC handle pointer.
     /// @param threshold A threshold value change to trigger the change event.
@@ -63,8 +71,15 @@ public:
             static_cast<double>(maxValue) * static_cast<double>(supplyVoltage_mV);
     }
 
-    /// @brief Returns the last calculated conversion value in millivolts.
-    double lastValue() { return m_value; }
+    /// @brief Returns the last calculated conversion value in millivolts. Lock-free, safe to call from any thread.
+    double lastValue() const { return m_reading.read().value; }
+
+    /// @brief Returns the last reported value and change without tearing. Lock-free, safe to call from any thread.
+    Reading lastReading() const { return m_reading.read(); }
+
+    /// @brief Returns the reading sequence number that changes with each reported change.
+    /// @remarks Can be compared with a previously returned value to skip processing an unchanged reading.
+    uint32_t readingSequence() const { return m_reading.sequence(); }
 
     /// @brief Stops the conversion loop.
     void stop() { HAL_ADC_Stop_DMA(m_hadc); }
@@ -82,13 +97,14 @@ protected:
             break;
         }
         if (!instance) return;
-        double p = instance->m_value;
+        double p = instance->m_reading.read().value;
         double v = instance->value();
         long double d = v - p;
         if (std::fabs(d) >= instance->m_threshold)
         {
-            instance->m_value = v / instance->m_threshold * instance->m_threshold;
-            if (instance->m_valueChanged) instance->m_valueChanged(instance->m_value, d);
+            const Reading reading = { v / instance->m_threshold * instance->m_threshold, static_cast<double>(d) };
+            instance->m_reading.write(reading);
+            if (instance->m_valueChanged) instance->m_valueChanged(reading.value, d);
         }
     }
 
@@ -96,7 +112,7 @@ protected:
     static inline ADCBase* m_instances[channelsMax] = {};   // Configured instances.
 
     ADC_HandleTypeDef* m_hadc = nullptr;                    // ADC handle pointer.
-    double m_value = 0;                                     // Current reading value.
+    Seqlock<Reading> m_reading;                             // Current reading, written in the ADC interrupt.
     double m_threshold = 0;                                 // Current threshold value.
     Callback m_valueChanged = nullptr;                      // Value changed callback.
 
@@ -19,6 +19,12 @@ void HMI::start()
     while ((HMI_SysInit & HMI_ALL) != HMI_ALL) initSemaphore.wait();
     Log::msg("HMI: Initialization complete.");
 //    FS::Test::fileAPI(FS::SD(), "fs-test.dat");
+//    FS::Test::benchmark(FS::SD(), "fs-bench");
+//    FS::Test::copyAPI(FS::SD(), FS::USB(), "fs-copy.dat");
+//    FS::Test::kvAPI(FS::SD(), "fs-kv");
+//    FS::Test::timeSeriesAPI(FS::SD(), "fs-series");
+//    FS::Test::compressionAPI(FS::SD(), "fs-log.lz4");
+//    FS::Test::schedulerAPI(FS::SD());
 //    ADC_01.registerCallback(ADC1_readingChanged);
 //    ADC_01.start();
     ADC_02.registerCallback(ADC2_readingChanged);
@@ -37,18 +43,29 @@ void HMI::init(uint32_t flags)
 
 void HMI::ADC1_readingChanged(double value, double change)
 {
-    Log::msg("ADC1: Value: %.3f", value);
+    OS::EventBus<ADCReadingEvent<1>>::publish({ value, change });
 }
 
 void HMI::ADC2_readingChanged(double value, double change)
 {
-    Log::msg("ADC2: Value: %.3f", value);
+    OS::EventBus<ADCReadingEvent<2>>::publish({ value, change });
+}
+
+void HMI::ADC2_reading(const ADCReadingEvent<2>& event)
+{
+    Log::msg("ADC2: Value: %.3f", event.value);
+}
+
+void HMI::USBMediaChanged(const USBMediaEvent& event)
+{
+    if (event.isMounted) USBMediaMounted();
+    else USBMediaUnmounted();
 }
 
 void HMI::USBMediaMounted()
 {
     Log::msg("HMI: USB media available.");
-    FS::Test::fileAPI(FS::USB(), "fs-test.dat");
+    FS::Test::asyncAPI(FS::USB(), "fs-test.dat"); // The I/O runs in the `FS::AsyncIO` thread, the dispatcher is not blocked.
 }
 
 void HMI::USBMediaUnmounted()
@@ -75,12 +92,12 @@ void HMI_Init(uint32_t flags)
 
 void HMI_TriggerUSBMediaMounted()
 {
-    OS::AppThread::sync(HMI::USBMediaMounted);
+    OS::EventBus<USBMediaEvent>::publish({ true });
 }
 
 void HMI_TriggerUSBMediaUnmounted()
 {
-    OS::AppThread::sync(HMI::USBMediaUnmounted);
+    OS::EventBus<USBMediaEvent>::publish({ false });
 }
 
 }
@@ -12,6 +12,8 @@
 #include "hmi.h"
 #include "StaticClass.hpp"
 #include "OS/Semaphore.hpp"
+#include "OS/EventBus.hpp"
+#include "HMIEvents.hpp"
 #include "adc.h"
 #include "ADC.hpp"
 
@@ -28,8 +30,10 @@ public:
     /// @param flags Initialization flags.
     static void init(uint32_t flags);
 
+    /// @brief Publishes the ADC1 reading change. Called from the ADC interrupt.
     static void ADC1_readingChanged(double value, double change);
 
+    /// @brief Publishes the ADC2 reading change. Called from the ADC interrupt.
     static void ADC2_readingChanged(double value, double change);
 
     /// @brief Called when the USB media is mounted at "1:/".
@@ -40,8 +44,17 @@ public:
 
 private:
 
+    /// @brief Logs the latest ADC2 reading.
+    static void ADC2_reading(const ADCReadingEvent<2>& event);
+
+    /// @brief Calls `USBMediaMounted()` or `USBMediaUnmounted()`.
+    static void USBMediaChanged(const USBMediaEvent& event);
+
     inline static OS::Semaphore initSemaphore = {}; // Initialization semaphore.
 
+    inline static OS::Subscription<ADCReadingEvent<2>> ADC2_subscription = { ADC2_reading };   // Coalesced, latest value only.
+    inline static OS::Subscription<USBMediaEvent, 4> USBMedia_subscription = { USBMediaChanged };
+
     inline static ADCObserver<1024, uint16_t> ADC_01 = { &hadc1, 2.0 };
     inline static ADCObserver<1024, uint16_t> ADC_02 = { &hadc2, 2.0 };
 
@@ -0,0 +1,27 @@
+/**
+ * @file        HMIEvents.hpp
+ * @author      CodeDog
+ * @brief       HMI events published on the `OS::EventBus`.
+ * @remarks     Subscribe with a static `OS::Subscription<Event>` object, no changes in the producers required.
+ *
+ * @copyright   (c)2023 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief ADC reading change, published from the ADC conversion complete interrupt.
+/// @tparam TChannel ADC channel number, so that the coalescing subscriptions never mix the channels.
+template<uint8_t TChannel>
+struct ADCReadingEvent
+{
+    double value;   ///< Voltage [mV].
+    double change;  ///< Change [mV].
+};
+
+/// @brief USB media availability change.
+struct USBMediaEvent
+{
+    bool isMounted; ///< True if the media was mounted at "1:/", false if unmounted.
+};
@@ -0,0 +1,90 @@
+/**
+ * @file        CycleCounter.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       DWT CPU cycle counter access. Header only.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "target.h"
+#include "StaticClass.hpp"
+#if defined(USE_POSIX)
+#include <chrono>
+#else
+#include "hal_mcu.h"
+#endif
+
+/// @brief Provides the DWT CPU cycle counter access.
+/// @remarks The counter is 32-bit, so differences are valid for intervals shorter than 2^32 CPU cycles.
+class CycleCounter final
+{
+    STATIC(CycleCounter)
+
+public:
+
+#if defined(USE_POSIX)
+
+    /// @brief Does nothing, the host build counts the nanoseconds of the steady clock as the cycles.
+    static inline void init() { }
+
+    /// @returns The current steady clock time in nanoseconds, truncated to 32 bits.
+    static inline uint32_t now()
+    {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /// @param start A value returned by `now()`.
+    /// @returns The number of nanoseconds elapsed since `start`.
+    static inline uint32_t since(uint32_t start) { return now() - start; }
+
+    /// @returns The number of "cycles" per second.
+    static inline uint32_t frequency() { return 1000000000U; }
+
+#else
+
+    /// @brief Enables the DWT cycle counter if not already enabled. Can be called multiple times.
+    static inline void init()
+    {
+        if (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) return;
+#ifndef DCB
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#else
+        DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+#endif
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /// @returns The current CPU cycle count.
+    static inline uint32_t now() { return DWT->CYCCNT; }
+
+    /// @param start A value returned by `now()`.
+    /// @returns The number of CPU cycles elapsed since `start`.
+    static inline uint32_t since(uint32_t start) { return DWT->CYCCNT - start; }
+
+    /// @returns The number of CPU cycles per second.
+    static inline uint32_t frequency() { return SystemCoreClock; }
+
+#endif
+
+    /// @param microseconds Time in microseconds.
+    /// @returns The number of CPU cycles.
+    static inline uint32_t fromMicroseconds(uint32_t microseconds)
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(microseconds) * frequency() / 1000000U);
+    }
+
+    /// @param cycles The number of CPU cycles.
+    /// @returns Time in microseconds.
+    static inline uint32_t toMicroseconds(uint32_t cycles)
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(cycles) * 1000000U / frequency());
+    }
+
+};
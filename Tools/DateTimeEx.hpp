@@ -38,10 +38,18 @@ public:
 
     /// @brief Loads current real time clock into this structure.
     /// @returns 1: Success. 0: Failure.
+#if defined(USE_POSIX)
+    inline bool getRTC() { return SYS_GetDateTime(c_ptr()); }
+#else
     inline bool getRTC() { return RTC_GetDateTime(c_ptr()) == HAL_OK; }
+#endif
 
     /// @brief Sets the real time clock with value with this structure.
-    /// @returns 1: Success. 0: Failure.
+    /// @returns 1: Success. 0: Failure, always on the host build, the system clock is not set.
+#if defined(USE_POSIX)
+    inline bool setRTC() { return false; }
+#else
     inline bool setRTC() { return RTC_SetDateTime(c_ptr()) == HAL_OK; }
+#endif
 
 };
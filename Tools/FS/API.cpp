@@ -11,6 +11,7 @@
 #include "Adapter.hpp"
 #include "API.hpp"
 #include "DateTime.hpp"
+#include "StatCache.hpp"
 #include <utility>
 #include <cstdarg>
 
@@ -18,6 +19,22 @@ USE_ADAPTER
 
 static constexpr FS::AdapterTypes::Status ok = FS::AdapterTypes::OK;
 
+/// @brief Gets the metadata from the `StatCache`, or from the adapter, caching the result.
+/// @param context Path reference.
+/// @param stat Metadata structure reference.
+/// @returns True if the entry exists.
+static bool lookup(const FS::Path& context, FS::FileStat& stat)
+{
+    if (!context.isValid()) return false;
+    bool exists;
+    uint32_t generation;
+    if (FS::StatCache::lookup(context.fileSystem(), context.relativePath(), stat, exists, generation)) return exists;
+    auto status = adapter.stat(*context.fileSystem()->media(), context.relativePath(), stat);
+    if (status == ok) FS::StatCache::store(context.fileSystem(), context.relativePath(), &stat, generation);
+    else if (status == FS_NOT_FOUND) FS::StatCache::store(context.fileSystem(), context.relativePath(), nullptr, generation);
+    return status == ok;
+}
+
 const FS::FileSystem* FS::internal()
 {
     FileSystem* fs = nullptr;
@@ -26,18 +43,26 @@ const FS::FileSystem* FS::internal()
     return FileSystemTable::find(MediaType::SD);
 }
 
+bool FS::stat(const FileSystem *fs, const char *path, FileStat &stat)
+{
+    Path context(fs);
+    return lookup(context.append(path), stat);
+}
+
 bool FS::created(const FileSystem *fs, const char *path, DateTime &dateTime)
 {
-    Path context(fs, path);
-    if (!context.isValid()) return false;
-    return adapter.created(*context.fileSystem()->media(), context.relativePath(), dateTime) == ok;
+    FileStat entry;
+    if (!stat(fs, path, entry) || !entry.created.year) return false;
+    dateTime = entry.created;
+    return true;
 }
 
 bool FS::modified(const FileSystem *fs, const char *path, DateTime &dateTime)
 {
-    Path context(fs, path);
-    if (!context.isValid()) return false;
-    return adapter.modified(*context.fileSystem()->media(), context.relativePath(), dateTime) == ok;
+    FileStat entry;
+    if (!stat(fs, path, entry)) return false;
+    dateTime = entry.modified;
+    return true;
 }
 
 bool FS::fileCreate(const FileSystem *fs, const char *path, ...)
@@ -47,7 +72,9 @@ bool FS::fileCreate(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.fileCreate(*context.fileSystem()->media(), context.relativePath()) == ok;
+    auto status = adapter.fileCreate(*context.fileSystem()->media(), context.relativePath());
+    StatCache::invalidate(context.fileSystem(), context.relativePath());
+    return status == ok;
 }
 
 bool FS::fileExists(const FileSystem *fs, const char *path, ...)
@@ -56,8 +83,8 @@ bool FS::fileExists(const FileSystem *fs, const char *path, ...)
     va_start(args, path);
     Path context(args, fs, path);
     va_end(args);
-    if (!context.isValid()) return false;
-    return adapter.fileExists(*context.fileSystem()->media(), context.relativePath()) == ok;
+    FileStat entry;
+    return lookup(context, entry) && entry.isFile();
 }
 
 bool FS::fileRename(const FileSystem *fs, const char *oldName, const char *newName, ...)
@@ -70,7 +97,10 @@ bool FS::fileRename(const FileSystem *fs, const char *oldName, const char *newNa
     va_end(args2);
     va_end(args1);
     if (!n1.isValid() || !n2.isValid()) return false;
-    return adapter.fileRename(*n1.fileSystem()->media(), n1.relativePath(), n2.relativePath()) == ok;
+    auto status = adapter.fileRename(*n1.fileSystem()->media(), n1.relativePath(), n2.relativePath());
+    StatCache::invalidate(n1.fileSystem(), n1.relativePath());
+    StatCache::invalidate(n2.fileSystem(), n2.relativePath());
+    return status == ok;
 }
 
 bool FS::fileDelete(const FileSystem *fs, const char *path, ...)
@@ -80,7 +110,9 @@ bool FS::fileDelete(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.fileDelete(*context.fileSystem()->media(), context.relativePath()) == ok;
+    auto status = adapter.fileDelete(*context.fileSystem()->media(), context.relativePath());
+    StatCache::invalidate(context.fileSystem(), context.relativePath());
+    return status == ok;
 }
 
 bool FS::directoryCreate(const FileSystem *fs, const char *path, ...)
@@ -90,7 +122,9 @@ bool FS::directoryCreate(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.directoryCreate(*context.fileSystem()->media(), context.relativePath()) == ok;
+    auto status = adapter.directoryCreate(*context.fileSystem()->media(), context.relativePath());
+    StatCache::invalidate(context.fileSystem(), context.relativePath());
+    return status == ok;
 }
 
 bool FS::directoryExists(const FileSystem *fs, const char *path, ...)
@@ -99,8 +133,8 @@ bool FS::directoryExists(const FileSystem *fs, const char *path, ...)
     va_start(args, path);
     Path context(args, fs, path);
     va_end(args);
-    if (!context.isValid()) return false;
-    return adapter.directoryExists(*context.fileSystem()->media(), context.relativePath()) == ok;
+    FileStat entry;
+    return lookup(context, entry) && entry.isDirectory();
 }
 
 bool FS::directoryRename(const FileSystem *fs, const char *oldName, const char *newName, ...)
@@ -113,7 +147,9 @@ bool FS::directoryRename(const FileSystem *fs, const char *oldName, const char *
     va_end(args2);
     va_end(args1);
     if (!n1.isValid() || !n2.isValid()) return false;
-    return adapter.directoryRename(*n1.fileSystem()->media(), n1.relativePath(), n2.relativePath()) == ok;
+    auto status = adapter.directoryRename(*n1.fileSystem()->media(), n1.relativePath(), n2.relativePath());
+    StatCache::invalidate(n1.fileSystem()); // The paths of all entries inside are changed.
+    return status == ok;
 }
 
 bool FS::directoryDelete(const FileSystem *fs, const char *path, ...)
@@ -123,5 +159,13 @@ bool FS::directoryDelete(const FileSystem *fs, const char *path, ...)
     Path context(args, fs, path);
     va_end(args);
     if (!context.isValid()) return false;
-    return adapter.directoryDelete(*context.fileSystem()->media(), context.relativePath()) == ok;
+    auto status = adapter.directoryDelete(*context.fileSystem()->media(), context.relativePath());
+    StatCache::invalidate(context.fileSystem());
+    return status == ok;
+}
+
+bool FS::flush(const FileSystem *fs)
+{
+    if (!fs || !fs->isMounted()) return false;
+    return adapter.mediaFlush(*fs->media()) == ok;
 }
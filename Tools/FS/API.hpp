@@ -11,6 +11,7 @@
 #pragma once
 
 #include "DateTime.hpp"
+#include "Directory.hpp"
 #include "File.hpp"
 #include "Media.hpp"
 
@@ -26,12 +27,22 @@ inline const FileSystem* SD() { return FileSystemTable::find(MediaType::SD); }
 /// @returns The USB disk file system pointer if it was mounted. Null pointer otherwise.
 inline const FileSystem* USB() { return FileSystemTable::find(MediaType::USB); }
 
+/// @returns The RAM disk file system pointer if it was mounted. Null pointer otherwise.
+inline const FileSystem* RAM() { return FileSystemTable::find(MediaType::RAM); }
+
 /// @returns The internal file system pointer if it was mounter. Null pointer otherwise.
 const FileSystem* internal();
 
 /// @returns The external file system pointer if it was mounted. Null pointer otherwise.
 inline const FileSystem* external() { return FileSystemTable::find(MediaType::USB); }
 
+/// @brief Gets the file or directory attributes, size and timestamps in one lookup. The result is cached in `StatCache`.
+/// @param fs File system pointer.
+/// @param path File or directory path.
+/// @param stat Metadata structure reference.
+/// @returns True if the entry exists, false otherwise.
+bool stat(const FileSystem* fs, const char* path, FileStat& stat);
+
 /// @brief Gets the file or directory creation time.
 /// @param fs File system pointer.
 /// @param path File or directory path.
@@ -104,4 +115,10 @@ bool directoryRename(const FileSystem* fs, const char* oldName, const char* newN
 /// @returns True if completed successfully, false otherwise.
 bool directoryDelete(const FileSystem* fs, const char* path, ...);
 
+/// @brief Writes the sectors and FAT entries cached by the file system to the media, a commit point before a possible reset.
+/// @remarks The mounted media are also flushed every `WTK_FS_MEDIA_FLUSH` milliseconds.
+/// @param fs File system pointer.
+/// @returns True if completed successfully, false otherwise.
+bool flush(const FileSystem* fs);
+
 }
@@ -17,6 +17,8 @@ namespace FS
 AdapterFILEX adapter;
 #elif defined(USE_FATFS)
 AdapterFATFS adapter;
+#elif defined(USE_POSIX)
+AdapterPOSIX adapter;
 #else
 AdapterNull adapter;
 #endif
@@ -17,6 +17,9 @@
 #elif defined(USE_FATFS)
 #include "AdapterFATFS.hpp"
 #define USE_ADAPTER static FS::AdapterFATFS adapter;
+#elif defined(USE_POSIX)
+#include "AdapterPOSIX.hpp"
+#define USE_ADAPTER static FS::AdapterPOSIX adapter;
 #else
 #include "AdapterNull.hpp"
 #define USE_ADAPTER extern FS::AdapterNULL adapter;
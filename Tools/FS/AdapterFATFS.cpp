@@ -27,6 +27,19 @@ FS::AdapterTypes::Status FS::AdapterFATFS::find(Media &media, const char *path,
     return f_findfirst(&entry.dir, &entry.info, context.absolutePath(), "*");
 }
 
+FS::AdapterTypes::Status FS::AdapterFATFS::stat(Media &media, const char *path, FileStat &stat) const
+{
+    FILINFO info = {};
+    Status result = fstat(media, path, info);
+    if (result == FR_NO_FILE || result == FR_NO_PATH) return FS_NOT_FOUND;
+    if (result != OK) return result;
+    stat.size = info.fsize;
+    stat.attributes = info.fattrib;
+    stat.created = {}; // Not provided by FATFS.
+    toDateTime(info.fdate, info.ftime, stat.modified);
+    return OK;
+}
+
 FS::AdapterTypes::Status FS::AdapterFATFS::created(Media &media, const char *path, DateTime &dateTime) const
 {
     return FR_NOT_ENABLED;
@@ -74,6 +87,12 @@ FS::AdapterTypes::Status FS::AdapterFATFS::fileSeek(FileControlBlock &file, File
     return f_lseek(&file, offset);
 }
 
+FS::AdapterTypes::Status FS::AdapterFATFS::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    offset = f_tell(&file);
+    return OK;
+}
+
 FS::AdapterTypes::Status FS::AdapterFATFS::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
 {
     return f_read(&file, buffer, size, &bytesRead);
@@ -85,6 +104,41 @@ FS::AdapterTypes::Status FS::AdapterFATFS::fileWrite(FileControlBlock &file, con
     return f_write(&file, buffer, size, &bytesWritten);
 }
 
+FS::AdapterTypes::Status FS::AdapterFATFS::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    size = f_size(&file);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::fileAllocate(FileControlBlock &file, FileOffset size, FileOffset &allocated) const
+{
+    allocated = 0;
+#if _USE_EXPAND || FF_USE_EXPAND
+    if (f_size(&file)) return FR_DENIED; // `f_expand()` allocates the space for empty files only.
+    Status result = f_expand(&file, size, 1);
+    if (result == OK) allocated = size;
+    return result;
+#else
+    (void)file;
+    (void)size;
+    return FS_NEGATIVE;
+#endif
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::fileTruncate(FileControlBlock &file, FileOffset size) const
+{
+    FileOffset offset = f_tell(&file);
+    Status result = f_lseek(&file, size);
+    if (result == OK) result = f_truncate(&file);
+    if (result == OK && offset < size) result = f_lseek(&file, offset);
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::fileFlush(FileControlBlock &file) const
+{
+    return f_sync(&file);
+}
+
 FS::AdapterTypes::Status FS::AdapterFATFS::fileClose(FileControlBlock &file) const
 {
     return f_close(&file);
@@ -156,6 +210,43 @@ FS::AdapterTypes::Status FS::AdapterFATFS::directoryDelete(Media &media, const c
     return f_unlink(context.absolutePath());
 }
 
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryOpen(Media &media, DirectoryHandle &directory, const char *path) const
+{
+    auto fs = FileSystemTable::find(&media);
+    if (!fs) return FR_INVALID_DRIVE;
+    Path context(fs, path ? path : "");
+    return f_opendir(&directory, context.absolutePath());
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryRead(DirectoryHandle &directory, DirectoryItem *items, size_t capacity, size_t &count) const
+{
+    count = 0;
+    FILINFO info;
+    while (count < capacity)
+    {
+        Status result = f_readdir(&directory, &info);
+        if (result != OK) return result;
+        if (!info.fname[0]) break; // The end of the directory.
+        DirectoryItem& item = items[count++];
+        std::strncpy(item.name, info.fname, sizeof(item.name) - 1);
+        item.name[sizeof(item.name) - 1] = 0;
+        item.size = info.fsize;
+        item.attributes = info.fattrib;
+        toDateTime(info.fdate, info.ftime, item.modified);
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::directoryClose(DirectoryHandle &directory) const
+{
+    return f_closedir(&directory);
+}
+
+FS::AdapterTypes::Status FS::AdapterFATFS::mediaFlush(Media &media) const
+{
+    return OK; // FatFs keeps the dirty sectors in the open files, `f_sync()` writes them.
+}
+
 FS::AdapterTypes::Status FS::AdapterFATFS::fstat(Media &media, const char *path, FILINFO &stat) const
 {
     auto fs = FileSystemTable::find(&media);
@@ -29,6 +29,19 @@ FS::AdapterTypes::Status FS::AdapterFILEX::find(Media &media, const char *path,
     return result;
 }
 
+FS::AdapterTypes::Status FS::AdapterFILEX::stat(Media &media, const char *path, FileStat &stat) const
+{
+    DirectoryEntry entry = {};
+    Status result = find(media, path, entry);
+    if (result == FX_NOT_FOUND) return FS_NOT_FOUND;
+    if (result != OK) return result;
+    stat.size = entry.fx_dir_entry_file_size;
+    stat.attributes = static_cast<uint8_t>(entry.fx_dir_entry_attributes);
+    toDateTime(entry.fx_dir_entry_created_date, entry.fx_dir_entry_created_time, stat.created);
+    toDateTime(entry.fx_dir_entry_date, entry.fx_dir_entry_time, stat.modified);
+    return OK;
+}
+
 FS::AdapterTypes::Status FS::AdapterFILEX::created(Media &media, const char *path, DateTime &dateTime) const
 {
     DirectoryEntry entry = {};
@@ -91,9 +104,18 @@ FS::AdapterTypes::Status FS::AdapterFILEX::fileSeek(FileControlBlock &file, File
     return fx_file_seek(&file, offset);
 }
 
+FS::AdapterTypes::Status FS::AdapterFILEX::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    offset = static_cast<FileOffset>(file.fx_file_current_file_offset);
+    return OK;
+}
+
 FS::AdapterTypes::Status FS::AdapterFILEX::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
 {
-    return fx_file_read(&file, buffer, size, (ULONG*)&bytesRead);
+    ULONG count = 0;
+    Status result = fx_file_read(&file, buffer, size, &count);
+    bytesRead = count;
+    return result == FX_END_OF_FILE && !count ? OK : result; // The end of the file is 0 bytes read, like in the other adapters.
 }
 
 FS::AdapterTypes::Status FS::AdapterFILEX::fileWrite(FileControlBlock &file, const void *buffer, size_t size) const
@@ -101,6 +123,34 @@ FS::AdapterTypes::Status FS::AdapterFILEX::fileWrite(FileControlBlock &file, con
     return fx_file_write(&file, const_cast<void*>(buffer), size);
 }
 
+FS::AdapterTypes::Status FS::AdapterFILEX::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    size = static_cast<FileOffset>(file.fx_file_current_file_size);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::fileAllocate(FileControlBlock &file, FileOffset size, FileOffset &allocated) const
+{
+    allocated = 0;
+    Status result = fx_file_allocate(&file, size);
+    if (result == OK) allocated = size;
+    if (result != FX_NO_MORE_SPACE) return result;
+    ULONG actual = 0;
+    result = fx_file_best_effort_allocate(&file, size, &actual); // The largest consecutive block available.
+    if (result == OK) allocated = static_cast<FileOffset>(actual);
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::fileTruncate(FileControlBlock &file, FileOffset size) const
+{
+    return fx_file_truncate_release(&file, size);
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::fileFlush(FileControlBlock &file) const
+{
+    return fx_media_flush(file.fx_file_media_ptr); // Also writes the directory entries of the open files.
+}
+
 FS::AdapterTypes::Status FS::AdapterFILEX::fileClose(FileControlBlock &file) const
 {
     return fx_file_close(&file);
@@ -139,6 +189,59 @@ FS::AdapterTypes::Status FS::AdapterFILEX::directoryDelete(Media &media, const c
     return fx_directory_delete(&media, (CHAR*)path);
 }
 
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryOpen(Media &media, DirectoryHandle &directory, const char *path) const
+{
+    directory.media = nullptr;
+    directory.isStarted = 0;
+    Status result = fx_directory_local_path_set(&media, &directory.path, path && *path ? (CHAR*)path : nullptr);
+    if (result != OK) return result;
+    fx_directory_local_path_clear(&media); // The local path is made current only for the time of each batch.
+    directory.media = &media;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryRead(DirectoryHandle &directory, DirectoryItem *items, size_t capacity, size_t &count) const
+{
+    count = 0;
+    if (!directory.media) return FX_MEDIA_NOT_OPEN;
+    Status result = fx_directory_local_path_restore(directory.media, &directory.path);
+    if (result != OK) return result;
+    UINT attributes, year, month, day, hour, minute, second;
+    ULONG size;
+    while (count < capacity)
+    {
+        DirectoryItem& item = items[count];
+        result = directory.isStarted
+            ? fx_directory_next_full_entry_find(directory.media, item.name, &attributes, &size, &year, &month, &day, &hour, &minute, &second)
+            : fx_directory_first_full_entry_find(directory.media, item.name, &attributes, &size, &year, &month, &day, &hour, &minute, &second);
+        if (result != OK) break;
+        directory.isStarted = 1;
+        item.size = size;
+        item.attributes = static_cast<uint8_t>(attributes);
+        item.modified = {};
+        item.modified.year = static_cast<int16_t>(year);
+        item.modified.month = static_cast<uint8_t>(month);
+        item.modified.day = static_cast<uint8_t>(day);
+        item.modified.hour = static_cast<uint8_t>(hour);
+        item.modified.minute = static_cast<uint8_t>(minute);
+        item.modified.second = static_cast<uint8_t>(second);
+        ++count;
+    }
+    fx_directory_local_path_clear(directory.media);
+    return result == FX_NO_MORE_ENTRIES ? OK : result;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::directoryClose(DirectoryHandle &directory) const
+{
+    directory.media = nullptr;
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterFILEX::mediaFlush(Media &media) const
+{
+    return fx_media_flush(&media);
+}
+
 FS::AdapterTypes::Status FS::AdapterFILEX::initializeEntry(Media &media, DirectoryEntry &entry)
 {
     Status result = OK;
@@ -13,7 +13,7 @@
 
 #include "target.h"
 
-#if !defined(USE_FILEX) && !defined(USE_FATFS)
+#if !defined(USE_FILEX) && !defined(USE_FATFS) && !defined(USE_POSIX)
 
 #include "AdapterNull.hpp"
 #include "BitFlags.hpp"
@@ -23,6 +23,11 @@ FS::AdapterTypes::Status FS::AdapterNull::find(Media &media, const char *path, D
     return FS_NEGATIVE;
 }
 
+FS::AdapterTypes::Status FS::AdapterNull::stat(Media &media, const char *path, FileStat &stat) const
+{
+    return FS_NEGATIVE;
+}
+
 FS::AdapterTypes::Status FS::AdapterNull::created(Media &media, const char *path, DateTime &dateTime) const
 {
     return FS_NEGATIVE;
@@ -55,6 +60,12 @@ FS::AdapterTypes::Status FS::AdapterNull::fileSeek(FileControlBlock &file, FileO
     return file.isUsed ? OK : FS_NEGATIVE;
 }
 
+FS::AdapterTypes::Status FS::AdapterNull::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    offset = 0;
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
 FS::AdapterTypes::Status FS::AdapterNull::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
 {
     return FS_NEGATIVE;
@@ -66,6 +77,28 @@ FS::AdapterTypes::Status FS::AdapterNull::fileWrite(FileControlBlock &file, cons
     return OK;
 }
 
+FS::AdapterTypes::Status FS::AdapterNull::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    size = 0;
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::fileAllocate(FileControlBlock &file, FileOffset size, FileOffset &allocated) const
+{
+    allocated = 0;
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::fileTruncate(FileControlBlock &file, FileOffset size) const
+{
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::fileFlush(FileControlBlock &file) const
+{
+    return file.isUsed ? OK : FS_NEGATIVE;
+}
+
 FS::AdapterTypes::Status FS::AdapterNull::fileClose(FileControlBlock &file) const
 {
     if (!file.isUsed) return FS_NEGATIVE;
@@ -103,4 +136,25 @@ FS::AdapterTypes::Status FS::AdapterNull::directoryDelete(Media &media, const ch
     return FS_NEGATIVE;
 }
 
+FS::AdapterTypes::Status FS::AdapterNull::directoryOpen(Media &media, DirectoryHandle &directory, const char *path) const
+{
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::directoryRead(DirectoryHandle &directory, DirectoryItem *items, size_t capacity, size_t &count) const
+{
+    count = 0;
+    return FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::directoryClose(DirectoryHandle &directory) const
+{
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterNull::mediaFlush(Media &media) const
+{
+    return OK;
+}
+
 #endif
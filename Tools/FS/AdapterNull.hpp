@@ -15,7 +15,7 @@
 
 #include "target.h"
 
-#if !defined(USE_FILEX) && !defined(USE_FATFS)
+#if !defined(USE_FILEX) && !defined(USE_FATFS) && !defined(USE_POSIX)
 
 #include "IAdapterMethods.hpp"
 
@@ -37,6 +37,13 @@ public:
     /// @returns Status.
     Status find(Media& media, const char* path, DirectoryEntry& entry) const override;
 
+    /// @brief Gets the file or directory attributes, size and timestamps in one lookup.
+    /// @param media Media structure reference.
+    /// @param path File or directory path.
+    /// @param stat Metadata structure reference.
+    /// @returns Status, `FS_NOT_FOUND` if the entry doesn't exist.
+    Status stat(Media& media, const char* path, FileStat& stat) const override;
+
     /// @brief Gets the file or directory creation time.
     /// @param media Media structure reference.
     /// @param path File or directory path.
@@ -77,6 +84,12 @@ public:
     /// @returns Status.
     Status fileSeek(FileControlBlock& file, FileOffset offset) const override;
 
+    /// @brief Gets the file pointer offset.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    Status fileTell(FileControlBlock& file, FileOffset& offset) const override;
+
     /// @brief Reads data from a file.
     /// @param file File handle reference.
     /// @param buffer Buffer pointer.
@@ -93,6 +106,30 @@ public:
     /// @returns Status.
     Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const override;
 
+    /// @brief Gets the file length.
+    /// @param file File handle reference.
+    /// @param size File length variable reference.
+    /// @returns Status.
+    Status fileSize(FileControlBlock& file, FileOffset& size) const override;
+
+    /// @brief Allocates contiguous clusters at the end of a file.
+    /// @param file File handle reference.
+    /// @param size Number of bytes to allocate.
+    /// @param allocated Number of bytes actually allocated variable reference.
+    /// @returns Status.
+    Status fileAllocate(FileControlBlock& file, FileOffset size, FileOffset& allocated) const override;
+
+    /// @brief Truncates a file to the specified length, releasing the clusters beyond it.
+    /// @param file File handle reference.
+    /// @param size New file length.
+    /// @returns Status.
+    Status fileTruncate(FileControlBlock& file, FileOffset size) const override;
+
+    /// @brief Writes the cached data, the directory entry and the FAT entries of an open file to the physical media.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileFlush(FileControlBlock& file) const override;
+
     /// @brief Closes a file.
     /// @param file File handle reference.
     /// @returns Status.
@@ -136,6 +173,31 @@ public:
     /// @returns Status.
     Status directoryDelete(Media& media, const char* path) const override;
 
+    /// @brief Opens a directory for the enumeration.
+    /// @param media Media structure reference.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path relative to the file system root, empty for the root directory.
+    /// @returns Status.
+    Status directoryOpen(Media& media, DirectoryHandle& directory, const char* path) const override;
+
+    /// @brief Reads the next batch of directory entries.
+    /// @param directory Open directory handle reference.
+    /// @param items Target items array.
+    /// @param capacity The number of items the array can hold.
+    /// @param count The number of items read variable reference. Less than `capacity` when there are no more entries.
+    /// @returns Status.
+    Status directoryRead(DirectoryHandle& directory, DirectoryItem* items, size_t capacity, size_t& count) const override;
+
+    /// @brief Closes a directory.
+    /// @param directory Open directory handle reference.
+    /// @returns Status.
+    Status directoryClose(DirectoryHandle& directory) const override;
+
+    /// @brief Writes the media sectors and FAT entries cached by the file system to the physical media.
+    /// @param media Media structure reference.
+    /// @returns Status.
+    Status mediaFlush(Media& media) const override;
+
 };
 
 }
@@ -0,0 +1,287 @@
+/**
+ * @file        AdapterPOSIX.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A file system adapter for POSIX files. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "target.h"
+
+#ifdef USE_POSIX
+
+#include "AdapterPOSIX.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @brief Host path buffer length.
+static constexpr size_t hostPathLength = sizeof(FS_PosixDirectory::path);
+
+/// @brief Builds the host path of the file or directory.
+/// @param media Media structure reference.
+/// @param path Path relative to the file system root.
+/// @param hostPath Host path buffer, `hostPathLength` bytes.
+/// @returns Host path buffer pointer, `nullptr` if the path is too long.
+static const char* toHostPath(const FS::AdapterTypes::Media& media, const char* path, char* hostPath)
+{
+    if (!media.directory || !path) return nullptr;
+    while (*path == '/' || *path == '\\') ++path;
+    const int length = std::snprintf(hostPath, hostPathLength, "%s/%s", media.directory, path);
+    if (length < 0 || static_cast<size_t>(length) >= hostPathLength) return nullptr;
+    for (char* c = hostPath; *c; ++c) if (*c == '\\') *c = '/';
+    return hostPath;
+}
+
+/// @returns The last POSIX error as the adapter status, never `OK`.
+static inline FS::AdapterTypes::Status lastError() { return errno ? errno : FS_NEGATIVE; }
+
+/// @brief Converts the POSIX file status to the attribute flags.
+/// @param info File status structure reference.
+/// @returns `DirectoryItem::Attributes` flags.
+static uint8_t toAttributes(const struct stat& info)
+{
+    uint8_t attributes = S_ISDIR(info.st_mode) ? FS::DirectoryItem::directory : FS::DirectoryItem::archive;
+    if (!(info.st_mode & S_IWUSR)) attributes |= FS::DirectoryItem::readOnly;
+    return attributes;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::find(Media &media, const char *path, DirectoryEntry &entry) const
+{
+    return FS_NEGATIVE; // POSIX has no directory entry structure, use `stat()`.
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::stat(Media &media, const char *path, FileStat &stat) const
+{
+    char hostPath[hostPathLength];
+    struct stat info;
+    if (!toHostPath(media, path, hostPath)) return ENAMETOOLONG;
+    if (::stat(hostPath, &info)) return errno == ENOENT || errno == ENOTDIR ? FS_NOT_FOUND : lastError();
+    stat.size = static_cast<uint64_t>(info.st_size);
+    stat.created = {}; // POSIX doesn't store the creation time.
+    stat.modified = DateTime(info.st_mtime);
+    stat.attributes = toAttributes(info);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::created(Media &media, const char *path, DateTime &dateTime) const
+{
+    return FS_NEGATIVE; // POSIX doesn't store the creation time.
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::modified(Media &media, const char *path, DateTime &dateTime) const
+{
+    FileStat entry;
+    Status result = stat(media, path, entry);
+    if (result == OK) dateTime = entry.modified;
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileCreate(Media &media, const char *path) const
+{
+    char hostPath[hostPathLength];
+    if (!toHostPath(media, path, hostPath)) return ENAMETOOLONG;
+    int fd = ::open(hostPath, O_WRONLY | O_CREAT | O_EXCL, 0666); // Fails if exists, like the other backends.
+    if (fd < 0) return lastError();
+    ::close(fd);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileExists(Media &media, const char *path) const
+{
+    FileStat entry;
+    Status result = stat(media, path, entry);
+    if (result != OK) return result;
+    return entry.isFile() ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileOpen(Media &media, FileControlBlock &file, const char *path, FileMode mode) const
+{
+    char hostPath[hostPathLength];
+    if (!toHostPath(media, path, hostPath)) return ENAMETOOLONG;
+    int flags = (mode & FileMode::write) ? ((mode & FileMode::read) ? O_RDWR : O_WRONLY) : O_RDONLY;
+    if (mode & FileMode::createNew) flags |= O_CREAT | O_EXCL;
+    else if (mode & FileMode::createAlways) flags |= O_CREAT | O_TRUNC;
+    else if (mode & FileMode::openAlways) flags |= O_CREAT;
+    file.fd = ::open(hostPath, flags, 0666);
+    if (file.fd < 0) return lastError();
+    if ((mode & FileMode::openAppend) == FileMode::openAppend && ::lseek(file.fd, 0, SEEK_END) < 0)
+    {
+        Status result = lastError();
+        ::close(file.fd);
+        return result;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileSeek(FileControlBlock &file, FileOffset offset) const
+{
+    return ::lseek(file.fd, static_cast<off_t>(offset), SEEK_SET) < 0 ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileTell(FileControlBlock &file, FileOffset &offset) const
+{
+    off_t result = ::lseek(file.fd, 0, SEEK_CUR);
+    if (result < 0) return lastError();
+    offset = static_cast<FileOffset>(result);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileRead(FileControlBlock &file, void *buffer, size_t size, size_t &bytesRead) const
+{
+    bytesRead = 0;
+    while (bytesRead < size)
+    {
+        ssize_t result = ::read(file.fd, static_cast<uint8_t*>(buffer) + bytesRead, size - bytesRead);
+        if (result < 0 && errno == EINTR) continue;
+        if (result < 0) return lastError();
+        if (!result) break; // The end of the file.
+        bytesRead += static_cast<size_t>(result);
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileWrite(FileControlBlock &file, const void *buffer, size_t size) const
+{
+    size_t written = 0;
+    while (written < size)
+    {
+        ssize_t result = ::write(file.fd, static_cast<const uint8_t*>(buffer) + written, size - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) return lastError();
+        written += static_cast<size_t>(result);
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileSize(FileControlBlock &file, FileOffset &size) const
+{
+    struct stat info;
+    if (::fstat(file.fd, &info)) return lastError();
+    size = static_cast<FileOffset>(info.st_size);
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileAllocate(FileControlBlock &file, FileOffset size, FileOffset &allocated) const
+{
+    allocated = 0;
+    FileOffset end;
+    Status result = fileSize(file, end);
+    if (result != OK) return result;
+    result = ::posix_fallocate(file.fd, static_cast<off_t>(end), static_cast<off_t>(size)); // Returns the error number.
+    if (result == OK) allocated = size;
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileTruncate(FileControlBlock &file, FileOffset size) const
+{
+    return ::ftruncate(file.fd, static_cast<off_t>(size)) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileFlush(FileControlBlock &file) const
+{
+    return ::fsync(file.fd) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileClose(FileControlBlock &file) const
+{
+    return ::close(file.fd) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileRename(Media &media, const char *oldName, const char *newName) const
+{
+    char oldPath[hostPathLength];
+    char newPath[hostPathLength];
+    if (!toHostPath(media, oldName, oldPath) || !toHostPath(media, newName, newPath)) return ENAMETOOLONG;
+    return ::rename(oldPath, newPath) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::fileDelete(Media &media, const char *path) const
+{
+    char hostPath[hostPathLength];
+    if (!toHostPath(media, path, hostPath)) return ENAMETOOLONG;
+    return ::unlink(hostPath) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryCreate(Media &media, const char *path) const
+{
+    char hostPath[hostPathLength];
+    if (!toHostPath(media, path, hostPath)) return ENAMETOOLONG;
+    return ::mkdir(hostPath, 0777) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryExists(Media &media, const char *path) const
+{
+    FileStat entry;
+    Status result = stat(media, path, entry);
+    if (result != OK) return result;
+    return entry.isDirectory() ? OK : FS_NEGATIVE;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryRename(Media &media, const char *oldName, const char *newName) const
+{
+    return fileRename(media, oldName, newName);
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryDelete(Media &media, const char *path) const
+{
+    char hostPath[hostPathLength];
+    if (!toHostPath(media, path, hostPath)) return ENAMETOOLONG;
+    return ::rmdir(hostPath) ? lastError() : OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryOpen(Media &media, DirectoryHandle &directory, const char *path) const
+{
+    if (!toHostPath(media, path, directory.path)) return ENAMETOOLONG;
+    directory.dir = ::opendir(directory.path);
+    return directory.dir ? OK : lastError();
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryRead(DirectoryHandle &directory, DirectoryItem *items, size_t capacity, size_t &count) const
+{
+    count = 0;
+    if (!directory.dir) return FS_NEGATIVE;
+    char entryPath[hostPathLength];
+    while (count < capacity)
+    {
+        errno = 0;
+        const dirent* entry = ::readdir(directory.dir);
+        if (!entry) return errno ? lastError() : OK; // `NULL` without an error is the end of the directory.
+        DirectoryItem& item = items[count];
+        std::strncpy(item.name, entry->d_name, sizeof(item.name) - 1);
+        item.name[sizeof(item.name) - 1] = 0;
+        struct stat info;
+        const int length = std::snprintf(entryPath, sizeof(entryPath), "%s/%s", directory.path, entry->d_name);
+        if (length < 0 || static_cast<size_t>(length) >= sizeof(entryPath) || ::stat(entryPath, &info)) continue;
+        item.size = static_cast<uint64_t>(info.st_size);
+        item.modified = DateTime(info.st_mtime);
+        item.attributes = toAttributes(info);
+        ++count;
+    }
+    return OK;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::directoryClose(DirectoryHandle &directory) const
+{
+    if (!directory.dir) return FS_NEGATIVE;
+    Status result = ::closedir(directory.dir) ? lastError() : OK;
+    directory.dir = nullptr;
+    return result;
+}
+
+FS::AdapterTypes::Status FS::AdapterPOSIX::mediaFlush(Media &media) const
+{
+    if (!media.directory) return FS_NEGATIVE;
+    int fd = ::open(media.directory, O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return lastError();
+    Status result = ::fsync(fd) ? lastError() : OK; // Commits the directory entries, the file data is synced per file.
+    ::close(fd);
+    return result;
+}
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file        AdapterPOSIX.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A file system adapter for POSIX files. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @remarks     Maps the media to a host directory, so the file system API can be run and measured on a host.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+
+#ifdef USE_POSIX
+
+#include "IAdapterMethods.hpp"
+
+namespace FS
+{
+
+/// @brief File system adapter for the POSIX file API. The media is a host directory used as the file system root.
+class AdapterPOSIX final : public IAdapterMethods
+{
+
+public:
+
+    /// @brief Finds the directory entry that matches the path.
+    /// @param media Media structure reference.
+    /// @param path File or directory path.
+    /// @param entry Directory entry reference.
+    /// @returns Status.
+    Status find(Media& media, const char* path, DirectoryEntry& entry) const override;
+
+    /// @brief Gets the file or directory attributes, size and timestamps in one lookup.
+    /// @param media Media structure reference.
+    /// @param path File or directory path.
+    /// @param stat Metadata structure reference.
+    /// @returns Status, `FS_NOT_FOUND` if the entry doesn't exist.
+    Status stat(Media& media, const char* path, FileStat& stat) const override;
+
+    /// @brief Gets the file or directory creation time.
+    /// @param media Media structure reference.
+    /// @param path File or directory path.
+    /// @param dateTime `DateTime` structure reference.
+    /// @returns Status.
+    Status created(Media& media, const char* path, DateTime& dateTime) const override;
+
+    /// @brief Gets the file or directory last modification time.
+    /// @param media Media structure reference.
+    /// @param path File or directory path.
+    /// @param dateTime `DateTime` structure reference.
+    /// @returns Status.
+    Status modified(Media& media, const char* path, DateTime& dateTime) const override;
+
+    /// @brief Creates a file.
+    /// @param media Media structure reference.
+    /// @param path File path.
+    /// @returns Status.
+    Status fileCreate(Media& media, const char* path) const override;
+
+    /// @brief Tests if a file exist on the media.
+    /// @param media Media structure reference.
+    /// @param path File path.
+    /// @returns True if the file exists, false otherwise.
+    Status fileExists(Media& media, const char* path) const override;
+
+    /// @brief Opens a file.
+    /// @param media Media structure reference.
+    /// @param file File handle reference.
+    /// @param path A path to the file relative to the file system root.
+    /// @param mode File opening mode. Default opens existing file for reading.
+    /// @returns Status.
+    Status fileOpen(Media& media, FileControlBlock& file, const char* path, FileMode mode = FileMode::read) const override;
+
+    /// @brief Moves the file pointer to the specified offset.
+    /// @param file File handle reference.
+    /// @param offset Position within the file.
+    /// @returns Status.
+    Status fileSeek(FileControlBlock& file, FileOffset offset) const override;
+
+    /// @brief Gets the file pointer offset.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    Status fileTell(FileControlBlock& file, FileOffset& offset) const override;
+
+    /// @brief Reads data from a file.
+    /// @param file File handle reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @param bytesRead Number of bytes read variable reference.
+    /// @returns Status.
+    Status fileRead(FileControlBlock& file, void* buffer, size_t size, size_t& bytesRead) const override;
+
+    /// @brief Writes data to a file.
+    /// @param file File handle reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size.
+    /// @param bytesWritten Number of bytes written variable reference.
+    /// @returns Status.
+    Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const override;
+
+    /// @brief Gets the file length.
+    /// @param file File handle reference.
+    /// @param size File length variable reference.
+    /// @returns Status.
+    Status fileSize(FileControlBlock& file, FileOffset& size) const override;
+
+    /// @brief Allocates the space at the end of a file with `posix_fallocate()`, the file length is set to the allocated end.
+    /// @param file File handle reference.
+    /// @param size Number of bytes to allocate.
+    /// @param allocated Number of bytes actually allocated variable reference.
+    /// @returns Status.
+    Status fileAllocate(FileControlBlock& file, FileOffset size, FileOffset& allocated) const override;
+
+    /// @brief Truncates a file to the specified length, releasing the clusters beyond it.
+    /// @param file File handle reference.
+    /// @param size New file length.
+    /// @returns Status.
+    Status fileTruncate(FileControlBlock& file, FileOffset size) const override;
+
+    /// @brief Writes the cached data, the directory entry and the FAT entries of an open file to the physical media.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileFlush(FileControlBlock& file) const override;
+
+    /// @brief Closes a file.
+    /// @param file File handle reference.
+    /// @returns Status.
+    Status fileClose(FileControlBlock& file) const override;
+
+    /// @brief Renames a file.
+    /// @param media Media structure reference.
+    /// @param oldName Old file name.
+    /// @param newName New file name.
+    /// @returns Status.
+    Status fileRename(Media& media, const char* oldName, const char* newName) const override;
+
+    /// @brief Deletes a file.
+    /// @param media Media structure reference.
+    /// @param path File name.
+    /// @returns Status.
+    Status fileDelete(Media& media, const char* path) const override;
+
+    /// @brief Creates a directory on the media.
+    /// @param media Media structure reference.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryCreate(Media& media, const char* path) const override;
+
+    /// @brief Tests if a directory exists on the media.
+    /// @param media Media structure reference.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryExists(Media& media, const char* path) const override;
+
+    /// @brief Renames a directory on the media.
+    /// @param media Media structure reference.
+    /// @param oldName Old directory name.
+    /// @param newName New directory name.
+    /// @returns Status.
+    Status directoryRename(Media& media, const char* oldName, const char* newName) const override;
+
+    /// @brief Deletes a directory from the media.
+    /// @param media Media structure reference.
+    /// @param path Directory name.
+    /// @returns Status.
+    Status directoryDelete(Media& media, const char* path) const override;
+
+    /// @brief Opens a directory for the enumeration.
+    /// @param media Media structure reference.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path relative to the file system root, empty for the root directory.
+    /// @returns Status.
+    Status directoryOpen(Media& media, DirectoryHandle& directory, const char* path) const override;
+
+    /// @brief Reads the next batch of directory entries.
+    /// @param directory Open directory handle reference.
+    /// @param items Target items array.
+    /// @param capacity The number of items the array can hold.
+    /// @param count The number of items read variable reference. Less than `capacity` when there are no more entries.
+    /// @returns Status.
+    Status directoryRead(DirectoryHandle& directory, DirectoryItem* items, size_t capacity, size_t& count) const override;
+
+    /// @brief Closes a directory.
+    /// @param directory Open directory handle reference.
+    /// @returns Status.
+    Status directoryClose(DirectoryHandle& directory) const override;
+
+    /// @brief Writes the media sectors and FAT entries cached by the file system to the physical media.
+    /// @param media Media structure reference.
+    /// @returns Status.
+    Status mediaFlush(Media& media) const override;
+
+};
+
+}
+
+#endif
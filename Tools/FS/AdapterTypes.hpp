@@ -12,6 +12,7 @@
 
 #include "BitFlags.hpp"
 #include "fs_bindings.h"
+#include "DateTime.hpp"
 #include <cstdint>
 #include <cstddef>
 #include <optional>
@@ -47,6 +48,7 @@ public:
     using Media = FS_Media;                         // Media structure type.
     using DirectoryEntry = FS_DirectoryEntry;       // Directory entry structure type.
     using FileControlBlock = FS_FileControlBlock;   // File handle structure type.
+    using DirectoryHandle = FS_DirectoryHandle;     // Open directory handle structure type.
     using FileOffset = FS_FileOffset;               // File offset number type.
     using Status = FS_Status;                       // I/O operation status type.
 
@@ -72,4 +74,44 @@ public:
 
 };
 
+/// @brief Directory enumeration entry, with the metadata fetched in the same pass as the name.
+struct DirectoryItem final
+{
+
+    /// @brief Entry attribute flags, the same as FAT attributes.
+    enum Attributes : uint8_t
+    {
+        readOnly    = 0x01, // Read only entry.
+        hidden      = 0x02, // Hidden entry.
+        system      = 0x04, // System entry.
+        volume      = 0x08, // Volume label.
+        directory   = 0x10, // Directory.
+        archive     = 0x20  // Archive flag, set when the file was modified.
+    };
+
+    char name[AdapterTypes::lfnMaxLength];  ///< Entry name.
+    uint64_t size;                          ///< File size in bytes.
+    DateTime modified;                      ///< Last modification time.
+    uint8_t attributes;                     ///< Attribute flags.
+
+    /// @returns True if the entry is a directory.
+    inline bool isDirectory() const { return attributes & directory; }
+
+};
+
+/// @brief File or directory metadata returned by `FS::stat()`.
+struct FileStat final
+{
+    uint64_t size;          ///< File size in bytes.
+    DateTime created;       ///< Creation time, all zero if the file system doesn't provide it.
+    DateTime modified;      ///< Last modification time.
+    uint8_t attributes;     ///< `DirectoryItem::Attributes` flags.
+
+    /// @returns True if the entry is a directory.
+    inline bool isDirectory() const { return attributes & DirectoryItem::directory; }
+
+    /// @returns True if the entry is a file.
+    inline bool isFile() const { return !(attributes & (DirectoryItem::directory | DirectoryItem::volume)); }
+};
+
 }
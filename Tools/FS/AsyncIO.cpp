@@ -0,0 +1,220 @@
+/**
+ * @file        AsyncIO.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Asynchronous file I/O service. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "AsyncIO.hpp"
+#include "OS/AppThread.hpp"
+#include <cstring>
+#include <new>
+
+AsyncResultT<size_t>* FS::AsyncIO::open(AsyncFile& file, const FileSystem* fs, const char* relativePath, FileMode mode,
+    OS::ThreadContext context)
+{
+    file = noFile;
+    if (!fs || !relativePath) return nullptr;
+    AsyncResultT<size_t>* result = nullptr;
+    m_lock.acquire();
+    Request* request = take();
+    for (AsyncFile i = 0; request && i < WTK_FS_ASYNC_FILES; ++i)
+    {
+        FileSlot& slot = m_files[i];
+        if (slot.state != available) continue;
+        std::strncpy(slot.path, relativePath, Path::maxLength - 1);
+        slot.path[Path::maxLength - 1] = 0;
+        slot.fileSystem = fs;
+        slot.mode = mode;
+        request->operation = Operation::open;
+        request->file = i;
+        request->buffer = nullptr;
+        request->size = 0;
+        request->context = context;
+        result = enqueue(*request);
+        if (result)
+        {
+            slot.state = reserved;
+            file = i;
+        }
+        break;
+    }
+    m_lock.release();
+    return result;
+}
+
+AsyncResultT<size_t>* FS::AsyncIO::read(AsyncFile file, void* buffer, size_t size, OS::ThreadContext context)
+{
+    if (!buffer || !size) return nullptr;
+    return submit(Operation::read, file, buffer, size, context);
+}
+
+AsyncResultT<size_t>* FS::AsyncIO::write(AsyncFile file, const void* buffer, size_t size, OS::ThreadContext context)
+{
+    if (!buffer || !size) return nullptr;
+    return submit(Operation::write, file, const_cast<void*>(buffer), size, context);
+}
+
+AsyncResultT<size_t>* FS::AsyncIO::close(AsyncFile file, OS::ThreadContext context)
+{
+    return submit(Operation::close, file, nullptr, 0, context);
+}
+
+bool FS::AsyncIO::cancel(AsyncResultT<size_t>* result)
+{
+    if (!result) return false;
+    bool isFound = false;
+    m_lock.acquire();
+    for (Request& request : m_requests)
+    {
+        if (request.state == unused || request.result != result) continue;
+        request.isCanceled = true;
+        isFound = true;
+        break;
+    }
+    m_lock.release();
+    return isFound;
+}
+
+size_t FS::AsyncIO::pending()
+{
+    size_t count = 0;
+    for (Request& request : m_requests) if (request.state == queued) ++count;
+    return count;
+}
+
+FS::AsyncIO::Request* FS::AsyncIO::take()
+{
+    for (Request& request : m_requests) if (request.state == unused) return &request;
+    return nullptr;
+}
+
+AsyncResultT<size_t>* FS::AsyncIO::enqueue(Request& request)
+{
+    if (Async::pool.available() < 1) return nullptr; // `createResult()` expects a free pool item.
+    request.result = Async::createResult<size_t>();
+    request.isCanceled = false;
+    request.isSuccessful = false;
+    request.transferred = 0;
+    request.state = queued;
+    m_queue.push(&request); // Never full, the queue is as long as the request slot array.
+    if (!m_thread.active())
+    {
+        m_events.wait(requestEvent, OS::noClear, 0); // Creates the event group before the I/O thread starts.
+        m_thread.start(ioThread, "FS::AsyncIO", OS::ThreadPriority::low);
+    }
+    if (!m_batchDepth) m_events.signal(requestEvent);
+    return request.result;
+}
+
+AsyncResultT<size_t>* FS::AsyncIO::submit(Operation operation, AsyncFile file, void* buffer, size_t size, OS::ThreadContext context)
+{
+    if (file >= WTK_FS_ASYNC_FILES) return nullptr;
+    AsyncResultT<size_t>* result = nullptr;
+    m_lock.acquire();
+    Request* request = m_files[file].state != available ? take() : nullptr;
+    if (request)
+    {
+        request->operation = operation;
+        request->file = file;
+        request->buffer = buffer;
+        request->size = size;
+        request->context = context;
+        result = enqueue(*request);
+    }
+    m_lock.release();
+    return result;
+}
+
+void FS::AsyncIO::ioThread(OS::ThreadArg arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        Request* request;
+        while (m_queue.pop(request)) execute(*request);
+        m_events.wait(requestEvent);
+    }
+}
+
+void FS::AsyncIO::execute(Request& request)
+{
+    FileSlot& slot = m_files[request.file];
+    switch (request.operation)
+    {
+    case Operation::open:
+        new(slot.storage) File(slot.fileSystem, "%s", slot.mode, slot.path); // The path is not a format string.
+        request.isSuccessful = slot.file().isOpen();
+        if (!request.isSuccessful) slot.file().~File();
+        slot.state = request.isSuccessful ? opened : failed;
+        request.transferred = request.file;
+        break;
+    case Operation::read:
+    case Operation::write:
+    {
+        if (slot.state != opened) break;
+        File& file = slot.file();
+        uint8_t* data = static_cast<uint8_t*>(request.buffer);
+        request.isSuccessful = true;
+        while (request.transferred < request.size && !request.isCanceled)
+        {
+            size_t length = request.size - request.transferred;
+            if (length > WTK_FS_ASYNC_CHUNK) length = WTK_FS_ASYNC_CHUNK;
+            if (request.operation == Operation::write)
+            {
+                if (!(request.isSuccessful = file.write(data + request.transferred, length))) break;
+                request.transferred += length;
+                continue;
+            }
+            ReadResult result = file.read(data + request.transferred, length);
+            if (!(request.isSuccessful = result.has_value())) break;
+            request.transferred += result.value();
+            if (result.value() < length) break; // The end of the file.
+        }
+        break;
+    }
+    case Operation::close:
+        request.isSuccessful = true;
+        if (slot.state == opened)
+        {
+            slot.file().close();
+            request.isSuccessful = !slot.file().isOpen();
+            slot.file().~File();
+        }
+        request.transferred = request.file;
+        slot.state = available;
+        break;
+    }
+    complete(request);
+}
+
+void FS::AsyncIO::complete(Request& request)
+{
+    request.state = done;
+    const size_t index = request.context == OS::frame;
+    m_completed[index].push(&request); // Never full, the queue is as long as the request slot array.
+    if (!m_isDelivering[index].exchange(true)) OS::AppThread::sync(&m_completed[index], deliver, request.context);
+}
+
+void FS::AsyncIO::deliver(void* arg)
+{
+    RequestQueue& queue = *static_cast<RequestQueue*>(arg);
+    m_isDelivering[&queue - m_completed] = false; // Requests completed from now on schedule another delivery.
+    Request* request;
+    while (queue.pop(request))
+    {
+        AsyncResultT<size_t>* result = request->result;
+        const bool isSuccessful = request->isSuccessful;
+        const size_t value = request->transferred;
+        m_lock.acquire(); // Synchronizes with `cancel()`.
+        const bool isCanceled = request->isCanceled;
+        request->state = unused; // Released before the continuation, so it can queue the next request.
+        m_lock.release();
+        if (isCanceled) Async::discardResult(result);
+        else if (isSuccessful) Async::setValue(&result, value);
+        else Async::fail(&result);
+    }
+}
@@ -0,0 +1,192 @@
+/**
+ * @file        AsyncIO.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Asynchronous file I/O service. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @remarks     The requests are queued and executed one by one by a dedicated low priority thread,
+ *              the results are completed in the selected application thread context.
+ *              Large transfers are split into `WTK_FS_ASYNC_CHUNK` bytes file system calls,
+ *              so a canceled transfer stops after the current chunk.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "target.h"
+#include "Async.hpp"
+#include "File.hpp"
+#include "RingBuffer.hpp"
+#include "StaticClass.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/Thread.hpp"
+
+namespace FS
+{
+
+/// @brief Asynchronous file handle, an `AsyncIO` file slot index.
+using AsyncFile = uint8_t;
+
+/// @brief Asynchronous file I/O service.
+/// @remarks Call the submitting methods from the thread the result is completed in (`context`, the application thread by default).
+///          The asynchronous result pool is not thread safe, and the completion is delivered in that thread,
+///          so the continuations attached to the returned result right after submitting are never missed.
+///          DO NOT CALL THEM FROM ISR! `cancel()` and `pending()` can be called from any thread.
+///          Each returns a result pointer, or `nullptr` if the request queue or the asynchronous result pool is full.
+///          The buffers passed must stay valid until the request completes.
+///          The result value is the number of bytes transferred (read / write) or the file handle (open / close).
+class AsyncIO final
+{
+
+    STATIC(AsyncIO)
+
+public:
+
+    static constexpr AsyncFile noFile = 0xFF; ///< Invalid file handle value.
+
+    /// @brief Defers waking up the I/O thread until the last `Batch` instance is discarded,
+    ///        so the requests submitted meanwhile are executed back to back.
+    struct Batch final
+    {
+        Batch(const Batch&) = delete; // This type should not be copied.
+        Batch(Batch&&) = delete; // This type should not be moved.
+
+        /// @brief Starts a request batch. Batches nest.
+        Batch() { ++m_batchDepth; }
+
+        /// @brief Ends the batch, wakes the I/O thread if it was the outermost one.
+        ~Batch() { if (--m_batchDepth == 0) m_events.signal(requestEvent); }
+    };
+
+    /// @brief Queues opening a file.
+    /// @param file File handle variable reference. The handle is valid immediately, until the file is closed.
+    /// @param fs File system pointer.
+    /// @param relativePath Relative path to the file. Copied, so it doesn't need to stay valid.
+    /// @param mode One or more flags from the `FileMode` enumeration.
+    /// @param context The thread context the result is completed in. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if the request could not be queued.
+    /// @remarks If the open fails, the handle still needs to be closed.
+    static AsyncResultT<size_t>* open(AsyncFile& file, const FileSystem* fs, const char* relativePath, FileMode mode,
+        OS::ThreadContext context = OS::application);
+
+    /// @brief Queues reading the data from the file.
+    /// @param file File handle.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes requested.
+    /// @param context The thread context the result is completed in. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if the request could not be queued.
+    static AsyncResultT<size_t>* read(AsyncFile file, void* buffer, size_t size, OS::ThreadContext context = OS::application);
+
+    /// @brief Queues writing the data to the file.
+    /// @param file File handle.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes to write.
+    /// @param context The thread context the result is completed in. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if the request could not be queued.
+    static AsyncResultT<size_t>* write(AsyncFile file, const void* buffer, size_t size, OS::ThreadContext context = OS::application);
+
+    /// @brief Queues closing the file. The handle is released when the request is executed.
+    /// @param file File handle.
+    /// @param context The thread context the result is completed in. Default: `application`.
+    /// @returns Asynchronous result pointer or `nullptr` if the request could not be queued.
+    static AsyncResultT<size_t>* close(AsyncFile file, OS::ThreadContext context = OS::application);
+
+    /// @brief Cancels a pending request. Its continuations are not called.
+    /// @param result Asynchronous result pointer returned when the request was queued.
+    /// @returns True if the request was pending and got canceled.
+    /// @remarks A read or write is stopped after the current chunk. Open and close requests are executed anyway.
+    static bool cancel(AsyncResultT<size_t>* result);
+
+    /// @returns The number of requests queued or being executed.
+    static size_t pending();
+
+private:
+
+    /// @brief Request operation.
+    enum class Operation : uint8_t { open, read, write, close };
+
+    /// @brief Request slot state.
+    enum RequestState : uint8_t { unused, queued, done };
+
+    /// @brief File slot state.
+    enum FileState : uint8_t { available, reserved, failed, opened };
+
+    /// @brief Queued I/O request.
+    struct Request
+    {
+        std::atomic<RequestState> state;    // Slot state.
+        std::atomic<bool> isCanceled;       // Set when the request is canceled.
+        Operation operation;                // Requested operation.
+        AsyncFile file;                     // File handle.
+        OS::ThreadContext context;          // Completion thread context.
+        bool isSuccessful;                  // Set when the operation succeeded.
+        void* buffer;                       // Data buffer.
+        size_t size;                        // Requested size.
+        size_t transferred;                 // Number of bytes transferred.
+        AsyncResultT<size_t>* result;       // Asynchronous result.
+    };
+
+    /// @brief Asynchronous file slot.
+    struct FileSlot
+    {
+        alignas(File) uint8_t storage[sizeof(File)];  // The `File` instance storage, valid when `opened`.
+        const FileSystem* fileSystem;               // File system pointer.
+        FileMode mode;                              // File mode.
+        std::atomic<FileState> state;               // Slot state.
+        char path[Path::maxLength];                 // Relative path copy.
+
+        /// @returns The `File` instance reference.
+        inline File& file() { return *reinterpret_cast<File*>(storage); }
+    };
+
+    /// @brief Request pointer queue.
+    using RequestQueue = RingBuffer<WTK_FS_ASYNC_QUEUE, Request*>;
+
+    static constexpr OS::EventFlags requestEvent = 1; // The event flag set when new requests are queued.
+
+    /// @brief Takes a free request slot. Must be called with `m_lock` acquired.
+    /// @returns Request pointer or `nullptr` if all slots are taken.
+    static Request* take();
+
+    /// @brief Creates the request result, queues the request and wakes up the I/O thread. Must be called with `m_lock` acquired.
+    /// @param request Request taken with `take()` and filled.
+    /// @returns Asynchronous result pointer or `nullptr` if the result pool is exhausted.
+    static AsyncResultT<size_t>* enqueue(Request& request);
+
+    /// @brief Queues a request on an open file handle.
+    /// @returns Asynchronous result pointer or `nullptr` if the request could not be queued.
+    static AsyncResultT<size_t>* submit(Operation operation, AsyncFile file, void* buffer, size_t size, OS::ThreadContext context);
+
+    /// @brief I/O thread loop.
+    /// @param arg Not used.
+    static void ioThread(OS::ThreadArg arg);
+
+    /// @brief Executes one request in the I/O thread.
+    /// @param request Request reference.
+    static void execute(Request& request);
+
+    /// @brief Passes the executed request to the completion queue of its thread context.
+    /// @param request Request reference.
+    static void complete(Request& request);
+
+    /// @brief Calls the continuations of the executed requests in the current thread context.
+    /// @param arg Completion queue pointer.
+    static void deliver(void* arg);
+
+    static inline Request m_requests[WTK_FS_ASYNC_QUEUE] = {};            // Request slots.
+    static inline FileSlot m_files[WTK_FS_ASYNC_FILES] = {};              // File slots.
+    static inline RequestQueue m_queue = {};                              // Queued requests.
+    static inline RequestQueue m_completed[2] = {};                       // Executed requests, `application` and `frame`.
+    static inline std::atomic<bool> m_isDelivering[2] = {};               // Set when the delivery is scheduled.
+    static inline std::atomic<uint32_t> m_batchDepth = {};                // The number of active `Batch` instances.
+    static inline OS::ThreadT<WTK_FS_ASYNC_STACK> m_thread = {};         // I/O thread.
+    static inline OS::EventGroup m_events = {};                           // I/O thread wake-up events.
+    static inline OS::Mutex m_lock = {};                                  // Protects the slots and the queue from producers.
+
+};
+
+}
@@ -0,0 +1,222 @@
+/**
+ * @file        Benchmark.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system throughput and latency benchmark. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Benchmark.hpp"
+#include "API.hpp"
+#include "StatCache.hpp"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+#if defined(USE_POSIX)
+#include <ctime>
+#else
+#include "CycleCounter.hpp"
+#endif
+
+FS::Benchmark::Options FS::Benchmark::m_options;
+
+bool FS::Benchmark::run(const FileSystem* fs, const char* directory, void* buffer, size_t size, Output output, const Options& options)
+{
+    if (!fs || !directory || !buffer || size < minBlockSize || !output) return false;
+    m_fileSystem = fs;
+    m_directory = directory;
+    m_buffer = static_cast<uint8_t*>(buffer);
+    m_size = size;
+    m_output = output;
+    m_options = options;
+    m_random = 0x12345678u; // The same sequence every run, so the results can be compared.
+    if (m_options.latencySamples > maxSamples) m_options.latencySamples = maxSamples;
+#if !defined(USE_POSIX)
+    CycleCounter::init();
+    m_lastCycles = CycleCounter::now();
+#endif
+    for (size_t i = 0; i < size; ++i) m_buffer[i] = static_cast<uint8_t>(i * 131 + 7);
+    Path path(fs);
+    path.join(directory);
+    if (!directoryExists(fs, path.relativePath()) && !directoryCreate(fs, path.relativePath())) return false;
+    print("throughput,test,block_size,bytes,time_us,kB_per_s");
+    for (size_t blockSize = minBlockSize; blockSize <= maxBlockSize && blockSize <= size; blockSize *= 2)
+        if (!throughput(blockSize)) return false;
+    print("latency,operation,samples,p50_us,p90_us,p99_us,max_us");
+    if (!latency()) return false;
+    print("metadata,operation,files,time_us,average_us");
+    return metadata();
+}
+
+bool FS::Benchmark::throughput(size_t blockSize)
+{
+    const uint32_t blocks = static_cast<uint32_t>(m_options.fileSize / blockSize);
+    if (!blocks) return true; // The file is smaller than one block.
+    const uint32_t randomBlocks = std::max<uint32_t>(1, std::min(m_options.randomBlocks, blocks / 4));
+    Path path(m_fileSystem);
+    path.join(m_directory).join("bench.dat");
+    const char* tests[] = { "seq_write", "seq_read", "rand_write", "rand_read" };
+    for (size_t test = 0; test < 4; ++test)
+    {
+        const bool isWrite = !(test & 1);
+        const bool isRandom = test >= 2;
+        const uint32_t count = isRandom ? randomBlocks : blocks;
+        FileMode mode = isRandom ? (isWrite ? FileMode::read | FileMode::write : FileMode::read)
+                                 : (isWrite ? FileMode::write | FileMode::createAlways : FileMode::read);
+        const uint64_t start = now();
+        {
+            File file(path, mode);
+            if (!file) return false;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                sample();
+                if (isRandom && !file.seek(static_cast<File::FileOffset>(random() % blocks) * blockSize)) return false;
+                if (isWrite && !file.write(m_buffer, blockSize)) return false;
+                if (isWrite) continue;
+                ReadResult result = file.read(m_buffer, blockSize);
+                if (!result.has_value() || result.value() != blockSize) return false;
+            }
+        } // The file is closed here, so the time includes committing the data.
+        const uint64_t time = now() - start;
+        const uint64_t bytes = static_cast<uint64_t>(count) * blockSize;
+        const uint64_t rate = time ? bytes * 1000000u / 1024u / time : 0;
+        print("throughput,%s,%lu,%lu,%lu,%lu", tests[test], static_cast<unsigned long>(blockSize),
+            static_cast<unsigned long>(bytes), static_cast<unsigned long>(time), static_cast<unsigned long>(rate));
+    }
+    return fileDelete(m_fileSystem, path.relativePath());
+}
+
+bool FS::Benchmark::latency()
+{
+    Path path(m_fileSystem);
+    path.join(m_directory).join("latency.dat");
+    {
+        File file(path, FileMode::write | FileMode::createAlways);
+        if (!file || !file.write(m_buffer, minBlockSize)) return false;
+    }
+    const size_t count = m_options.latencySamples;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint64_t start = now();
+        File file(path, FileMode::read);
+        m_samples[i] = static_cast<uint32_t>(now() - start);
+        if (!file) return false;
+    }
+    report("open", count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        File file(path, FileMode::read);
+        if (!file) return false;
+        const uint64_t start = now();
+        file.close();
+        m_samples[i] = static_cast<uint32_t>(now() - start);
+    }
+    report("close", count);
+    FileStat entry;
+    for (size_t pass = 0; pass < 2; ++pass) // Through the media first, then from `StatCache`.
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!pass) StatCache::invalidate(m_fileSystem, path.relativePath());
+            const uint64_t start = now();
+            if (!stat(m_fileSystem, path.relativePath(), entry)) return false;
+            m_samples[i] = static_cast<uint32_t>(now() - start);
+        }
+        report(pass ? "stat_cached" : "stat", count);
+    }
+    return fileDelete(m_fileSystem, path.relativePath());
+}
+
+bool FS::Benchmark::metadata()
+{
+    const uint32_t files = m_options.metadataFiles;
+    Path directory(m_fileSystem);
+    directory.join(m_directory);
+    Path base(directory);
+    base.join("m");
+    FileStat entry;
+    const char* operations[] = { "create", "stat", "list", "delete" };
+    StatCache::invalidate(m_fileSystem);
+    for (size_t operation = 0; operation < 4; ++operation)
+    {
+        const uint64_t start = now();
+        if (operation == 2)
+        {
+            uint32_t listed = 0;
+            Directory list(directory);
+            list.filter("m*");
+            for (const DirectoryItem& item : list) { (void)item; ++listed; sample(); }
+            if (!list.isComplete() || listed != files) return false;
+        }
+        else for (uint32_t i = 0; i < files; ++i)
+        {
+            sample();
+            Path name(base);
+            name.append(i, 5);
+            bool isDone = false;
+            switch (operation)
+            {
+            case 0: isDone = fileCreate(m_fileSystem, name.relativePath()); break;
+            case 1: isDone = stat(m_fileSystem, name.relativePath(), entry); break;
+            default: isDone = fileDelete(m_fileSystem, name.relativePath()); break;
+            }
+            if (!isDone) return false;
+        }
+        const uint64_t time = now() - start;
+        print("metadata,%s,%lu,%lu,%lu", operations[operation], static_cast<unsigned long>(files),
+            static_cast<unsigned long>(time), static_cast<unsigned long>(files ? time / files : 0));
+    }
+    return true;
+}
+
+void FS::Benchmark::report(const char* operation, size_t count)
+{
+    if (!count) return;
+    std::sort(m_samples, m_samples + count);
+    const size_t last = count - 1;
+    print("latency,%s,%lu,%lu,%lu,%lu,%lu", operation, static_cast<unsigned long>(count),
+        static_cast<unsigned long>(m_samples[last * 50 / 100]), static_cast<unsigned long>(m_samples[last * 90 / 100]),
+        static_cast<unsigned long>(m_samples[last * 99 / 100]), static_cast<unsigned long>(m_samples[last]));
+}
+
+void FS::Benchmark::print(const char* format, ...)
+{
+    char line[128];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    m_output(line);
+}
+
+uint64_t FS::Benchmark::now()
+{
+#if defined(USE_POSIX)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000u + static_cast<uint64_t>(time.tv_nsec) / 1000u;
+#else
+    sample();
+    return m_cycles * 1000000u / CycleCounter::frequency();
+#endif
+}
+
+void FS::Benchmark::sample()
+{
+#if !defined(USE_POSIX)
+    const uint32_t cycles = CycleCounter::now();
+    m_cycles += cycles - m_lastCycles; // Valid as long as the samples are less than 2^32 cycles apart.
+    m_lastCycles = cycles;
+#endif
+}
+
+uint32_t FS::Benchmark::random()
+{
+    m_random ^= m_random << 13; // Xorshift32.
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file        Benchmark.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File system throughput and latency benchmark. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "FileSystem.hpp"
+#include "StaticClass.hpp"
+#include <cstdint>
+
+namespace FS
+{
+
+/// @brief Measures the file system throughput and latency, writes the results as CSV lines.
+/// @remarks Runs synchronously, call it from a thread that can block for a long time.
+///          With the `USE_POSIX` backend it runs on a host, measuring the overhead of the file system API itself.
+///          Tables, each preceded by its header line:
+///          - `throughput,test,block_size,bytes,time_us,kB_per_s`: sequential and random reads and writes,
+///          - `latency,operation,samples,p50_us,p90_us,p99_us,max_us`: open, close and stat, with and without `StatCache`,
+///          - `metadata,operation,files,time_us,average_us`: creating, getting the metadata of and deleting many files.
+class Benchmark final
+{
+
+    STATIC(Benchmark)
+
+public:
+
+    /// @brief Receives one CSV line, without the line terminator.
+    using Output = void(*)(const char* line);
+
+    static constexpr size_t minBlockSize = 512;         ///< The smallest block size tested.
+    static constexpr size_t maxBlockSize = 262144;      ///< The largest block size tested, if the buffer is large enough.
+    static constexpr size_t maxSamples = 256;           ///< The maximal number of latency samples per operation.
+
+    /// @brief Benchmark options.
+    struct Options final
+    {
+        uint32_t fileSize = 4194304;    ///< The test file size in bytes for the throughput tests.
+        uint32_t randomBlocks = 256;    ///< The number of blocks per random access test, up to a quarter of the test file.
+        uint32_t latencySamples = 100;  ///< The number of latency samples per operation, up to `maxSamples`.
+        uint32_t metadataFiles = 1000;  ///< The number of files in the metadata tests.
+    };
+
+    /// @brief Runs all tests on the file system in the specified directory, the directory is created if needed.
+    /// @param fs File system pointer.
+    /// @param directory Test directory path relative to the file system root. Test files are deleted when done.
+    /// @param buffer Transfer buffer pointer. Its size limits the largest block size tested.
+    /// @param size Transfer buffer size in bytes, at least `minBlockSize`.
+    /// @param output CSV line output function.
+    /// @param options Benchmark options.
+    /// @returns True if all tests passed, false if a file operation failed.
+    static bool run(const FileSystem* fs, const char* directory, void* buffer, size_t size, Output output,
+        const Options& options);
+
+    /// @brief Runs all tests with the default options.
+    /// @param fs File system pointer.
+    /// @param directory Test directory path relative to the file system root.
+    /// @param buffer Transfer buffer pointer.
+    /// @param size Transfer buffer size in bytes, at least `minBlockSize`.
+    /// @param output CSV line output function.
+    /// @returns True if all tests passed, false if a file operation failed.
+    static bool run(const FileSystem* fs, const char* directory, void* buffer, size_t size, Output output)
+    {
+        return run(fs, directory, buffer, size, output, Options());
+    }
+
+private:
+
+    /// @brief Measures writing or reading the whole test file sequentially, then randomly, with the specified block size.
+    /// @returns True if all operations succeeded.
+    static bool throughput(size_t blockSize);
+
+    /// @brief Measures the open, close and stat latency percentiles.
+    /// @returns True if all operations succeeded.
+    static bool latency();
+
+    /// @brief Measures creating, getting the metadata of and deleting many files.
+    /// @returns True if all operations succeeded.
+    static bool metadata();
+
+    /// @brief Writes the latency percentiles of the collected samples.
+    /// @param operation Operation name.
+    /// @param count The number of samples collected.
+    static void report(const char* operation, size_t count);
+
+    /// @brief Formats and writes one CSV line.
+    /// @param format Format string.
+    /// @param ... Format arguments.
+    static void print(const char* format, ...);
+
+    /// @returns A monotonic time in microseconds.
+    static uint64_t now();
+
+    /// @brief Accumulates the CPU cycles elapsed since the last call, does nothing on a host.
+    /// @remarks The 32-bit cycle counter wraps in about 27 seconds at 160MHz,
+    ///          so it is sampled for each block, file and directory entry, not only at the ends of the timed spans.
+    static void sample();
+
+    /// @returns The next pseudo random number.
+    static uint32_t random();
+
+    static inline const FileSystem* m_fileSystem = {};  // Tested file system.
+    static inline const char* m_directory = {};         // Test directory path.
+    static inline uint8_t* m_buffer = {};               // Transfer buffer.
+    static inline size_t m_size = {};                   // Transfer buffer size.
+    static inline Output m_output = {};                 // CSV line output.
+    static Options m_options;                           // Current options.
+    static inline uint32_t m_random = {};               // Pseudo random generator state.
+    static inline uint32_t m_samples[maxSamples] = {};  // Latency samples in microseconds.
+#if !defined(USE_POSIX)
+    static inline uint64_t m_cycles = {};               // CPU cycles counted since the benchmark started.
+    static inline uint32_t m_lastCycles = {};           // The cycle counter value at the last sample.
+#endif
+
+};
+
+}
@@ -0,0 +1,140 @@
+/**
+ * @file        BufferedFile.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Write-back and read-ahead buffering for the `File` access. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "BufferedFile.hpp"
+#include <cstring>
+
+FS::BufferedFile::BufferedFile(File& file, uint8_t* buffer, size_t size)
+    : m_file(file), m_buffer(buffer), m_size(size), m_begin(0), m_length(0), m_limit(0), m_state(idle) { }
+
+FS::BufferedFile::~BufferedFile() { flush(); }
+
+bool FS::BufferedFile::seek(FileOffset offset)
+{
+    if (!release()) return false;
+    return m_file.seek(offset);
+}
+
+FS::ReadResult FS::BufferedFile::read(void* buffer, size_t size)
+{
+    if (!m_file || !buffer || !size) return ReadResult();
+    if (m_state == writing && !release()) return ReadResult();
+    uint8_t* target = static_cast<uint8_t*>(buffer);
+    size_t total = 0;
+    while (total < size)
+    {
+        if (m_state == reading && m_begin < m_length) // Serve from the buffer.
+        {
+            size_t n = m_length - m_begin;
+            if (n > size - total) n = size - total;
+            std::memcpy(target + total, m_buffer + m_begin, n);
+            m_begin += n;
+            total += n;
+            continue;
+        }
+        if (m_state == reading && m_length < m_limit) break; // The last refill hit the end of the file.
+        m_state = idle;
+        m_begin = m_length = 0;
+        m_limit = toBoundary();
+        if (!m_limit) return total ? ReadResult(total) : ReadResult();
+        const size_t remaining = size - total;
+        if (m_limit == m_size && remaining >= m_size) // Aligned large reads bypass the buffer.
+        {
+            const size_t direct = remaining - remaining % m_size;
+            ReadResult result = m_file.read(target + total, direct);
+            if (!result.has_value()) return total ? ReadResult(total) : ReadResult();
+            total += result.value();
+            if (result.value() < direct) break;
+            continue;
+        }
+        // Refill up to the next block boundary to keep the following reads aligned.
+        ReadResult result = m_file.read(m_buffer, m_limit);
+        if (!result.has_value()) return total ? ReadResult(total) : ReadResult();
+        m_length = result.value();
+        m_state = reading;
+        if (!m_length) break;
+    }
+    return ReadResult(total);
+}
+
+bool FS::BufferedFile::write(const void* buffer, size_t size)
+{
+    if (!m_file || !buffer || !size) return false;
+    if (m_state == reading && !release()) return false;
+    if (m_state == idle)
+    {
+        m_limit = toBoundary();
+        if (!m_limit) return false;
+        m_length = 0;
+        m_state = writing;
+    }
+    const uint8_t* source = static_cast<const uint8_t*>(buffer);
+    while (size)
+    {
+        if (!m_length && m_limit == m_size && size >= m_size) // Aligned large writes bypass the buffer.
+        {
+            const size_t direct = size - size % m_size;
+            if (!m_file.write(source, direct)) return false;
+            source += direct;
+            size -= direct;
+            continue;
+        }
+        size_t n = m_limit - m_length;
+        if (n > size) n = size;
+        std::memcpy(m_buffer + m_length, source, n);
+        m_length += n;
+        source += n;
+        size -= n;
+        if (m_length < m_limit) break;
+        if (!m_file.write(m_buffer, m_length)) return false;
+        m_length = 0;
+        m_limit = m_size;
+    }
+    return true;
+}
+
+bool FS::BufferedFile::flush()
+{
+    if (m_state != writing) return true;
+    bool ok = !m_length || m_file.write(m_buffer, m_length);
+    if (ok) m_limit -= m_length; // The next write continues up to the same block boundary.
+    m_length = 0;
+    if (!m_limit) m_limit = m_size;
+    return ok;
+}
+
+bool FS::BufferedFile::close()
+{
+    bool ok = flush();
+    m_state = idle;
+    m_file.close();
+    return ok;
+}
+
+bool FS::BufferedFile::release()
+{
+    bool ok = true;
+    if (m_state == writing) ok = flush();
+    else if (m_state == reading && m_begin < m_length) // The file pointer is ahead of the logical position.
+    {
+        FileOffset offset;
+        ok = m_file.tell(offset) && m_file.seek(offset - (m_length - m_begin));
+    }
+    m_state = idle;
+    m_begin = m_length = 0;
+    return ok;
+}
+
+size_t FS::BufferedFile::toBoundary()
+{
+    FileOffset offset;
+    if (!m_file.tell(offset)) return 0;
+    return m_size - static_cast<size_t>(offset % m_size);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file        BufferedFile.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Write-back and read-ahead buffering for the `File` access. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "File.hpp"
+
+namespace FS
+{
+
+/// @brief Buffers the access to an open `File`, so small reads and writes reach the file system in buffer sized blocks.
+/// @remarks The buffer boundaries are aligned to the file offsets that are buffer size multiples,
+///          so with a sector multiple buffer size the file system never has to read-modify-write a partial sector.
+///          Writes are flushed when the buffer is full, on `flush()`, `seek()`, `close()` and when the object is discarded.
+///          Declare the buffered file after the file, so it is discarded (and flushed) first.
+class BufferedFile
+{
+
+public:
+
+    using FileOffset = AdapterTypes::FileOffset; // File offset number type.
+
+    BufferedFile(const BufferedFile&) = delete; // This type should not be copied.
+    BufferedFile(BufferedFile&&) = delete; // This type should not be moved.
+
+    /// @brief Creates a buffered access to the file using the caller provided storage.
+    /// @param file Open file reference.
+    /// @param buffer Buffer pointer. Preferably 32 bytes aligned for DMA.
+    /// @param size Buffer size in bytes. Should be a media sector size multiple.
+    BufferedFile(File& file, uint8_t* buffer, size_t size);
+
+    /// @brief Flushes the pending writes.
+    ~BufferedFile();
+
+    /// @returns True if the underlying file is open.
+    inline bool isOpen() const { return m_file.isOpen(); }
+
+    /// @returns True if the underlying file is open.
+    inline operator bool() const { return m_file.isOpen(); }
+
+    /// @returns The buffer size in bytes.
+    inline size_t bufferSize() const { return m_size; }
+
+    /// @brief Moves the read / write pointer to the specified offset in the file. Flushes the pending writes first.
+    /// @param offset File offset.
+    /// @returns True if done. False otherwise.
+    bool seek(FileOffset offset);
+
+    /// @brief Reads the data, from the buffer if available, refilling it with the next file block when empty.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes requested.
+    /// @returns Number of bytes read or an empty value if error occurred.
+    ReadResult read(void* buffer, size_t size);
+
+    /// @brief Reads a structure or a primitive type.
+    /// @tparam T The type of the structure, can also be a primitive type.
+    /// @param data The data reference.
+    /// @returns True if read successfully, false if not read at all or less than required length read.
+    template<typename T> bool read(T& data)
+    {
+        constexpr size_t size = sizeof(data);
+        ReadResult result = read(&data, size);
+        return result.has_value() && result.value() == size;
+    }
+
+    /// @brief Writes the data to the buffer, writes the buffer to the file when full.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes to write.
+    /// @returns True if written successfully. False otherwise.
+    bool write(const void* buffer, size_t size);
+
+    /// @brief Writes a structure or a primitive type.
+    /// @tparam T  The type of the structure, can also be a primitive type.
+    /// @param data The data reference.
+    /// @returns True if written successfully. False otherwise.
+    template<typename T> bool write(T& data) { return write(&data, sizeof(data)); }
+
+    /// @brief Writes the pending data to the file.
+    /// @returns True if written successfully or nothing to write. False otherwise.
+    bool flush();
+
+    /// @brief Flushes the pending writes and closes the file.
+    /// @returns True if the pending data was written successfully.
+    bool close();
+
+private:
+
+    /// @brief Buffer state.
+    enum State : uint8_t
+    {
+        idle,       // The buffer is empty.
+        writing,    // The buffer contains data not yet written to the file.
+        reading     // The buffer contains data read ahead from the file.
+    };
+
+    /// @brief Writes the pending data or drops the read ahead data, moving the file pointer back to the logical position.
+    /// @returns True if successful.
+    bool release();
+
+    /// @returns The number of bytes from the current file position to the next buffer size multiple, zero on error.
+    size_t toBoundary();
+
+    File& m_file;       // Underlying file reference.
+    uint8_t* m_buffer;  // Buffer pointer.
+    size_t m_size;      // Buffer size.
+    size_t m_begin;     // Reading: the offset of the first unread byte.
+    size_t m_length;    // The number of valid bytes in the buffer.
+    size_t m_limit;     // Writing: the number of bytes that reach the next block boundary.
+    State m_state;      // Buffer state.
+
+};
+
+/// @brief Buffers the access to an open `File` using the internal buffer.
+/// @tparam TSize Buffer size in bytes. Should be a media sector size multiple.
+template<size_t TSize>
+class BufferedFileT final : public BufferedFile
+{
+
+public:
+
+    /// @brief Creates a buffered access to the file.
+    /// @param file Open file reference.
+    BufferedFileT(File& file) : BufferedFile(file, m_storage, TSize) { }
+
+private:
+
+    alignas(32) uint8_t m_storage[TSize]; // Buffer storage.
+
+};
+
+}
@@ -0,0 +1,413 @@
+/**
+ * @file        CompressedFile.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Streaming LZ4 compression of the file data. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "CompressedFile.hpp"
+#include <algorithm>
+#include <cstring>
+
+static constexpr uint32_t frameMagic = 0x184d2204u;         // LZ4 frame magic number.
+static constexpr uint32_t skippableMagic = 0x184d2a50u;     // Skippable frame magic number, the lowest 4 bits are any.
+static constexpr uint32_t filterMagic = 0x184d2a57u;        // The magic number of the skippable frame announcing the filter.
+static constexpr uint32_t filterId = 0x444b5457u;           // "WTKD", the delta filter identifier.
+static constexpr uint32_t rawBlock = 0x80000000u;           // The block size flag of a block stored as it is.
+static constexpr uint8_t frameVersion = 0x40;               // FLG: version 01.
+static constexpr uint8_t independentBlocks = 0x20;          // FLG: the blocks are independent.
+static constexpr uint8_t blockChecksum = 0x10;              // FLG: each block is followed by its checksum.
+static constexpr uint8_t contentSize = 0x08;                // FLG: the frame header contains the content size.
+static constexpr uint8_t contentChecksum = 0x04;            // FLG: the frame is ended with the content checksum.
+static constexpr uint8_t dictionaryId = 0x01;               // FLG: the frame header contains the dictionary identifier.
+static constexpr uint8_t blockMax64KB = 0x40;               // BD: the maximal block size is 64KB.
+static constexpr size_t hashSize = 1u << WTK_FS_LZ4_HASH_BITS; // The number of the match finder table entries.
+static constexpr size_t minMatch = 4;                       // The minimal match length.
+static constexpr size_t lastLiterals = 5;                   // The number of bytes at the block end that are always literals.
+static constexpr size_t matchFindLimit = 12;                // The last match starts at least this number of bytes before the end.
+
+/// @returns A 32-bit little endian value from the unaligned address.
+static inline uint32_t load32(const uint8_t* address)
+{
+    uint32_t value;
+    std::memcpy(&value, address, sizeof(value));
+    return value;
+}
+
+/// @brief Stores a 32-bit little endian value at the unaligned address.
+static inline void store32(uint8_t* address, uint32_t value)
+{
+    std::memcpy(address, &value, sizeof(value));
+}
+
+/// @returns The match finder table index of the 4 bytes value.
+static inline uint32_t hash4(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - WTK_FS_LZ4_HASH_BITS);
+}
+
+/// @brief Writes the length bytes following a token nibble of 15.
+/// @returns The next output pointer.
+static inline uint8_t* writeLength(uint8_t* output, size_t length)
+{
+    for (; length >= 255; length -= 255) *output++ = 255;
+    *output++ = static_cast<uint8_t>(length);
+    return output;
+}
+
+/// @brief Reads the length bytes following a token nibble of 15.
+/// @returns True if read, false if the input ended.
+static inline bool readLength(const uint8_t*& input, const uint8_t* end, size_t& length)
+{
+    uint8_t value;
+    do
+    {
+        if (input >= end) return false;
+        value = *input++;
+        length += value;
+    } while (value == 255);
+    return true;
+}
+
+FS::CompressedFile::CompressedFile(File& file, uint8_t* buffer, size_t blockSize, uint16_t* table, uint8_t deltaStride)
+    : m_file(file), m_block(buffer), m_packed(buffer + blockSize), m_blockSize(std::min(blockSize, maxBlockSize)), m_table(table),
+      m_position(0), m_length(0), m_size(0), m_compressedSize(0), m_delta(),
+      m_deltaStride(deltaStride <= sizeof(m_delta) ? deltaStride : 0), m_frameStride(0), m_deltaIndex(0), m_frameFlags(0),
+      m_state(idle) { }
+
+FS::CompressedFile::~CompressedFile()
+{
+    finish();
+}
+
+bool FS::CompressedFile::write(const void* buffer, size_t size)
+{
+    if (m_state == idle && !writeHeader()) return false;
+    if (m_state != writing) return false;
+    const uint8_t* data = static_cast<const uint8_t*>(buffer);
+    while (size)
+    {
+        const size_t length = std::min(size, m_blockSize - m_length);
+        std::memcpy(m_block + m_length, data, length);
+        m_length += length;
+        m_size += length;
+        data += length;
+        size -= length;
+        if (m_length == m_blockSize && !writeBlock()) return false;
+    }
+    return true;
+}
+
+bool FS::CompressedFile::flush()
+{
+    return m_state != writing || writeBlock();
+}
+
+bool FS::CompressedFile::finish()
+{
+    if (m_state != writing) return m_state != failed;
+    uint8_t endMark[4] = {};
+    if (!writeBlock() || !m_file.write(endMark, sizeof(endMark)))
+    {
+        m_state = failed;
+        return false;
+    }
+    m_compressedSize += sizeof(endMark);
+    m_state = idle;
+    return true;
+}
+
+FS::ReadResult FS::CompressedFile::read(void* buffer, size_t size)
+{
+    if (m_state == idle) m_state = reading;
+    if (m_state != reading && m_state != ended) return {};
+    uint8_t* data = static_cast<uint8_t*>(buffer);
+    size_t done = 0;
+    while (done < size)
+    {
+        if (m_position == m_length && (m_state == ended || !readBlock())) break;
+        const size_t length = std::min(size - done, m_length - m_position);
+        std::memcpy(data + done, m_block + m_position, length);
+        m_position += length;
+        done += length;
+    }
+    if (m_state == failed && !done) return {}; // The bytes already copied are returned first, the next call fails.
+    return done;
+}
+
+bool FS::CompressedFile::close()
+{
+    const bool isFinished = finish();
+    m_file.close();
+    return isFinished;
+}
+
+size_t FS::CompressedFile::compress(const uint8_t* source, size_t size, uint8_t* target, size_t capacity, uint16_t* table)
+{
+    if (!source || !target || !table || size > maxBlockSize) return 0;
+    const uint8_t* const end = source + size;
+    const uint8_t* anchor = source;
+    uint8_t* output = target;
+    uint8_t* const outputEnd = target + capacity;
+    if (size > matchFindLimit)
+    {
+        std::memset(table, 0, hashSize * sizeof(uint16_t));
+        const uint8_t* const limit = end - matchFindLimit;
+        const uint8_t* const matchLimit = end - lastLiterals;
+        const uint8_t* input = source + 1;
+        while (input < limit)
+        {
+            const uint8_t* match = nullptr;
+            for (size_t attempts = 64; input < limit; input += attempts++ >> 6) // Steps faster through the data not matching.
+            {
+                const uint32_t value = load32(input);
+                uint16_t& entry = table[hash4(value)];
+                match = source + entry;
+                entry = static_cast<uint16_t>(input - source);
+                if (match < input && load32(match) == value) break;
+                match = nullptr;
+            }
+            if (!match) break;
+            while (input > anchor && match > source && input[-1] == match[-1])
+            {
+                --input;
+                --match;
+            }
+            const uint8_t* matchEnd = input + minMatch;
+            for (const uint8_t* reference = match + minMatch; matchEnd < matchLimit && *matchEnd == *reference; ++reference) ++matchEnd;
+            const size_t literals = input - anchor;
+            const size_t length = matchEnd - input - minMatch;
+            if (literals + literals / 255 + length / 255 + 5 > static_cast<size_t>(outputEnd - output)) return 0;
+            uint8_t* token = output++;
+            *token = static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4);
+            if (literals >= 15) output = writeLength(output, literals - 15);
+            std::memcpy(output, anchor, literals);
+            output += literals;
+            const size_t offset = input - match;
+            *output++ = static_cast<uint8_t>(offset);
+            *output++ = static_cast<uint8_t>(offset >> 8);
+            *token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+            if (length >= 15) output = writeLength(output, length - 15);
+            anchor = input = matchEnd;
+        }
+    }
+    const size_t literals = end - anchor;
+    if (literals + literals / 255 + 2 > static_cast<size_t>(outputEnd - output)) return 0;
+    *output++ = static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4);
+    if (literals >= 15) output = writeLength(output, literals - 15);
+    std::memcpy(output, anchor, literals);
+    return output + literals - target;
+}
+
+FS::ReadResult FS::CompressedFile::decompress(const uint8_t* source, size_t size, uint8_t* target, size_t capacity)
+{
+    if (!source || !target) return {};
+    const uint8_t* input = source;
+    const uint8_t* const end = source + size;
+    uint8_t* output = target;
+    uint8_t* const outputEnd = target + capacity;
+    while (input < end)
+    {
+        const uint8_t token = *input++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(input, end, literals)) return {};
+        if (literals > static_cast<size_t>(end - input) || literals > static_cast<size_t>(outputEnd - output)) return {};
+        std::memcpy(output, input, literals);
+        input += literals;
+        output += literals;
+        if (input == end) break; // The last sequence has no match.
+        if (end - input < 2) return {};
+        const size_t offset = input[0] | input[1] << 8;
+        input += 2;
+        size_t length = token & 15;
+        if (length == 15 && !readLength(input, end, length)) return {};
+        length += minMatch;
+        if (!offset || offset > static_cast<size_t>(output - target) || length > static_cast<size_t>(outputEnd - output)) return {};
+        const uint8_t* match = output - offset;
+        if (offset >= length) std::memcpy(output, match, length);
+        else for (size_t i = 0; i < length; ++i) output[i] = match[i]; // Overlapping, repeats the last `offset` bytes.
+        output += length;
+    }
+    return static_cast<size_t>(output - target);
+}
+
+bool FS::CompressedFile::writeHeader()
+{
+    uint8_t header[20];
+    size_t size = 0;
+    if (m_deltaStride)
+    {
+        store32(header, filterMagic);
+        store32(header + 4, 5);
+        store32(header + 8, filterId);
+        header[12] = m_deltaStride;
+        size = 13;
+    }
+    store32(header + size, frameMagic);
+    header[size + 4] = frameVersion | independentBlocks;
+    header[size + 5] = blockMax64KB;
+    header[size + 6] = static_cast<uint8_t>(xxh32(header + size + 4, 2) >> 8);
+    size += 7;
+    if (!m_file.write(header, size))
+    {
+        m_state = failed;
+        return false;
+    }
+    m_compressedSize += size;
+    m_frameStride = m_deltaStride;
+    m_deltaIndex = 0;
+    std::memset(m_delta, 0, sizeof(m_delta));
+    m_length = 0;
+    m_state = writing;
+    return true;
+}
+
+bool FS::CompressedFile::writeBlock()
+{
+    if (!m_length) return true;
+    filter(false);
+    constexpr size_t headerSize = sizeof(uint32_t);
+    const size_t size = m_length > headerSize ? compress(m_block, m_length, m_packed + headerSize, m_length - headerSize, m_table) : 0;
+    bool isWritten;
+    if (size)
+    {
+        store32(m_packed, static_cast<uint32_t>(size));
+        isWritten = m_file.write(m_packed, headerSize + size);
+        m_compressedSize += headerSize + size;
+    }
+    else // Doesn't compress.
+    {
+        uint8_t header[headerSize];
+        store32(header, static_cast<uint32_t>(m_length) | rawBlock);
+        isWritten = m_file.write(header, headerSize) && m_file.write(m_block, m_length);
+        m_compressedSize += headerSize + m_length;
+    }
+    m_length = 0;
+    if (!isWritten) m_state = failed;
+    return isWritten;
+}
+
+bool FS::CompressedFile::readBlock()
+{
+    m_position = 0;
+    m_length = 0;
+    while (!m_length)
+    {
+        if (!m_frameFlags && !readHeader()) return false;
+        uint32_t size;
+        if (!readExactly(&size, sizeof(size))) break;
+        m_compressedSize += sizeof(size);
+        if (!size) // End mark.
+        {
+            if (m_frameFlags & contentChecksum && !readExactly(&size, sizeof(size))) break;
+            m_frameFlags = 0;
+            m_frameStride = 0;
+            continue;
+        }
+        const bool isRaw = size & rawBlock;
+        size &= ~rawBlock;
+        if (size > m_blockSize) break;
+        if (!readExactly(isRaw ? m_block : m_packed, size)) break;
+        m_compressedSize += size;
+        if (isRaw) m_length = size;
+        else
+        {
+            ReadResult result = decompress(m_packed, size, m_block, m_blockSize);
+            if (!result.has_value()) break;
+            m_length = result.value();
+        }
+        if (m_frameFlags & blockChecksum && !readExactly(&size, sizeof(size))) break;
+        m_size += m_length;
+        filter(true);
+        if (m_length) return true;
+    }
+    m_length = 0;
+    m_state = failed;
+    return false;
+}
+
+bool FS::CompressedFile::readHeader()
+{
+    uint8_t header[15];
+    for (;;)
+    {
+        ReadResult result = m_file.read(header, sizeof(uint32_t));
+        if (result.has_value() && !result.value()) // All adapters read 0 bytes at the end of the file.
+        {
+            m_state = ended;
+            return false;
+        }
+        if (!result.has_value() || result.value() != sizeof(uint32_t)) break;
+        const uint32_t magic = load32(header);
+        m_compressedSize += sizeof(uint32_t);
+        if ((magic & 0xfffffff0u) == skippableMagic)
+        {
+            if (!readExactly(header, sizeof(uint32_t))) break;
+            const uint32_t size = load32(header);
+            m_compressedSize += sizeof(uint32_t) + size;
+            if (magic == filterMagic && size == 5)
+            {
+                if (!readExactly(header, size)) break;
+                if (load32(header) == filterId && header[4] <= sizeof(m_delta)) m_frameStride = header[4];
+                continue;
+            }
+            File::FileOffset offset;
+            if (!m_file.tell(offset) || !m_file.seek(offset + size)) break;
+            continue;
+        }
+        if (magic != frameMagic || !readExactly(header, 2)) break;
+        const uint8_t flags = header[0];
+        if ((flags & 0xc0) != frameVersion || !(flags & independentBlocks) || flags & dictionaryId) break; // Not supported.
+        const size_t size = flags & contentSize ? 11 : 3;
+        if (!readExactly(header + 2, size - 2)) break;
+        if (header[size - 1] != static_cast<uint8_t>(xxh32(header, size - 1) >> 8)) break;
+        m_compressedSize += size;
+        m_frameFlags = flags;
+        m_deltaIndex = 0;
+        std::memset(m_delta, 0, sizeof(m_delta));
+        return true;
+    }
+    m_state = failed;
+    return false;
+}
+
+void FS::CompressedFile::filter(bool isReversed)
+{
+    if (!m_frameStride) return;
+    for (size_t i = 0; i < m_length; ++i)
+    {
+        const uint8_t value = m_block[i];
+        if (isReversed) m_delta[m_deltaIndex] = m_block[i] = value + m_delta[m_deltaIndex];
+        else
+        {
+            m_block[i] = value - m_delta[m_deltaIndex];
+            m_delta[m_deltaIndex] = value;
+        }
+        if (++m_deltaIndex == m_frameStride) m_deltaIndex = 0;
+    }
+}
+
+bool FS::CompressedFile::readExactly(void* buffer, size_t size)
+{
+    ReadResult result = m_file.read(buffer, size);
+    return result.has_value() && result.value() == size;
+}
+
+uint32_t FS::CompressedFile::xxh32(const uint8_t* data, size_t size)
+{
+    constexpr uint32_t prime1 = 2654435761u, prime2 = 2246822519u, prime3 = 3266489917u, prime4 = 668265263u, prime5 = 374761393u;
+    auto rotate = [](uint32_t value, int bits) { return (value << bits) | (value >> (32 - bits)); };
+    uint32_t hash = prime5 + static_cast<uint32_t>(size); // Seed 0, less than 16 bytes.
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) hash = rotate(hash + load32(data + i) * prime3, 17) * prime4;
+    for (; i < size; ++i) hash = rotate(hash + data[i] * prime5, 11) * prime1;
+    hash ^= hash >> 15;
+    hash *= prime2;
+    hash ^= hash >> 13;
+    hash *= prime3;
+    hash ^= hash >> 16;
+    return hash;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file        CompressedFile.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Streaming LZ4 compression of the file data. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @remarks     The data is stored in the LZ4 frame format with independent blocks, so the files written without the filter
+ *              can be decompressed on a PC with the standard `lz4` tool. The delta filter is announced in a skippable frame
+ *              preceding the LZ4 frame, the `lz4` tool ignores it and outputs the filtered data.
+ *              On a PC build the toolkit with `USE_POSIX` and read the files with `CompressedFile` to undo the filter too.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "File.hpp"
+
+namespace FS
+{
+
+/// @brief Compresses the data written to an open `File` and decompresses the data read from it, a block at a time.
+/// @remarks The writes are collected in the block buffer, a full block is compressed and written to the file
+///          with one file system call. A block that doesn't compress is stored as it is.
+///          Each block is compressed independently, with the match finder reset, so the blocks can be decoded one by one.
+///          The delta filter replaces each byte with its difference to the byte `deltaStride` bytes before it,
+///          so the slowly changing samples of that size become runs of small values that compress well.
+///          The frame is ended with `close()`, `finish()` or when the object is discarded.
+///          A file can contain many frames one after another, like a log appended to, the reads go through all of them.
+///          Declare the compressed file after the file, so it is discarded (and finished) first.
+class CompressedFile
+{
+
+public:
+
+    static constexpr size_t maxBlockSize = 65536; ///< The maximal block size, the LZ4 frame block size limit used.
+
+    CompressedFile(const CompressedFile&) = delete; // This type should not be copied.
+    CompressedFile(CompressedFile&&) = delete; // This type should not be moved.
+
+    /// @brief Creates a compressed access to the file using the caller provided storage.
+    /// @param file Open file reference.
+    /// @param buffer Buffer pointer, `2 * blockSize` bytes.
+    /// @param blockSize Block size in bytes, up to `maxBlockSize`. The reads need the block size of the writer or larger.
+    /// @param table Match finder table pointer, `1 << WTK_FS_LZ4_HASH_BITS` entries. Not used for reading.
+    /// @param deltaStride The sample size in bytes for the delta filter when writing, up to 8, 0 to disable the filter.
+    CompressedFile(File& file, uint8_t* buffer, size_t blockSize, uint16_t* table, uint8_t deltaStride = 0);
+
+    /// @brief Compresses the pending data and ends the frame.
+    ~CompressedFile();
+
+    /// @returns True if the underlying file is open.
+    inline bool isOpen() const { return m_file.isOpen(); }
+
+    /// @returns True if the underlying file is open.
+    inline operator bool() const { return m_file.isOpen(); }
+
+    /// @returns The number of bytes written or read before compression.
+    inline uint64_t size() const { return m_size; }
+
+    /// @returns The number of compressed bytes written or read, including the frame headers.
+    inline uint64_t compressedSize() const { return m_compressedSize; }
+
+    /// @brief Collects the data in the block buffer, compresses and writes the block when full.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes to write.
+    /// @returns True if written successfully. False otherwise.
+    bool write(const void* buffer, size_t size);
+
+    /// @brief Writes a structure or a primitive type.
+    /// @tparam T  The type of the structure, can also be a primitive type.
+    /// @param data The data reference.
+    /// @returns True if written successfully. False otherwise.
+    template<typename T> bool write(T& data) { return write(&data, sizeof(data)); }
+
+    /// @brief Compresses and writes the pending data as a shorter block, so it reaches the media now.
+    /// @returns True if written successfully or nothing to write. False otherwise.
+    bool flush();
+
+    /// @brief Compresses the pending data and ends the frame. The next write starts a new frame.
+    /// @returns True if written successfully or nothing to write. False otherwise.
+    bool finish();
+
+    /// @brief Reads the decompressed data, decompressing the next block when the current one is used up.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes requested.
+    /// @returns Number of bytes read, less than requested at the end of the data or before invalid data,
+    ///          0 at the end of the file, or an empty value if the data is invalid.
+    ReadResult read(void* buffer, size_t size);
+
+    /// @brief Reads a structure or a primitive type.
+    /// @tparam T The type of the structure, can also be a primitive type.
+    /// @param data The data reference.
+    /// @returns True if read successfully, false if not read at all or less than required length read.
+    template<typename T> bool read(T& data)
+    {
+        constexpr size_t size = sizeof(data);
+        ReadResult result = read(&data, size);
+        return result.has_value() && result.value() == size;
+    }
+
+    /// @brief Ends the frame and closes the file.
+    /// @returns True if the pending data was written successfully.
+    bool close();
+
+    /// @brief Compresses a block.
+    /// @param source Source data pointer.
+    /// @param size Source data size, up to `maxBlockSize`.
+    /// @param target Target buffer pointer.
+    /// @param capacity Target buffer size.
+    /// @param table Match finder table pointer, `1 << WTK_FS_LZ4_HASH_BITS` entries.
+    /// @returns The compressed size, 0 if it doesn't fit in the target buffer.
+    static size_t compress(const uint8_t* source, size_t size, uint8_t* target, size_t capacity, uint16_t* table);
+
+    /// @brief Decompresses a block.
+    /// @param source Compressed data pointer.
+    /// @param size Compressed data size.
+    /// @param target Target buffer pointer.
+    /// @param capacity Target buffer size.
+    /// @returns The decompressed size or an empty value if the data is invalid or doesn't fit in the target buffer.
+    static ReadResult decompress(const uint8_t* source, size_t size, uint8_t* target, size_t capacity);
+
+private:
+
+    /// @brief Stream state.
+    enum State : uint8_t
+    {
+        idle,       // No frame started.
+        writing,    // The frame header is written, the buffer contains data to compress.
+        reading,    // The buffer contains decompressed data.
+        ended,      // The end of the data was read.
+        failed      // A write failed or invalid data was read.
+    };
+
+    /// @brief Writes the filter frame if used and the LZ4 frame header.
+    /// @returns True if written.
+    bool writeHeader();
+
+    /// @brief Filters, compresses and writes the buffered data as a block.
+    /// @returns True if written or nothing to write.
+    bool writeBlock();
+
+    /// @brief Reads the frame headers and the next block, decompresses it and reverses the filter.
+    /// @returns True if a block was read, false at the end of the data or on error, `m_state` tells which.
+    bool readBlock();
+
+    /// @brief Reads the frame headers, skipping the unknown skippable frames.
+    /// @returns True if an LZ4 frame started, false at the end of the data or on error, `m_state` tells which.
+    bool readHeader();
+
+    /// @brief Applies the delta filter or reverses it on the data in the block buffer.
+    /// @param isReversed True to reverse the filter.
+    void filter(bool isReversed);
+
+    /// @brief Reads exactly the specified number of bytes from the file.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes.
+    /// @returns True if read.
+    bool readExactly(void* buffer, size_t size);
+
+    /// @brief Computes the XXH32 hash of a short data, used for the frame header checksum.
+    /// @param data Data pointer.
+    /// @param size Data size, less than 16 bytes.
+    /// @returns Hash value.
+    static uint32_t xxh32(const uint8_t* data, size_t size);
+
+    File& m_file;               // Underlying file reference.
+    uint8_t* m_block;           // Decompressed block buffer.
+    uint8_t* m_packed;          // Compressed block buffer.
+    size_t m_blockSize;         // Block size.
+    uint16_t* m_table;          // Match finder table.
+    size_t m_position;          // Reading: the offset of the first unread byte.
+    size_t m_length;            // The number of valid bytes in the block buffer.
+    uint64_t m_size;            // The number of bytes before compression.
+    uint64_t m_compressedSize;  // The number of compressed bytes.
+    uint8_t m_delta[8];         // The last bytes of the stream before filtering, for the delta filter.
+    uint8_t m_deltaStride;      // Writing: the delta filter sample size, 0 if not used.
+    uint8_t m_frameStride;      // The delta filter sample size of the current frame.
+    uint8_t m_deltaIndex;       // The index of the next byte in `m_delta`.
+    uint8_t m_frameFlags;       // Reading: the LZ4 frame flags.
+    State m_state;              // Stream state.
+
+};
+
+/// @brief Compresses the data written to an open `File` using the internal buffers.
+/// @tparam TBlockSize Block size in bytes, up to `CompressedFile::maxBlockSize`.
+template<size_t TBlockSize = WTK_FS_LZ4_BLOCK>
+class CompressedFileT final : public CompressedFile
+{
+
+    static_assert(TBlockSize >= 256 && TBlockSize <= maxBlockSize, "The block size must be from 256 bytes to 64KB.");
+
+public:
+
+    /// @brief Creates a compressed access to the file.
+    /// @param file Open file reference.
+    /// @param deltaStride The sample size in bytes for the delta filter when writing, up to 8, 0 to disable the filter.
+    CompressedFileT(File& file, uint8_t deltaStride = 0) : CompressedFile(file, m_storage, TBlockSize, m_table, deltaStride) { }
+
+private:
+
+    alignas(32) uint8_t m_storage[2 * TBlockSize];          // Block buffers storage.
+    uint16_t m_table[1u << WTK_FS_LZ4_HASH_BITS];           // Match finder table storage.
+
+};
+
+}
@@ -0,0 +1,242 @@
+/**
+ * @file        Copy.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Pipelined file and directory tree copy. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Copy.hpp"
+#include "API.hpp"
+#include "Directory.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(USE_FILEX)
+#include "fx_api.h"
+#elif defined(USE_FATFS)
+#include "fatfs.h"
+#endif
+
+bool FS::CopyEngine::copy(const FileSystem* sourceFs, const char* sourcePath, const FileSystem* targetFs, const char* targetPath,
+    ProgressCallback callback, bool verify)
+{
+    if (!sourceFs || !sourcePath || !targetFs || !targetPath) return false;
+    Path source(sourceFs, "%s", sourcePath);
+    Path target(targetFs, "%s", targetPath);
+    if (!source.isValid() || !target.isValid()) return false;
+    begin(sourceFs, targetFs, callback, verify);
+    return end(copyFile(source, target));
+}
+
+bool FS::CopyEngine::copyTree(const FileSystem* sourceFs, const char* sourcePath, const FileSystem* targetFs, const char* targetPath,
+    ProgressCallback callback, bool verify)
+{
+    if (!sourceFs || !sourcePath || !targetFs || !targetPath) return false;
+    if (!sourceFs->isMounted() || !targetFs->isMounted()) return false;
+    Path source(sourceFs, "%s", sourcePath); // An empty path is the root directory.
+    Path target(targetFs, "%s", targetPath);
+    if (source.length() < source.fileSystem()->rootLength() || target.length() < target.fileSystem()->rootLength()) return false;
+    begin(sourceFs, targetFs, callback, verify);
+    m_source = source;
+    m_targetPath = target;
+    return end(copyDirectory());
+}
+
+void FS::CopyEngine::begin(const FileSystem* sourceFs, const FileSystem* targetFs, ProgressCallback callback, bool verify)
+{
+    m_lock.acquire();
+    size_t cluster = std::max(clusterSize(sourceFs), clusterSize(targetFs));
+    m_blockSize = poolSize / maxBuffers;
+    if (m_blockSize >= cluster) m_blockSize -= m_blockSize % cluster; // Whole clusters, no partial cluster writes.
+    else m_blockSize = cluster < poolSize / 2 ? cluster : poolSize / 2; // Large clusters, fewer buffers.
+    m_blocks = std::min(poolSize / m_blockSize, maxBuffers);
+    m_callback = callback;
+    m_verify = verify;
+    m_progress = {};
+    if (!m_thread.active())
+    {
+        m_events.wait(filledEvent | freedEvent, OS::noClear, 0); // Creates the event group before the writer thread starts.
+        m_thread.start(writerThread, "FS::CopyEngine", OS::ThreadPriority::normal);
+    }
+}
+
+bool FS::CopyEngine::end(bool result)
+{
+    m_callback = nullptr;
+    m_lock.release();
+    return result;
+}
+
+size_t FS::CopyEngine::clusterSize(const FileSystem* fs)
+{
+    const AdapterTypes::Media* media = fs->media();
+    size_t size = 0;
+#if defined(USE_FILEX)
+    if (media && media->fx_media_id == FX_MEDIA_ID) size = media->fx_media_bytes_per_sector * media->fx_media_sectors_per_cluster;
+#elif defined(USE_FATFS)
+#if _MAX_SS != _MIN_SS
+    if (media) size = media->csize * media->ssize;
+#else
+    if (media) size = media->csize * _MAX_SS;
+#endif
+#else
+    (void)media;
+#endif
+    return size ? size : 512;
+}
+
+bool FS::CopyEngine::copyFile(Path& source, Path& target)
+{
+    bool isCopied = false;
+    {
+        File input(source, FileMode::read);
+        File::FileOffset size = 0;
+        if (!input || !input.size(size)) return false;
+        File output(target, FileMode::write | FileMode::createAlways);
+        if (!output) return false;
+        if (size) output.preallocate(size); // Contiguous clusters if the media can, the file is truncated on close anyway.
+        m_progress.file = source.relativePath();
+        m_progress.fileSize = size;
+        m_progress.fileCopied = 0;
+        m_target = &output;
+        isCopied = transfer(input);
+        m_target = nullptr;
+    } // Both files are closed here.
+    if (!isCopied)
+    {
+        fileDelete(target.fileSystem(), target.relativePath()); // Incomplete.
+        return false;
+    }
+    ++m_progress.files;
+    return !m_verify || verifyFile(source, target);
+}
+
+bool FS::CopyEngine::copyDirectory()
+{
+    const FileSystem* targetFs = m_targetPath.fileSystem();
+    bool isCopied = true;
+    size_t depth = 0;
+    m_levels[0] = { 0, static_cast<uint16_t>(m_source.length()), static_cast<uint16_t>(m_targetPath.length()) };
+    for (;;)
+    {
+        Level& level = m_levels[depth];
+        if (!level.position && *m_targetPath.relativePath() && !directoryExists(targetFs, m_targetPath.relativePath()) &&
+            !directoryCreate(targetFs, m_targetPath.relativePath())) return false;
+        bool isEntered = false;
+        {
+            Directory directory(m_source);
+            if (!directory) return false;
+            for (uint32_t i = 0; i < level.position; ++i) if (!directory.next()) return false; // Already copied.
+            while (const DirectoryItem* item = directory.next())
+            {
+                ++level.position;
+                const char* name = item->name;
+                if (name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2]))) continue; // Self and parent entries.
+                m_source.join(name);
+                m_targetPath.join(name);
+                if (!m_source.isValid() || !m_targetPath.isValid()) return false;
+                if (item->isDirectory() && depth + 1 < maxDepth)
+                {
+                    m_levels[depth + 1] = { 0, static_cast<uint16_t>(m_source.length()), static_cast<uint16_t>(m_targetPath.length()) };
+                    isEntered = true;
+                    break; // The directory is closed before the subdirectory is opened.
+                }
+                if (item->isDirectory())
+                {
+                    isCopied = false;
+                    ++m_progress.skipped;
+                    m_progress.file = m_source.relativePath();
+                    if (m_callback && !m_callback(m_progress)) return false; // Canceled.
+                }
+                else if (!copyFile(m_source, m_targetPath)) return false;
+                m_source.truncate(level.sourceLength);
+                m_targetPath.truncate(level.targetLength);
+            }
+            if (!isEntered && !directory.isComplete()) return false;
+        }
+        if (isEntered) ++depth;
+        else if (!depth) return isCopied;
+        else
+        {
+            --depth;
+            m_source.truncate(m_levels[depth].sourceLength);
+            m_targetPath.truncate(m_levels[depth].targetLength);
+        }
+    }
+}
+
+bool FS::CopyEngine::transfer(File& source)
+{
+    m_filled = 0;
+    m_written = 0;
+    m_isFailed = false;
+    uint64_t bytesRead = 0;
+    bool isEnd = false;
+    bool isRead = true;
+    while (!isEnd && !m_isFailed)
+    {
+        while (m_filled - m_written >= m_blocks && !m_isFailed) m_events.wait(freedEvent);
+        if (m_isFailed) break;
+        const size_t index = m_filled % m_blocks;
+        ReadResult result = source.read(buffer(index), m_blockSize);
+        if (!(isRead = result.has_value())) break;
+        const size_t length = result.value();
+        bytesRead += length;
+        isEnd = length < m_blockSize || bytesRead >= m_progress.fileSize; // No extra read of 0 bytes after the last full block.
+        if (length)
+        {
+            m_lengths[index] = length;
+            ++m_filled;
+            m_events.signal(filledEvent);
+        }
+        if (!m_callback || isEnd) continue; // The last progress is reported when all is written.
+        const uint64_t copied = std::min(static_cast<uint64_t>(m_written) * m_blockSize, m_progress.fileSize);
+        m_progress.totalCopied += copied - m_progress.fileCopied;
+        m_progress.fileCopied = copied;
+        if (!(isRead = m_callback(m_progress))) break; // Canceled.
+    }
+    while (m_written != m_filled) m_events.wait(freedEvent); // The buffers must not be reused until written.
+    const uint64_t copied = std::min(static_cast<uint64_t>(m_written) * m_blockSize, m_progress.fileSize);
+    m_progress.totalCopied += copied - m_progress.fileCopied;
+    m_progress.fileCopied = copied;
+    const bool isCopied = isRead && isEnd && !m_isFailed;
+    if (isCopied && m_callback) m_callback(m_progress); // The file is complete, too late to cancel.
+    return isCopied;
+}
+
+bool FS::CopyEngine::verifyFile(Path& source, Path& target)
+{
+    File a(source, FileMode::read);
+    File b(target, FileMode::read);
+    if (!a || !b) return false;
+    const size_t half = poolSize / 2;
+    uint8_t* bufferA = m_pool;
+    uint8_t* bufferB = m_pool + half;
+    for (;;)
+    {
+        ReadResult resultA = a.read(bufferA, half);
+        ReadResult resultB = b.read(bufferB, half);
+        if (!resultA.has_value() || !resultB.has_value() || resultA.value() != resultB.value()) return false;
+        if (std::memcmp(bufferA, bufferB, resultA.value()) != 0) return false;
+        if (resultA.value() < half) return true;
+    }
+}
+
+void FS::CopyEngine::writerThread(OS::ThreadArg arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        while (m_written != m_filled)
+        {
+            const size_t index = m_written % m_blocks;
+            if (!m_isFailed && !m_target->write(buffer(index), m_lengths[index])) m_isFailed = true;
+            ++m_written; // After a failure the buffers are just released, so the reader can finish.
+            m_events.signal(freedEvent);
+        }
+        m_events.wait(filledEvent);
+    }
+}
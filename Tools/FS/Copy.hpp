@@ -0,0 +1,191 @@
+/**
+ * @file        Copy.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Pipelined file and directory tree copy. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @remarks     The calling thread reads the source into a ring of buffers while the writer thread writes
+ *              the previously read buffers to the target, so both media are busy at the same time.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "target.h"
+#include "File.hpp"
+#include "StaticClass.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/Thread.hpp"
+
+namespace FS
+{
+
+/// @brief Copies files between the file systems, overlapping the source reads with the target writes.
+/// @remarks Runs synchronously, call it from a thread that can block for a long time. One copy runs at a time,
+///          other callers wait. The buffer size is matched to the larger cluster size of both media.
+class CopyEngine final
+{
+
+    STATIC(CopyEngine)
+
+public:
+
+    static constexpr size_t poolSize = WTK_FS_COPY_BUFFER;      ///< The total size of the buffers in bytes.
+    static constexpr size_t maxBuffers = WTK_FS_COPY_BUFFERS;   ///< The maximal number of buffers in the ring.
+    static constexpr size_t maxDepth = WTK_FS_COPY_DEPTH;       ///< The maximal directory depth of a tree copy.
+
+    static_assert(maxBuffers >= 2, "At least 2 buffers are needed to overlap the reads and writes.");
+
+    /// @brief Copy progress.
+    struct Progress final
+    {
+        const char* file;       ///< The source path of the file being copied, relative to the file system root.
+        uint64_t fileSize;      ///< The size of the file being copied in bytes.
+        uint64_t fileCopied;    ///< The number of bytes of the file written to the target.
+        uint64_t totalCopied;   ///< The number of bytes written to the target since the copy started.
+        uint32_t files;         ///< The number of files completed.
+        uint32_t skipped;       ///< The number of directories not copied, deeper than `maxDepth`.
+    };
+
+    /// @brief Receives the copy progress after each buffer read, once more when the file is completely written,
+    ///        and with `file` set to the skipped directory path when a directory deeper than `maxDepth` is skipped.
+    /// @returns True to continue, false to cancel the copy.
+    using ProgressCallback = bool(*)(const Progress& progress);
+
+    /// @brief Copies a file. The target file is replaced if it exists.
+    /// @param sourceFs Source file system pointer.
+    /// @param sourcePath Source file path relative to the file system root.
+    /// @param targetFs Target file system pointer.
+    /// @param targetPath Target file path relative to the file system root.
+    /// @param callback Optional progress callback.
+    /// @param verify True to read both files back and compare them when copied.
+    /// @returns True if copied (and verified), false if failed or canceled. An incomplete target file is deleted.
+    static bool copy(const FileSystem* sourceFs, const char* sourcePath, const FileSystem* targetFs, const char* targetPath,
+        ProgressCallback callback = nullptr, bool verify = false);
+
+    /// @brief Copies a directory with its files and subdirectories, up to `maxDepth` levels deep.
+    /// @param sourceFs Source file system pointer.
+    /// @param sourcePath Source directory path relative to the file system root.
+    /// @param targetFs Target file system pointer.
+    /// @param targetPath Target directory path relative to the file system root, created if needed.
+    /// @param callback Optional progress callback.
+    /// @param verify True to read each file pair back and compare them when copied.
+    /// @returns True if all files were copied (and verified). False if failed, canceled or a directory was skipped.
+    /// @remarks The tree is walked without recursion, with one `Directory` open at a time, so the stack use doesn't grow
+    ///          with the depth. The directories deeper than `maxDepth` are skipped, counted and reported to the callback,
+    ///          the rest of the tree is copied. A failed or canceled copy leaves the files completed so far.
+    static bool copyTree(const FileSystem* sourceFs, const char* sourcePath, const FileSystem* targetFs, const char* targetPath,
+        ProgressCallback callback = nullptr, bool verify = false);
+
+private:
+
+    static constexpr OS::EventFlags filledEvent = 1; // The event flag set when a buffer was read.
+    static constexpr OS::EventFlags freedEvent = 2;  // The event flag set when a buffer was written.
+
+    /// @brief Starts a copy: takes the lock, sizes the buffer ring and resets the progress.
+    /// @param sourceFs Source file system pointer.
+    /// @param targetFs Target file system pointer.
+    /// @param callback Progress callback.
+    /// @param verify True to verify the files.
+    static void begin(const FileSystem* sourceFs, const FileSystem* targetFs, ProgressCallback callback, bool verify);
+
+    /// @brief Ends a copy, releases the lock.
+    /// @param result Copy result.
+    /// @returns The result.
+    static bool end(bool result);
+
+    /// @param fs File system pointer.
+    /// @returns The cluster size of the file system media in bytes.
+    static size_t clusterSize(const FileSystem* fs);
+
+    /// @brief Copies one file through the buffer ring.
+    /// @param source Source file path.
+    /// @param target Target file path.
+    /// @returns True if copied (and verified).
+    static bool copyFile(Path& source, Path& target);
+
+    /// @brief Copies the `m_source` directory tree to `m_targetPath`. Enters a subdirectory with its parent closed,
+    ///        then reopens the parent and skips the entries already copied.
+    /// @returns True if copied, false if failed, canceled or a directory was skipped.
+    static bool copyDirectory();
+
+    /// @brief Reads the source file into the buffers and passes them to the writer thread until the end of the file.
+    /// @param source Source file reference.
+    /// @returns True if the whole file was written.
+    static bool transfer(File& source);
+
+    /// @brief Reads both files back and compares them.
+    /// @param source Source file path.
+    /// @param target Target file path.
+    /// @returns True if the files are identical.
+    static bool verifyFile(Path& source, Path& target);
+
+    /// @brief Writer thread loop.
+    /// @param arg Not used.
+    static void writerThread(OS::ThreadArg arg);
+
+    /// @brief Tree copy directory level.
+    struct Level final
+    {
+        uint32_t position;      // The number of directory entries read.
+        uint16_t sourceLength;  // The source directory path length.
+        uint16_t targetLength;  // The target directory path length.
+    };
+
+    /// @param index Buffer index.
+    /// @returns Buffer pointer.
+    static inline uint8_t* buffer(size_t index) { return m_pool + index * m_blockSize; }
+
+    alignas(32) static inline uint8_t m_pool[poolSize] = {};  // Buffer ring memory.
+    static inline size_t m_blockSize = {};                    // The size of one buffer in bytes.
+    static inline size_t m_blocks = {};                       // The number of buffers in the ring.
+    static inline size_t m_lengths[maxBuffers] = {};          // The number of bytes read into each buffer.
+    static inline std::atomic<uint32_t> m_filled = {};        // The number of buffers read for the current file.
+    static inline std::atomic<uint32_t> m_written = {};       // The number of buffers written for the current file.
+    static inline std::atomic<bool> m_isFailed = {};          // Set when a target write failed.
+    static inline File* m_target = {};                        // Target file, valid while a file is copied.
+    static inline ProgressCallback m_callback = {};           // Progress callback.
+    static inline Progress m_progress = {};                   // Current progress.
+    static inline bool m_verify = {};                         // Set when the files are verified.
+    static inline Path m_source = {};                         // Tree copy: the current source path.
+    static inline Path m_targetPath = {};                     // Tree copy: the current target path.
+    static inline Level m_levels[maxDepth] = {};              // Tree copy: the directory levels entered.
+    static inline OS::ThreadT<WTK_FS_COPY_STACK> m_thread = {}; // Writer thread.
+    static inline OS::EventGroup m_events = {};               // Buffer ring events.
+    static inline OS::Mutex m_lock = {};                      // Allows one copy at a time.
+
+};
+
+/// @brief Copies a file with `CopyEngine`, overlapping the source reads with the target writes.
+/// @param sourceFs Source file system pointer.
+/// @param sourcePath Source file path relative to the file system root.
+/// @param targetFs Target file system pointer.
+/// @param targetPath Target file path relative to the file system root.
+/// @param callback Optional progress callback.
+/// @param verify True to read both files back and compare them when copied.
+/// @returns True if copied (and verified), false if failed or canceled.
+inline bool copy(const FileSystem* sourceFs, const char* sourcePath, const FileSystem* targetFs, const char* targetPath,
+    CopyEngine::ProgressCallback callback = nullptr, bool verify = false)
+{
+    return CopyEngine::copy(sourceFs, sourcePath, targetFs, targetPath, callback, verify);
+}
+
+/// @brief Copies a directory tree with `CopyEngine`.
+/// @param sourceFs Source file system pointer.
+/// @param sourcePath Source directory path relative to the file system root.
+/// @param targetFs Target file system pointer.
+/// @param targetPath Target directory path relative to the file system root, created if needed.
+/// @param callback Optional progress callback.
+/// @param verify True to read each file pair back and compare them when copied.
+/// @returns True if all files were copied (and verified), false if failed or canceled.
+inline bool copyTree(const FileSystem* sourceFs, const char* sourcePath, const FileSystem* targetFs, const char* targetPath,
+    CopyEngine::ProgressCallback callback = nullptr, bool verify = false)
+{
+    return CopyEngine::copyTree(sourceFs, sourcePath, targetFs, targetPath, callback, verify);
+}
+
+}
@@ -0,0 +1,133 @@
+/**
+ * @file        Directory.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RAII directory enumeration API. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Directory.hpp"
+#include "Adapter.hpp"
+#include <cctype>
+#include <cstdarg>
+
+USE_ADAPTER
+
+FS::Directory::Directory(const char* absolutePath, ...) : Path(), m_handle(), m_items(), m_count(0), m_index(0),
+    m_pattern(), m_required(0), m_excluded(DirectoryItem::volume), m_status(OK), m_isOpen(false), m_isEnd(false)
+{
+    va_list args;
+    va_start(args, absolutePath);
+    initializeWithVariadicArgs(absolutePath, args);
+    va_end(args);
+    open();
+}
+
+FS::Directory::Directory(const Path& path) : Path(path), m_handle(), m_items(), m_count(0), m_index(0),
+    m_pattern(), m_required(0), m_excluded(DirectoryItem::volume), m_status(OK), m_isOpen(false), m_isEnd(false)
+{
+    open();
+}
+
+FS::Directory::Directory(const FileSystem* fs, const char* relativePath, ...) : Path(), m_handle(), m_items(), m_count(0), m_index(0),
+    m_pattern(), m_required(0), m_excluded(DirectoryItem::volume), m_status(OK), m_isOpen(false), m_isEnd(false)
+{
+    va_list args;
+    va_start(args, relativePath);
+    initializeWithVariadicArgs(fs, relativePath, args);
+    va_end(args);
+    open();
+}
+
+FS::Directory::~Directory() { close(); }
+
+void FS::Directory::filter(const char* pattern, uint8_t required, uint8_t excluded)
+{
+    m_pattern = pattern && *pattern ? pattern : nullptr;
+    m_required = required;
+    m_excluded = excluded;
+}
+
+const FS::DirectoryItem* FS::Directory::next()
+{
+    while (m_isOpen)
+    {
+        if (m_index >= m_count)
+        {
+            if (m_isEnd) return nullptr;
+            fetch();
+            if (!m_count) return nullptr;
+        }
+        const DirectoryItem& item = m_items[m_index++];
+        if (matches(item)) return &item;
+    }
+    return nullptr;
+}
+
+bool FS::Directory::rewind()
+{
+    close();
+    open();
+    return m_isOpen;
+}
+
+bool FS::Directory::match(const char* pattern, const char* name)
+{
+    const char* starPattern = nullptr; // The pattern position after the last `*`.
+    const char* starName = nullptr; // The name position the last `*` matched up to.
+    while (*name)
+    {
+        if (*pattern == '*')
+        {
+            starPattern = ++pattern;
+            starName = name;
+        }
+        else if (*pattern == '?' || std::tolower(static_cast<unsigned char>(*pattern)) == std::tolower(static_cast<unsigned char>(*name)))
+        {
+            ++pattern;
+            ++name;
+        }
+        else if (starPattern) // Let the last `*` match one more character.
+        {
+            pattern = starPattern;
+            name = ++starName;
+        }
+        else return false;
+    }
+    while (*pattern == '*') ++pattern;
+    return !*pattern;
+}
+
+void FS::Directory::open()
+{
+    if (m_isOpen || !m_fileSystem || !m_fileSystem->media()) return; // The root directory has an empty relative path.
+    m_status = adapter.directoryOpen(*m_fileSystem->media(), m_handle, relativePath());
+    m_isOpen = m_status == OK;
+    m_count = m_index = 0;
+    m_isEnd = false;
+}
+
+void FS::Directory::close()
+{
+    if (!m_isOpen) return;
+    adapter.directoryClose(m_handle);
+    m_handle = {};
+    m_isOpen = false;
+}
+
+void FS::Directory::fetch()
+{
+    m_index = 0;
+    m_status = adapter.directoryRead(m_handle, m_items, WTK_FS_DIRECTORY_BATCH, m_count);
+    if (m_status != OK) m_count = 0;
+    m_isEnd = m_status != OK || m_count < WTK_FS_DIRECTORY_BATCH;
+}
+
+bool FS::Directory::matches(const DirectoryItem& item) const
+{
+    if (item.name[0] == '.' && (!item.name[1] || (item.name[1] == '.' && !item.name[2]))) return false;
+    if ((item.attributes & m_required) != m_required || (item.attributes & m_excluded)) return false;
+    return !m_pattern || match(m_pattern, item.name);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file        Directory.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RAII directory enumeration API. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "Path.hpp"
+
+namespace FS
+{
+
+/// @brief Provides RAII directory enumeration API.
+/// @remarks The entries are fetched from the file system `WTK_FS_DIRECTORY_BATCH` at a time into the internal buffer,
+///          with their size, attributes and modification time, in one pass over the directory.
+///          Each entry holds a full length name, so the batch is kept small, the instance is usually a stack variable.
+struct Directory final : public Path
+{
+
+    static_assert(WTK_FS_DIRECTORY_BATCH >= 1, "At least one entry must be fetched at a time.");
+
+    /// @brief Iterates over the matching directory entries with the range based `for` loop.
+    struct Iterator final
+    {
+        /// @brief Creates the iterator pointing at the current entry.
+        /// @param directory Directory pointer, `nullptr` for the end iterator.
+        Iterator(Directory* directory) : m_directory(directory), m_item(directory ? directory->next() : nullptr) { }
+
+        /// @returns The current entry reference.
+        inline const DirectoryItem& operator*() const { return *m_item; }
+
+        /// @brief Moves to the next matching entry.
+        inline Iterator& operator++() { m_item = m_directory->next(); return *this; }
+
+        /// @returns True if the iterators point at different entries.
+        inline bool operator!=(const Iterator& other) const { return m_item != other.m_item; }
+
+    private:
+        Directory* m_directory;         // Directory pointer.
+        const DirectoryItem* m_item;    // Current entry, `nullptr` at the end.
+    };
+
+    Directory(const Directory&) = delete; // This type should not be copied.
+    Directory(Directory&&) = delete; // This type should not be moved.
+
+    /// @brief Opens a directory.
+    /// @param absolutePath Absolute path to the directory.
+    /// @param ... Variadic arguments used to format the path string.
+    Directory(const char* absolutePath, ...);
+
+    /// @brief Opens a directory.
+    /// @param path Path reference, the file system root path opens the root directory.
+    Directory(const Path& path);
+
+    /// @brief Opens a directory.
+    /// @param fs File system pointer.
+    /// @param relativePath Relative path to the directory, empty for the root directory.
+    /// @param ... Variadic arguments used to format the path string.
+    Directory(const FileSystem* fs, const char* relativePath, ...);
+
+    /// @brief The directory is closed when this instance is discarded.
+    ~Directory();
+
+    /// @returns True if the directory is actually successfully open.
+    inline bool isOpen() const { return m_isOpen; }
+
+    /// @returns True if the directory is actually successfully open.
+    inline operator bool() const { return m_isOpen; }
+
+    /// @returns True if all entries were enumerated without an error.
+    inline bool isComplete() const { return m_isEnd && m_status == OK; }
+
+    /// @brief Sets the entry filter. The `.` and `..` entries are always skipped.
+    /// @param pattern Name pattern with `*` and `?` wildcards, case insensitive. `nullptr` matches all names.
+    ///        The pattern string must stay valid during the enumeration.
+    /// @param required Attributes the entry must have, `DirectoryItem::Attributes` flags. Default: none.
+    /// @param excluded Attributes the entry must not have. Default: `volume`.
+    void filter(const char* pattern, uint8_t required = 0, uint8_t excluded = DirectoryItem::volume);
+
+    /// @returns The next matching entry pointer, valid until the next call, or `nullptr` at the end of the directory.
+    const DirectoryItem* next();
+
+    /// @brief Restarts the enumeration from the first entry.
+    /// @returns True if the directory was reopened.
+    bool rewind();
+
+    /// @returns An iterator pointing at the next matching entry.
+    inline Iterator begin() { return Iterator(this); }
+
+    /// @returns The end iterator.
+    inline Iterator end() { return Iterator(nullptr); }
+
+    /// @brief Tests if the name matches the pattern.
+    /// @param pattern Name pattern with `*` and `?` wildcards, case insensitive.
+    /// @param name Entry name.
+    /// @returns True if the name matches.
+    static bool match(const char* pattern, const char* name);
+
+private:
+
+    /// @brief Opens the directory if the file system is mounted.
+    void open();
+
+    /// @brief Closes the directory if it was opened.
+    void close();
+
+    /// @brief Reads the next batch of entries.
+    void fetch();
+
+    /// @returns True if the entry passes the filter.
+    bool matches(const DirectoryItem& item) const;
+
+    DirectoryHandle m_handle;                           // Directory handle.
+    DirectoryItem m_items[WTK_FS_DIRECTORY_BATCH];      // Entries fetched.
+    size_t m_count;                                     // The number of entries fetched.
+    size_t m_index;                                     // The index of the next entry to return.
+    const char* m_pattern;                              // Name pattern, `nullptr` matches all names.
+    uint8_t m_required;                                 // Required attributes.
+    uint8_t m_excluded;                                 // Excluded attributes.
+    Status m_status;                                    // The last operation status.
+    bool m_isOpen;                                      // Directory is open.
+    bool m_isEnd;                                       // The last entry was fetched.
+
+};
+
+}
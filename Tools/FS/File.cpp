@@ -10,6 +10,7 @@
 
 #include "File.hpp"
 #include "Adapter.hpp"
+#include "StatCache.hpp"
 #include <cstdarg>
 
 USE_ADAPTER
@@ -17,11 +18,12 @@ USE_ADAPTER
 void FS::File::open()
 {
     if (!isValid() || isOpen()) return; // Invalid path or media, obviously file not found.
-    m_status = adapter.fileOpen(*m_fileSystem->media(), m_file, m_relativePath, m_mode);
+    m_status = adapter.fileOpen(*m_fileSystem->media(), m_file, relativePath(), m_mode);
     m_isOpen = m_status == OK;
+    if (isWritable()) StatCache::invalidate(m_fileSystem, relativePath()); // The file could have been created or truncated.
 }
 
-FS::File::File(const char *absolutePath, FileMode pMode, ...) : Path(), m_mode(pMode), m_isOpen(false)
+FS::File::File(const char *absolutePath, FileMode pMode, ...) : Path(), m_mode(pMode), m_end(0), m_isOpen(false), m_isPreallocated(false)
 {
     va_list args;
     va_start(args, pMode);
@@ -30,7 +32,7 @@ FS::File::File(const char *absolutePath, FileMode pMode, ...) : Path(), m_mode(p
     open();
 }
 
-FS::File::File(Path &path, FileMode pMode, ...) : Path(), m_mode(pMode), m_isOpen(false)
+FS::File::File(Path &path, FileMode pMode, ...) : Path(), m_mode(pMode), m_end(0), m_isOpen(false), m_isPreallocated(false)
 {
     va_list args;
     va_start(args, pMode);
@@ -40,7 +42,7 @@ FS::File::File(Path &path, FileMode pMode, ...) : Path(), m_mode(pMode), m_isOpe
 }
 
 FS::File::File(const FileSystem *fs, const char *relativePath, FileMode pMode, ...)
-    : Path(), m_mode(pMode), m_isOpen(false)
+    : Path(), m_mode(pMode), m_end(0), m_isOpen(false), m_isPreallocated(false)
 {
     va_list args;
     va_start(args, pMode);
@@ -57,6 +59,12 @@ bool FS::File::seek(FileOffset offset)
     return adapter.fileSeek(m_file, offset) == OK;
 }
 
+bool FS::File::tell(FileOffset& offset)
+{
+    if (!m_isOpen) return false;
+    return adapter.fileTell(m_file, offset) == OK;
+}
+
 FS::ReadResult FS::File::read(void *buffer, size_t size)
 {
     if (!m_isOpen || !buffer || !size) return ReadResult();
@@ -67,13 +75,47 @@ FS::ReadResult FS::File::read(void *buffer, size_t size)
 bool FS::File::write(const void *buffer, size_t size)
 {
     if (!m_isOpen || !buffer || !size) return false;
-    return adapter.fileWrite(m_file, buffer, size) == OK;
+    if (adapter.fileWrite(m_file, buffer, size) != OK) return false;
+    StatCache::invalidate(m_fileSystem, relativePath()); // The size could have changed.
+    FileOffset offset;
+    if (m_isPreallocated && adapter.fileTell(m_file, offset) == OK && offset > m_end) m_end = offset;
+    return true;
+}
+
+bool FS::File::flush()
+{
+    if (!m_isOpen) return false;
+    const bool isFlushed = adapter.fileFlush(m_file) == OK;
+    if (isWritable()) StatCache::invalidate(m_fileSystem, relativePath()); // The size and time are updated on the media.
+    return isFlushed;
+}
+
+bool FS::File::size(FileOffset& size)
+{
+    if (!m_isOpen) return false;
+    return adapter.fileSize(m_file, size) == OK;
+}
+
+FS::File::FileOffset FS::File::preallocate(FileOffset size)
+{
+    if (!m_isOpen || !size || m_isPreallocated) return 0;
+    FileOffset length;
+    if (adapter.fileSize(m_file, length) != OK) return 0;
+    FileOffset allocated;
+    if (adapter.fileAllocate(m_file, size, allocated) != OK || !allocated) return 0;
+    StatCache::invalidate(m_fileSystem, relativePath()); // The file is extended until closed.
+    m_end = length;
+    m_isPreallocated = true;
+    return allocated;
 }
 
 void FS::File::close()
 {
     if (!m_isOpen) return;
+    if (m_isPreallocated) adapter.fileTruncate(m_file, m_end); // Releases the unused part of the extent.
+    m_isPreallocated = false;
     m_status = adapter.fileClose(m_file);
+    if (isWritable()) StatCache::invalidate(m_fileSystem, relativePath()); // The size and time are updated on close.
     m_isOpen = m_status != OK;  // If close failed, assume the file is still open.
     if (!m_isOpen) m_file = {}; // Clear the file handle just in case.
 }
@@ -19,6 +19,8 @@ namespace FS
 struct File final : public Path
 {
 
+    using FileOffset = AdapterTypes::FileOffset; // File offset number type.
+
     File(const File&) = delete; // This type should not be copied.
     File(File&&) = delete; // This type should not be moved.
 
@@ -55,6 +57,11 @@ struct File final : public Path
     /// @returns True if done. False otherwise.
     bool seek(FileOffset offset);
 
+    /// @brief Gets the read / write pointer offset in the file.
+    /// @param offset File offset variable reference.
+    /// @returns True if done. False otherwise.
+    bool tell(FileOffset& offset);
+
     /// @brief Reads the data from the file.
     /// @param buffer Buffer pointer.
     /// @param size Number of bytes requested.
@@ -84,6 +91,28 @@ struct File final : public Path
     /// @returns True if written successfully. False otherwise.
     template<typename T> bool write(T& data) { return write(&data, sizeof(data)); }
 
+    /// @brief Writes the data cached by the file system for the file to the media, so it survives a reset.
+    /// @remarks Costs at least one media write, FileX flushes all cached sectors of the media.
+    /// @returns True if done. False otherwise.
+    bool flush();
+
+    /// @brief Gets the file length.
+    /// @param size File length variable reference.
+    /// @returns True if done. False otherwise.
+    bool size(FileOffset& size);
+
+    /// @brief Pre-allocates a contiguous extent at the end of the file for high rate recording.
+    ///        Appends fill the extent without cluster allocation and FAT updates.
+    ///        The file is truncated to the length actually written and the unused space released when the file is closed.
+    /// @remarks FileX allocates the largest contiguous block available if the requested size is not available.
+    ///          FATFS requires an empty file and the `f_expand()` function enabled.
+    /// @param size The number of bytes to reserve.
+    /// @returns The number of bytes reserved, 0 if failed.
+    FileOffset preallocate(FileOffset size);
+
+    /// @returns True if the file has a pre-allocated extent released when it is closed.
+    inline bool isPreallocated() const { return m_isPreallocated; }
+
     /// @brief Closes the file if it was opened.
     void close();
 
@@ -92,10 +121,15 @@ private:
     /// @brief Opens or creates the file on the media if the path is valid and the media is mounted in the `FileSystemTable`.
     void open();
 
+    /// @returns True if the file mode allows creating or modifying the file.
+    inline bool isWritable() const { return m_mode & (FileMode::write | FileMode::createNew | FileMode::createAlways | FileMode::openAlways); }
+
     FileControlBlock m_file;  // File handle.
     FileMode m_mode;    // File mode.
     Status m_status;    // File status.
+    FileOffset m_end;   // The length written to the pre-allocated file.
     bool m_isOpen;      // File is open.
+    bool m_isPreallocated; // The file has a pre-allocated extent.
 
 };
 
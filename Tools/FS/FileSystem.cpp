@@ -21,7 +21,7 @@ const FS::FileSystem* FS::FileSystemTable::add(const char* root, Media* media)
     if (existingEntry) return existingEntry->m_media == media ? existingEntry : nullptr;
     auto entry = getFree();
     if (!entry) return nullptr;
-    entry->m_root = root;
+    entry->setRoot(root);
     entry->m_media = media;
     auto configuration = MediaServices::getConfiguration(root);
     if (!configuration) return nullptr;
@@ -31,15 +31,21 @@ const FS::FileSystem* FS::FileSystemTable::add(const char* root, Media* media)
 
 const FS::FileSystem* FS::FileSystemTable::find(const char *path)
 {
+    if (!path) return nullptr;
     for (const auto& e : entries)
     {
-        if (!e.m_root) continue;
-        auto rootLength = std::strlen(e.m_root);
-        if (std::strncmp(path, e.m_root, rootLength) == 0) return &e;
+        if (!e.m_root || e.m_root[0] != path[0]) continue; // The first character rejects most of the entries.
+        if (std::strncmp(path, e.m_root, e.m_rootLength) == 0) return &e;
     }
     return nullptr;
 }
 
+const FS::FileSystem* FS::FileSystemTable::find(RootId rootId)
+{
+    for (const auto& e : entries) if (e.m_root && e.m_rootId == rootId) return &e;
+    return nullptr;
+}
+
 const FS::FileSystem* FS::FileSystemTable::find(Media *media)
 {
     for (const auto& e : entries) if (e.m_media == media) return &e;
@@ -13,28 +13,51 @@
 #include "AdapterTypes.hpp"
 #include "Media.hpp"
 #include "StaticClass.hpp"
+#include <cstring>
 
 namespace FS
 {
 
+/// @brief File system root path identifier, the root path hash.
+using RootId = uint32_t;
+
 /// @brief Contains file system metadata.
 struct FileSystem final : public AdapterTypes
 {
 
     /// @brief Creates an empty file system target definition.
-    FileSystem() : m_root(), m_media() { }
+    FileSystem() : m_root(), m_media(), m_type(MediaType::NONE), m_rootLength(), m_rootId() { }
 
     /// @brief Creates a file system target definition.
     /// @param root The root path of the file system.
     /// @param media Media handle reference.
-    FileSystem(const char* root, Media& media) : m_root(root), m_media(&media) { }
+    FileSystem(const char* root, Media& media) : m_root(), m_media(&media), m_type(MediaType::NONE), m_rootLength(), m_rootId()
+    {
+        setRoot(root);
+    }
 
     /// @brief Clears the file system target definition making it empty for reuse.
-    inline void clear(void) { m_root = nullptr; m_media = nullptr; m_type = MediaType::NONE; }
+    inline void clear(void) { m_root = nullptr; m_media = nullptr; m_type = MediaType::NONE; m_rootLength = 0; m_rootId = 0; }
 
     /// @returns The file system root path.
     inline const char* root() const { return m_root; }
 
+    /// @returns The file system root path length.
+    inline size_t rootLength() const { return m_rootLength; }
+
+    /// @returns The file system root path identifier.
+    inline RootId rootId() const { return m_rootId; }
+
+    /// @brief Calculates the root path identifier (FNV-1a hash). Can be evaluated at compile time.
+    /// @param root The root path.
+    /// @returns The root path identifier.
+    static constexpr RootId id(const char* root)
+    {
+        RootId hash = 2166136261u;
+        while (root && *root) hash = (hash ^ static_cast<uint8_t>(*root++)) * 16777619u;
+        return hash;
+    }
+
     /// @returns The file system media structure pointer.
     inline Media* media() const { return m_media; }
 
@@ -45,9 +68,20 @@ private:
 friend class FileSystemTable;
 friend class MediaServices;
 
-    const char* m_root; // File system target root path pointer.
-    Media* m_media;     // File system media handle pointer.
-    MediaType m_type;   // Media type enumeration member.
+    /// @brief Sets the root path, its length and identifier.
+    /// @param root The root path of the file system.
+    inline void setRoot(const char* root)
+    {
+        m_root = root;
+        m_rootLength = root ? std::strlen(root) : 0;
+        m_rootId = id(root);
+    }
+
+    const char* m_root;     // File system target root path pointer.
+    Media* m_media;         // File system media handle pointer.
+    MediaType m_type;       // Media type enumeration member.
+    size_t m_rootLength;    // Root path length.
+    RootId m_rootId;        // Root path identifier.
 
 };
 
@@ -72,6 +106,11 @@ public:
     /// @returns File system target pointer if found, `nullptr` otherwise.
     static const FileSystem* find(const char* path);
 
+    /// @brief Finds the file system target by its root path identifier.
+    /// @param rootId Root path identifier, see `FileSystem::id()`.
+    /// @returns File system target pointer if found, `nullptr` otherwise.
+    static const FileSystem* find(RootId rootId);
+
     /// @brief Finds the file system target with specified media structure pointer.
     /// @param media Media structure pointer.
     /// @returns File system target pointer if found, `nullptr` otherwise.
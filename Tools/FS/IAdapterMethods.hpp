@@ -18,6 +18,7 @@
 #define FS_MOUNT_CONFLICT           ((FS::AdapterTypes::Status)0xfff1)  // A file system already mounted for a different media.
 #define FS_MOUNT_ROOT_NOT_FOUND     ((FS::AdapterTypes::Status)0xfff2)  // Cannot find the file system root in the file system table.
 #define FS_MOUNT_MEDIA_NOT_FOUND    ((FS::AdapterTypes::Status)0xfff3)  // Cannot find the media in the file system table.
+#define FS_NOT_FOUND                ((FS::AdapterTypes::Status)0xfff4)  // The file or directory does not exist.
 #define FS_NEGATIVE                 ((FS::AdapterTypes::Status)0xfffe)  // The file system backend refuses to perform the action.
 #define FS_ERROR                    ((FS::AdapterTypes::Status)0xffff)  // Unspecifed error occurred.
 
@@ -37,6 +38,13 @@ public:
     /// @returns Status.
     virtual Status find(Media& media, const char* path, DirectoryEntry& entry) const = 0;
 
+    /// @brief Gets the file or directory attributes, size and timestamps in one lookup.
+    /// @param media Media structure reference.
+    /// @param path File or directory path.
+    /// @param stat Metadata structure reference.
+    /// @returns Status, `FS_NOT_FOUND` if the entry doesn't exist.
+    virtual Status stat(Media& media, const char* path, FileStat& stat) const = 0;
+
     /// @brief Gets the file or directory creation time.
     /// @param media Media structure reference.
     /// @param path File or directory path.
@@ -77,12 +85,18 @@ public:
     /// @returns Status.
     virtual Status fileSeek(FileControlBlock& file, FileOffset offset) const = 0;
 
+    /// @brief Gets the file pointer offset.
+    /// @param file File handle reference.
+    /// @param offset Position within the file variable reference.
+    /// @returns Status.
+    virtual Status fileTell(FileControlBlock& file, FileOffset& offset) const = 0;
+
     /// @brief Reads data from a file.
     /// @param file File handle reference.
     /// @param buffer Buffer pointer.
     /// @param size Buffer size.
     /// @param bytesRead Number of bytes read variable reference.
-    /// @returns Status.
+    /// @returns Status. `OK` with less bytes read than requested at the end of the file, 0 bytes when already at the end.
     virtual Status fileRead(FileControlBlock& file, void* buffer, size_t size, size_t& bytesRead) const = 0;
 
     /// @brief Writes data to a file.
@@ -92,6 +106,30 @@ public:
     /// @returns Status.
     virtual Status fileWrite(FileControlBlock& file, const void* buffer, size_t size) const = 0;
 
+    /// @brief Gets the file length.
+    /// @param file File handle reference.
+    /// @param size File length variable reference.
+    /// @returns Status.
+    virtual Status fileSize(FileControlBlock& file, FileOffset& size) const = 0;
+
+    /// @brief Allocates contiguous clusters at the end of a file. The file length may change, `fileTruncate()` sets the final length.
+    /// @param file File handle reference.
+    /// @param size Number of bytes to allocate.
+    /// @param allocated Number of bytes actually allocated variable reference.
+    /// @returns Status.
+    virtual Status fileAllocate(FileControlBlock& file, FileOffset size, FileOffset& allocated) const = 0;
+
+    /// @brief Truncates a file to the specified length, releasing the clusters beyond it.
+    /// @param file File handle reference.
+    /// @param size New file length.
+    /// @returns Status.
+    virtual Status fileTruncate(FileControlBlock& file, FileOffset size) const = 0;
+
+    /// @brief Writes the cached data, the directory entry and the FAT entries of an open file to the physical media.
+    /// @param file File handle reference.
+    /// @returns Status.
+    virtual Status fileFlush(FileControlBlock& file) const = 0;
+
     /// @brief Closes a file.
     /// @param file File handle reference.
     /// @returns Status.
@@ -135,6 +173,31 @@ public:
     /// @returns Status.
     virtual Status directoryDelete(Media& media, const char* path) const = 0;
 
+    /// @brief Opens a directory for the enumeration.
+    /// @param media Media structure reference.
+    /// @param directory Directory handle reference.
+    /// @param path Directory path relative to the file system root, empty for the root directory.
+    /// @returns Status.
+    virtual Status directoryOpen(Media& media, DirectoryHandle& directory, const char* path) const = 0;
+
+    /// @brief Reads the next batch of directory entries.
+    /// @param directory Open directory handle reference.
+    /// @param items Target items array.
+    /// @param capacity The number of items the array can hold.
+    /// @param count The number of items read variable reference. Less than `capacity` when there are no more entries.
+    /// @returns Status.
+    virtual Status directoryRead(DirectoryHandle& directory, DirectoryItem* items, size_t capacity, size_t& count) const = 0;
+
+    /// @brief Closes a directory.
+    /// @param directory Open directory handle reference.
+    /// @returns Status.
+    virtual Status directoryClose(DirectoryHandle& directory) const = 0;
+
+    /// @brief Writes the media sectors and FAT entries cached by the file system to the physical media.
+    /// @param media Media structure reference.
+    /// @returns Status.
+    virtual Status mediaFlush(Media& media) const = 0;
+
 };
 
 }
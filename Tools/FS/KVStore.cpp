@@ -0,0 +1,334 @@
+/**
+ * @file        KVStore.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Log-structured key-value store. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "KVStore.hpp"
+#include "API.hpp"
+#include "Directory.hpp"
+#include <cstdlib>
+#include <cstring>
+
+FS::KVStore::KVStore(Slot* slots, size_t capacity)
+    : m_slots(slots), m_capacity(capacity), m_count(0), m_fs(nullptr), m_directory(),
+      m_first(0), m_last(0), m_lastSize(0), m_compactOffset(0), m_lock() { }
+
+FS::KVStore::~KVStore()
+{
+    close();
+}
+
+bool FS::KVStore::open(const FileSystem* fs, const char* directory)
+{
+    if (!fs || !directory || !m_slots || !m_capacity) return false;
+    m_lock.acquire();
+    m_fs = nullptr;
+    std::memset(m_slots, 0, m_capacity * sizeof(Slot));
+    m_count = 0;
+    std::strncpy(m_directory, directory, Path::maxLength);
+    m_directory[Path::maxLength] = 0;
+    if (!directoryExists(fs, "%s", m_directory) && !directoryCreate(fs, "%s", m_directory))
+    {
+        m_lock.release();
+        return false;
+    }
+    bool isFound = false;
+    Directory segments(fs, "%s", m_directory);
+    segments.filter("*.kv", 0, DirectoryItem::volume | DirectoryItem::directory);
+    for (const DirectoryItem& item : segments)
+    {
+        char* end;
+        const uint32_t segment = std::strtoul(item.name, &end, 16);
+        if (end == item.name || *end != '.') continue;
+        if (!isFound || segment < m_first) m_first = segment;
+        if (!isFound || segment > m_last) m_last = segment;
+        isFound = true;
+    }
+    if (!segments.isComplete())
+    {
+        m_lock.release();
+        return false;
+    }
+    m_fs = fs;
+    m_lastSize = 0;
+    m_compactOffset = 0;
+    if (!isFound) m_first = m_last = 0;
+    bool isOpen = true;
+    bool isDamaged = false;
+    for (uint32_t segment = m_first; isFound && isOpen; ++segment)
+    {
+        isOpen = replay(segment, m_lastSize, isDamaged);
+        if (segment == m_last) break;
+    }
+    if (isDamaged) // The torn tail of the current segment would hide the records appended after it.
+    {
+        ++m_last;
+        m_lastSize = 0;
+    }
+    if (!isOpen) m_fs = nullptr;
+    m_lock.release();
+    return isOpen;
+}
+
+void FS::KVStore::close()
+{
+    m_lock.acquire();
+    m_fs = nullptr;
+    if (m_slots) std::memset(m_slots, 0, m_capacity * sizeof(Slot));
+    m_count = 0;
+    m_lock.release();
+}
+
+bool FS::KVStore::contains(const char* key)
+{
+    if (!key) return false;
+    m_lock.acquire();
+    const bool isFound = isOpen() && find(key, std::strlen(key));
+    m_lock.release();
+    return isFound;
+}
+
+FS::ReadResult FS::KVStore::get(const char* key, void* buffer, size_t size)
+{
+    if (!key || !buffer) return {};
+    ReadResult result;
+    m_lock.acquire();
+    const Slot* slot = isOpen() ? find(key, std::strlen(key)) : nullptr;
+    if (slot && slot->size <= size)
+    {
+        Record record;
+        Path path = segmentPath(slot->segment);
+        File file(path, FileMode::read);
+        if (file && file.seek(slot->offset) && readRecord(file, record) && record.header.valueSize == slot->size &&
+            !slot->key[record.header.keyLength] && std::memcmp(record.data, slot->key, record.header.keyLength) == 0)
+        {
+            std::memcpy(buffer, record.data + record.header.keyLength, slot->size);
+            result = slot->size;
+        }
+    }
+    m_lock.release();
+    return result;
+}
+
+bool FS::KVStore::put(const char* key, const void* value, size_t size)
+{
+    if (!key || (!value && size) || size > maxValueSize) return false;
+    const size_t length = std::strlen(key);
+    if (!length || length > maxKeyLength) return false;
+    Record record;
+    record.header.keyLength = static_cast<uint8_t>(length);
+    record.header.reserved = 0;
+    record.header.valueSize = static_cast<uint16_t>(size);
+    std::memcpy(record.data, key, length);
+    if (size) std::memcpy(record.data + length, value, size);
+    m_lock.acquire();
+    Slot* free = nullptr;
+    const bool isUpdated = isOpen() && (find(key, length, &free) || free) && update(record);
+    m_lock.release();
+    return isUpdated;
+}
+
+bool FS::KVStore::remove(const char* key)
+{
+    if (!key) return false;
+    const size_t length = std::strlen(key);
+    if (!length || length > maxKeyLength) return true;
+    m_lock.acquire();
+    bool isRemoved = isOpen();
+    if (isRemoved && find(key, length))
+    {
+        Record record;
+        record.header.keyLength = static_cast<uint8_t>(length);
+        record.header.reserved = 0;
+        record.header.valueSize = removedSize;
+        std::memcpy(record.data, key, length);
+        isRemoved = update(record);
+    }
+    m_lock.release();
+    return isRemoved;
+}
+
+bool FS::KVStore::compact(size_t records)
+{
+    m_lock.acquire();
+    bool isDone = isOpen();
+    const uint32_t last = m_last; // The records moved to the new segments are not moved again.
+    for (; isDone && records && m_first < last; --records) isDone = compactOldest(1);
+    m_lock.release();
+    return isDone;
+}
+
+bool FS::KVStore::readRecord(File& file, Record& record)
+{
+    if (!file.read(record.header) || !record.header.keyLength || record.header.keyLength > maxKeyLength) return false;
+    if (record.header.valueSize != removedSize && record.header.valueSize > maxValueSize) return false;
+    const size_t size = record.size() - sizeof(Header);
+    ReadResult result = file.read(record.data, size);
+    return result.has_value() && result.value() == size && crc(record) == record.header.crc;
+}
+
+uint32_t FS::KVStore::crc(const Record& record)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&record.header) + sizeof(record.header.crc);
+    const size_t headerSize = sizeof(Header) - sizeof(record.header.crc);
+    const size_t size = record.size() - sizeof(Header);
+    uint32_t value = 0xffffffffu;
+    for (size_t i = 0; i < headerSize + size; ++i)
+    {
+        value ^= i < headerSize ? data[i] : record.data[i - headerSize];
+        for (int bit = 0; bit < 8; ++bit) value = (value >> 1) ^ (0xedb88320u & (0u - (value & 1)));
+    }
+    return ~value;
+}
+
+uint32_t FS::KVStore::hash(const char* key, size_t length)
+{
+    uint32_t value = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        value ^= static_cast<uint8_t>(key[i]);
+        value *= 16777619u;
+    }
+    return value;
+}
+
+FS::KVStore::Slot* FS::KVStore::find(const char* key, size_t length, Slot** free)
+{
+    if (free) *free = nullptr;
+    if (length > maxKeyLength) return nullptr;
+    const size_t mask = m_capacity - 1;
+    size_t index = hash(key, length) & mask;
+    for (size_t probe = 0; probe < m_capacity; ++probe, index = (index + 1) & mask)
+    {
+        Slot& slot = m_slots[index];
+        if (slot.state == empty)
+        {
+            if (free && !*free) *free = &slot;
+            return nullptr;
+        }
+        if (slot.state == removed)
+        {
+            if (free && !*free) *free = &slot;
+            continue;
+        }
+        if (std::strncmp(slot.key, key, length) == 0 && !slot.key[length]) return &slot;
+    }
+    return nullptr;
+}
+
+bool FS::KVStore::index(const Record& record, uint32_t segment, uint32_t offset)
+{
+    const char* key = reinterpret_cast<const char*>(record.data);
+    const size_t length = record.header.keyLength;
+    Slot* free;
+    Slot* slot = find(key, length, &free);
+    if (record.header.valueSize == removedSize)
+    {
+        if (slot)
+        {
+            slot->state = removed;
+            --m_count;
+        }
+        return true;
+    }
+    if (!slot)
+    {
+        if (!free) return false;
+        slot = free;
+        std::memcpy(slot->key, key, length);
+        slot->key[length] = 0;
+        slot->state = used;
+        ++m_count;
+    }
+    slot->segment = segment;
+    slot->offset = offset;
+    slot->size = record.header.valueSize;
+    return true;
+}
+
+bool FS::KVStore::append(const Record& record, uint32_t& segment, uint32_t& offset)
+{
+    const size_t size = record.size();
+    if (m_lastSize && m_lastSize + size > segmentSize)
+    {
+        ++m_last;
+        m_lastSize = 0;
+    }
+    Path path = segmentPath(m_last);
+    File file(path, m_lastSize ? FileMode::write | FileMode::openAppend : FileMode::write | FileMode::createAlways);
+    if (!file || !file.write(&record, size) || !file.flush()) return false; // On the media before the caller gets the result.
+    segment = m_last;
+    offset = m_lastSize;
+    m_lastSize += size;
+    return true;
+}
+
+bool FS::KVStore::update(Record& record)
+{
+    record.header.crc = crc(record);
+    uint32_t segment, offset;
+    if (!append(record, segment, offset) || !index(record, segment, offset)) return false;
+    return m_last - m_first < maxSegments || compactOldest(compactRecords);
+}
+
+bool FS::KVStore::replay(uint32_t segment, uint32_t& end, bool& isDamaged)
+{
+    end = 0;
+    isDamaged = false;
+    Path path = segmentPath(segment);
+    File file(path, FileMode::read);
+    if (!file) return true; // A missing segment has nothing to replay.
+    File::FileOffset size = 0;
+    if (!file.size(size)) size = 0;
+    Record record;
+    while (end < size)
+    {
+        if (!readRecord(file, record))
+        {
+            isDamaged = true;
+            return true;
+        }
+        if (!index(record, segment, end)) return false;
+        end += record.size();
+    }
+    return true;
+}
+
+bool FS::KVStore::compactOldest(size_t records)
+{
+    while (records-- && m_first < m_last)
+    {
+        bool isEnd;
+        Record record;
+        Path path = segmentPath(m_first);
+        {
+            File file(path, FileMode::read);
+            isEnd = !file || !file.seek(m_compactOffset) || !readRecord(file, record);
+        } // Closed before the record is appended.
+        if (isEnd) // Also the damaged tail, the records behind it were never indexed.
+        {
+            if (fileExists(m_fs, "%s", path.relativePath()) && !fileDelete(m_fs, "%s", path.relativePath())) return false;
+            ++m_first;
+            m_compactOffset = 0;
+            continue;
+        }
+        const uint32_t offset = m_compactOffset;
+        m_compactOffset += record.size();
+        if (record.header.valueSize == removedSize) continue; // The older records of the key are already gone.
+        const Slot* slot = find(reinterpret_cast<const char*>(record.data), record.header.keyLength);
+        if (!slot || slot->segment != m_first || slot->offset != offset) continue; // Replaced.
+        uint32_t segment, targetOffset;
+        if (!append(record, segment, targetOffset) || !index(record, segment, targetOffset)) return false;
+    }
+    return true;
+}
+
+FS::Path FS::KVStore::segmentPath(uint32_t segment) const
+{
+    return Path(m_fs, "%s/%08lX.kv", m_directory, static_cast<unsigned long>(segment));
+}
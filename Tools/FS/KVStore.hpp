@@ -0,0 +1,265 @@
+/**
+ * @file        KVStore.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Log-structured key-value store. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @remarks     The records are appended to the segment files in the store directory, named with the hexadecimal segment
+ *              sequence number and the `.kv` extension. Each record is a header with the CRC-32 and the lengths,
+ *              followed by the key and the value. A removed key is a record without a value.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "File.hpp"
+#include "OS/Mutex.hpp"
+
+namespace FS
+{
+
+/// @brief Stores small values by the text keys, updating a value costs one record appended to the current segment file.
+/// @remarks The index of the keys to the record locations is kept in the caller provided slot table,
+///          so a lookup is one hash probe and a read is one file read.
+///          Each `put()` and `remove()` flushes the record with the segment file entry to the media before it returns,
+///          so the record survives a reset. Closing the file is not enough, FileX keeps the written sectors in its cache.
+///          When there are more than `maxSegments` segment files, each update also moves a few current records
+///          from the oldest segment to the current one and deletes the oldest segment when all its records are moved.
+///          `open()` rebuilds the index from the segment files, a damaged record ends the segment it is found in.
+///          Keep the current records well below `maxSegments * segmentSize` bytes, or the updates keep moving them around.
+///          Thread safe.
+class KVStore
+{
+
+public:
+
+    static constexpr size_t maxKeyLength = WTK_FS_KV_KEY;     ///< The maximal key length in characters.
+    static constexpr size_t maxValueSize = WTK_FS_KV_VALUE;   ///< The maximal value size in bytes.
+    static constexpr size_t segmentSize = WTK_FS_KV_SEGMENT;  ///< The segment file size that starts a new segment.
+    static constexpr size_t maxSegments = WTK_FS_KV_SEGMENTS; ///< The number of segment files that starts the compaction.
+    static constexpr size_t compactRecords = 4;               ///< The number of records compacted with each update.
+
+    static_assert(maxKeyLength > 0 && maxKeyLength < 256, "The key length must fit in 8 bits.");
+    static_assert(maxValueSize < 0xffff, "The value size must fit in 16 bits, 0xffff marks a removed key.");
+    static_assert(maxSegments >= 2, "At least 2 segments are needed for the compaction.");
+
+    /// @brief Index slot.
+    struct Slot final
+    {
+        char key[maxKeyLength + 1]; ///< Zero terminated key.
+        uint32_t segment;           ///< Segment sequence number.
+        uint32_t offset;            ///< Record offset in the segment file.
+        uint16_t size;              ///< Value size in bytes.
+        uint8_t state;              ///< Slot state.
+    };
+
+    KVStore(const KVStore&) = delete; // This type should not be copied.
+    KVStore(KVStore&&) = delete; // This type should not be moved.
+
+    /// @brief Creates a closed store using the caller provided index storage.
+    /// @param slots Index slots pointer.
+    /// @param capacity The number of slots, a power of 2. The maximal number of keys stored.
+    KVStore(Slot* slots, size_t capacity);
+
+    /// @brief Closes the store.
+    ~KVStore();
+
+    /// @brief Opens the store, creating the directory if needed, and rebuilds the index from the segment files.
+    /// @param fs File system pointer.
+    /// @param directory Store directory path relative to the file system root.
+    /// @returns True if open. False if the directory can't be created or read, or there are more keys than slots.
+    bool open(const FileSystem* fs, const char* directory);
+
+    /// @brief Closes the store, the index is cleared.
+    void close();
+
+    /// @returns True if the store is open.
+    inline bool isOpen() const { return m_fs != nullptr; }
+
+    /// @returns True if the store is open.
+    inline operator bool() const { return m_fs != nullptr; }
+
+    /// @returns The number of keys stored.
+    inline size_t count() const { return m_count; }
+
+    /// @returns The number of index slots.
+    inline size_t capacity() const { return m_capacity; }
+
+    /// @param key Key.
+    /// @returns True if the key is stored.
+    bool contains(const char* key);
+
+    /// @brief Reads the value.
+    /// @param key Key.
+    /// @param buffer Value buffer pointer.
+    /// @param size Buffer size in bytes.
+    /// @returns The value size, or an empty value if the key is not stored, the buffer is too small,
+    ///          the read failed or the record is damaged.
+    ReadResult get(const char* key, void* buffer, size_t size);
+
+    /// @brief Reads a structure or a primitive type value.
+    /// @tparam T The type of the structure, can also be a primitive type.
+    /// @param key Key.
+    /// @param data The data reference.
+    /// @returns True if read and the stored size matches the type size.
+    template<typename T> bool get(const char* key, T& data)
+    {
+        ReadResult result = get(key, &data, sizeof(data));
+        return result.has_value() && result.value() == sizeof(data);
+    }
+
+    /// @brief Stores the value, replacing the previous one.
+    /// @param key Key, up to `maxKeyLength` characters.
+    /// @param value Value pointer.
+    /// @param size Value size in bytes, up to `maxValueSize`.
+    /// @returns True if stored. False if the key or the value is too long, the index is full or the write failed.
+    bool put(const char* key, const void* value, size_t size);
+
+    /// @brief Stores a structure or a primitive type value.
+    /// @tparam T The type of the structure, can also be a primitive type.
+    /// @param key Key.
+    /// @param data The data reference.
+    /// @returns True if stored.
+    template<typename T> bool put(const char* key, const T& data) { return put(key, &data, sizeof(data)); }
+
+    /// @brief Removes the key.
+    /// @param key Key.
+    /// @returns True if removed or not stored. False if the write failed.
+    bool remove(const char* key);
+
+    /// @brief Moves the current records from the oldest segments to the current one, deleting the emptied segments.
+    ///        Can be called when the device is idle, so the updates don't have to do it.
+    /// @param records The maximal number of records to process. Default: all segments but the current one.
+    /// @returns True if done, false if a file operation failed.
+    bool compact(size_t records = SIZE_MAX);
+
+    /// @returns The number of segment files.
+    inline size_t segments() const { return isOpen() ? m_last - m_first + 1 : 0; }
+
+private:
+
+    /// @brief Index slot state.
+    enum SlotState : uint8_t
+    {
+        empty,      // The slot was never used, ends the probe sequence.
+        used,       // The slot holds a key.
+        removed     // The slot held a key, the probe sequence continues.
+    };
+
+    /// @brief Record header.
+    struct Header final
+    {
+        uint32_t crc;           // CRC-32 of the rest of the header, the key and the value.
+        uint8_t keyLength;      // Key length.
+        uint8_t reserved;       // Zero.
+        uint16_t valueSize;     // Value size, `removedSize` for a removed key.
+    };
+
+    static constexpr uint16_t removedSize = 0xffff;                                 // The value size of a removed key.
+
+    /// @brief Record buffer.
+    struct Record final
+    {
+        Header header;                                  // Record header.
+        uint8_t data[maxKeyLength + maxValueSize];      // The key followed by the value.
+
+        /// @returns The record size in bytes.
+        inline size_t size() const
+        {
+            return sizeof(Header) + header.keyLength + (header.valueSize == removedSize ? 0 : header.valueSize);
+        }
+    };
+
+    /// @brief Reads a record.
+    /// @param file Segment file reference.
+    /// @param record Record buffer reference.
+    /// @returns True if a complete record with the valid CRC was read.
+    static bool readRecord(File& file, Record& record);
+
+    /// @param record Record reference.
+    /// @returns The CRC-32 of the record.
+    static uint32_t crc(const Record& record);
+
+    /// @param key Key.
+    /// @param length Key length.
+    /// @returns FNV-1a hash of the key.
+    static uint32_t hash(const char* key, size_t length);
+
+    /// @brief Finds the slot of the key.
+    /// @param key Key.
+    /// @param length Key length.
+    /// @param free Set to the first slot the key can be inserted to if not found, `nullptr` if the index is full.
+    /// @returns Key slot pointer or `nullptr` if the key is not stored.
+    Slot* find(const char* key, size_t length, Slot** free = nullptr);
+
+    /// @brief Updates the index with a record.
+    /// @param record Record reference.
+    /// @param segment Segment sequence number.
+    /// @param offset Record offset.
+    /// @returns True if updated, false if the index is full.
+    bool index(const Record& record, uint32_t segment, uint32_t offset);
+
+    /// @brief Appends a record to the current segment, starting a new segment when the current one is full.
+    /// @param record Record reference.
+    /// @param segment Set to the sequence number of the segment written.
+    /// @param offset Set to the record offset.
+    /// @returns True if written.
+    bool append(const Record& record, uint32_t& segment, uint32_t& offset);
+
+    /// @brief Writes a record and updates the index, then compacts the oldest segment if there are too many.
+    /// @param record Record reference.
+    /// @returns True if written.
+    bool update(Record& record);
+
+    /// @brief Replays the segment records into the index.
+    /// @param segment Segment sequence number.
+    /// @param end Set to the end offset of the last valid record.
+    /// @param isDamaged Set if the segment ends with a damaged record.
+    /// @returns True if replayed, false if the index is full.
+    bool replay(uint32_t segment, uint32_t& end, bool& isDamaged);
+
+    /// @brief Compacts the oldest segment.
+    /// @param records The maximal number of records to process.
+    /// @returns True if done, false if a file operation failed.
+    bool compactOldest(size_t records);
+
+    /// @param segment Segment sequence number.
+    /// @returns Segment file path.
+    Path segmentPath(uint32_t segment) const;
+
+    Slot* m_slots;                          // Index slots.
+    size_t m_capacity;                      // The number of slots.
+    size_t m_count;                         // The number of keys stored.
+    const FileSystem* m_fs;                 // File system pointer, `nullptr` when closed.
+    char m_directory[Path::maxLength + 1];  // Store directory path.
+    uint32_t m_first;                       // The oldest segment sequence number.
+    uint32_t m_last;                        // The current segment sequence number.
+    uint32_t m_lastSize;                    // The current segment size.
+    uint32_t m_compactOffset;               // The offset of the next record of the oldest segment to compact.
+    OS::Mutex m_lock;                       // Store access lock.
+
+};
+
+/// @brief Log-structured key-value store with the internal index storage.
+/// @tparam TCapacity The number of index slots, a power of 2. The maximal number of keys stored.
+template<size_t TCapacity>
+class KVStoreT final : public KVStore
+{
+
+    static_assert(TCapacity && !(TCapacity & (TCapacity - 1)), "The capacity must be a power of 2.");
+
+public:
+
+    /// @brief Creates a closed store.
+    KVStoreT() : KVStore(m_storage, TCapacity) { }
+
+private:
+
+    Slot m_storage[TCapacity]; // Index slots storage.
+
+};
+
+}
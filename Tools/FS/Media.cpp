@@ -10,8 +10,11 @@
  */
 
 #include "OS/AppThread.hpp"
+#include "Adapter.hpp"
 #include "Media.hpp"
 #include "FileSystem.hpp"
+#include "StatCache.hpp"
+#include "MediaCache.hpp"
 #include "Log.hpp"
 
 #if defined(USE_FILEX)
@@ -20,6 +23,10 @@
 #include "fatfs.h"
 #endif
 
+USE_ADAPTER
+
+static OS::TaskId flushTask = 0; // Periodic media flush task identifier.
+
 void FS::MediaServices::registerType(MediaType mediaType, const char* root, MediaDriver driver)
 {
     auto configuration = const_cast<MediaConfiguration*>(getConfiguration(mediaType));
@@ -84,12 +91,16 @@ bool FS::MediaServices::mount(Media &media, const char *root)
         return false;
     }
     else entry->m_media = &media; // Existing entry without media set.
+    StatCache::invalidate(entry); // The media could have been changed.
     bool status = false;
 #ifdef USE_FATFS
     status = f_mount(&media, root, 0) == FR_OK;
 #else
+    if (entry->m_type != MediaType::RAM) MediaCache::attach(media); // Without a large cache the media is still usable.
     status = true;
 #endif
+    if (WTK_FS_MEDIA_FLUSH && !flushTask)
+        flushTask = OS::AppThread::repeat(OS::msToTicks(WTK_FS_MEDIA_FLUSH), []() { flush(); }, OS::application, OS::skipMissed);
     notifyChanged();
     return status;
 }
@@ -98,6 +109,8 @@ bool FS::MediaServices::umount(const char *root)
 {
     auto entry = const_cast<FileSystem*>(FileSystemTable::find(root));
     if (!entry) return false; // FS root not found.
+    StatCache::invalidate(entry);
+    if (entry->media()) MediaCache::detach(*entry->media());
     entry->clear();
     notifyChanged();
     return true;
@@ -107,11 +120,25 @@ bool FS::MediaServices::umount(Media &media)
 {
     auto entry = const_cast<FileSystem*>(FileSystemTable::find(&media));
     if (!entry) return false; // Media not found.
+    StatCache::invalidate(entry);
+    MediaCache::detach(media);
     entry->clear();
     notifyChanged();
     return true;
 }
 
+bool FS::MediaServices::flush()
+{
+    bool isFlushed = true;
+    for (const auto& c : configurations)
+    {
+        if (c.type == MediaType::NONE || !c.root) continue;
+        auto fs = FileSystemTable::find(c.root);
+        if (fs && fs->isMounted() && adapter.mediaFlush(*fs->media()) != AdapterTypes::OK) isFlushed = false;
+    }
+    return isFlushed;
+}
+
 void FS::MediaServices::notifyChanged()
 {
     if (mountNotify) OS::AppThread::sync(mountNotify);
@@ -20,7 +20,7 @@ namespace FS
 
 /// @brief Physical media type.
 enum class MediaType {
-    NONE, eMMC, SD, USB
+    NONE, eMMC, SD, USB, RAM
 };
 
 /// @brief Media file system format.
@@ -47,7 +47,7 @@ STATIC(MediaServices)
 
 public:
 
-    static constexpr size_t maxConfigurations = 3;  // Maximal number of media type configurations.
+    static constexpr size_t maxConfigurations = 4;  // Maximal number of media type configurations.
 
     /// @brief Registers a media type.
     /// @param mediaType Media type.
@@ -88,6 +88,13 @@ public:
     /// @returns Status.
     static bool umount(Media& media);
 
+    /// @brief Writes the sectors and FAT entries cached by the file system of all mounted media to the physical media.
+    /// @remarks While any media is mounted it's called every `WTK_FS_MEDIA_FLUSH` milliseconds from the application thread,
+    ///          so the data written and the files closed survive a reset at most that time later.
+    ///          Call `FS::flush()` to commit a file system immediately.
+    /// @returns True if all mounted media were flushed successfully.
+    static bool flush(void);
+
     /// @brief Notifies the subscriber that the `FS::FileSystemTable` entries changed.
     static void notifyChanged(void);
 
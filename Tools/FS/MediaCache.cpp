@@ -0,0 +1,90 @@
+/**
+ * @file        MediaCache.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Large media sector caches and their statistics. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "MediaCache.hpp"
+#include "OS/CriticalSection.hpp"
+
+#if defined(USE_FILEX)
+
+#include "fx_api.h"
+
+alignas(32) uint8_t FS::MediaCache::m_buffers[slots][size] __attribute__((section(WTK_FS_MEDIA_CACHE_SECTION)));
+
+bool FS::MediaCache::attach(Media& media)
+{
+    if (media.fx_media_id != FX_MEDIA_ID) return false; // The media is not open.
+    if (media.fx_media_memory_size >= size) return true; // Already large enough.
+    uint8_t* buffer = nullptr;
+    {
+        OS::CriticalSection lock;
+        for (size_t i = 0; i < slots; ++i) if (!m_owners[i])
+        {
+            m_owners[i] = &media;
+            buffer = m_buffers[i];
+            break;
+        }
+    }
+    if (!buffer) return false; // All buffers in use.
+    // The media is reopened with the same driver, the driver data stored in the media structure must be preserved.
+    CHAR* name = media.fx_media_name;
+    VOID (*driver)(FX_MEDIA*) = media.fx_media_driver_entry;
+    VOID* info = media.fx_media_driver_info;
+    ALIGN_TYPE user = media.fx_media_reserved_for_user;
+    UCHAR* memory = media.fx_media_memory_buffer;
+    ULONG memorySize = media.fx_media_memory_size;
+    if (fx_media_close(&media) != FX_SUCCESS)
+    {
+        detach(media);
+        return false;
+    }
+    media.fx_media_reserved_for_user = user;
+    if (fx_media_open(&media, name, driver, info, buffer, size) == FX_SUCCESS) return true;
+    detach(media);
+    media.fx_media_reserved_for_user = user;
+    fx_media_open(&media, name, driver, info, memory, memorySize); // Restores the original cache.
+    return false;
+}
+
+void FS::MediaCache::detach(Media& media)
+{
+    OS::CriticalSection lock;
+    for (Media*& owner : m_owners) if (owner == &media) owner = nullptr;
+}
+
+bool FS::MediaCache::statistics(const Media& media, Statistics& statistics)
+{
+    if (media.fx_media_id != FX_MEDIA_ID) return false;
+    statistics.size = media.fx_media_sector_cache_size * media.fx_media_bytes_per_sector;
+#ifndef FX_MEDIA_STATISTICS_DISABLE
+    statistics.sectorHits = media.fx_media_logical_sector_cache_read_hits;
+    statistics.sectorMisses = media.fx_media_logical_sector_cache_read_misses;
+    statistics.fatHits = media.fx_media_fat_entry_cache_read_hits;
+    statistics.fatMisses = media.fx_media_fat_entry_cache_read_misses;
+    return true;
+#else
+    statistics.sectorHits = statistics.sectorMisses = statistics.fatHits = statistics.fatMisses = 0;
+    return false;
+#endif
+}
+
+#else
+
+bool FS::MediaCache::attach(Media& media) { (void)media; return false; }
+
+void FS::MediaCache::detach(Media& media) { (void)media; }
+
+bool FS::MediaCache::statistics(const Media& media, Statistics& statistics)
+{
+    (void)media;
+    statistics = {};
+    return false;
+}
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file        MediaCache.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Large media sector caches and their statistics. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "AdapterTypes.hpp"
+#include "StaticClass.hpp"
+
+namespace FS
+{
+
+/// @brief Provides large sector caches for the mounted media and reads their hit and miss counters.
+/// @remarks FileX caches as many sectors as fit the memory passed to `fx_media_open()`, up to `FX_MAX_SECTOR_CACHE`.
+///          The SD media is opened with a `WTK_FS_MEDIA_CACHE` buffer directly. Media opened by other middlewares,
+///          like the USB MSC host class, are reopened with one of the `WTK_FS_MEDIA_CACHE_SLOTS` buffers when mounted.
+///          All buffers are placed in the `WTK_FS_MEDIA_CACHE_SECTION` linker section.
+///          The cache is write-back, the written sectors stay in RAM until flushed, so a reset loses them.
+///          `MediaServices` flushes the mounted media every `WTK_FS_MEDIA_FLUSH` milliseconds, `FS::flush()` at once.
+class MediaCache final
+{
+
+    STATIC(MediaCache)
+
+public:
+
+    using Media = AdapterTypes::Media;
+
+    static constexpr size_t size = WTK_FS_MEDIA_CACHE;          ///< The size of one cache buffer in bytes.
+    static constexpr size_t slots = WTK_FS_MEDIA_CACHE_SLOTS;   ///< The number of cache buffers for the media reopened.
+
+    /// @brief Media cache statistics, counted since the media was opened.
+    struct Statistics final
+    {
+        uint32_t size;          ///< Cache size in bytes.
+        uint32_t sectorHits;    ///< Logical sector reads served from the cache.
+        uint32_t sectorMisses;  ///< Logical sector reads from the media.
+        uint32_t fatHits;       ///< FAT entry reads served from the FAT cache.
+        uint32_t fatMisses;     ///< FAT entry reads from the FAT sectors.
+    };
+
+    /// @brief Reopens the open media with a large cache buffer if its current cache is smaller.
+    /// @param media Media reference.
+    /// @returns True if the media uses a cache of at least `size` bytes.
+    static bool attach(Media& media);
+
+    /// @brief Releases the cache buffer attached to the media. The media should be already closed.
+    /// @param media Media reference.
+    static void detach(Media& media);
+
+    /// @brief Gets the media cache statistics.
+    /// @param media Media reference.
+    /// @param statistics Statistics target reference.
+    /// @returns True if the statistics are available.
+    static bool statistics(const Media& media, Statistics& statistics);
+
+private:
+
+#if defined(USE_FILEX)
+    static inline Media* m_owners[slots] = {};  // The media using the cache buffers.
+    static uint8_t m_buffers[slots][size];      // Cache buffers.
+#endif
+
+};
+
+}
@@ -13,54 +13,122 @@
 #include <cstring>
 #include <cstdio>
 
-FS::Path::Path() : m_fileSystem(), m_absolutePath(), m_relativePath() { }
+FS::Path::Path() : m_fileSystem(), m_rootLength(), m_length(), m_path() { }
 
-FS::Path::Path(va_list args, const char* path) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(const FileSystem* fs) : m_fileSystem(), m_rootLength(), m_length(), m_path()
+{
+    setRoot(fs);
+}
+
+FS::Path::Path(va_list args, const char* path) : m_fileSystem(), m_rootLength(), m_length(), m_path()
 {
     initializeWithVariadicArgs(path, args);
 }
 
-FS::Path::Path(va_list args, const FileSystem *fs, const char *path) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(va_list args, const FileSystem *fs, const char *path) : m_fileSystem(), m_rootLength(), m_length(), m_path()
 {
     initializeWithVariadicArgs(fs, path, args);
 }
 
-FS::Path::Path(const char *path, ...) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(const char *path, ...) : m_fileSystem(), m_rootLength(), m_length(), m_path()
 {
     va_list args;
     va_start(args, path);
-    *this = Path(args, path);
+    initializeWithVariadicArgs(path, args);
     va_end(args);
 }
 
-FS::Path::Path(const FileSystem *fs, const char *path, ...) : m_fileSystem(), m_absolutePath(), m_relativePath()
+FS::Path::Path(const FileSystem *fs, const char *path, ...) : m_fileSystem(), m_rootLength(), m_length(), m_path()
 {
     va_list args;
     va_start(args, path);
-    *this = Path(args, fs, path);
+    initializeWithVariadicArgs(fs, path, args);
     va_end(args);
 }
 
+FS::Path& FS::Path::join(const char* name)
+{
+    if (!name) return *this;
+    while (*name == '/' || *name == '\\') ++name; // Leading separators are dropped, one is inserted below if needed.
+    if (m_length > m_rootLength && m_path[m_length - 1] != '/' && m_path[m_length - 1] != '\\') append("/", 1);
+    return append(name);
+}
+
+FS::Path& FS::Path::append(const char* text)
+{
+    return text ? append(text, std::strlen(text)) : *this;
+}
+
+FS::Path& FS::Path::append(const char* text, size_t length)
+{
+    if (!m_fileSystem || !text) return *this;
+    if (m_length + length >= maxLength)
+    {
+        invalidate();
+        return *this;
+    }
+    std::memcpy(m_path + m_length, text, length);
+    m_length += length;
+    m_path[m_length] = 0;
+    return *this;
+}
+
+FS::Path& FS::Path::append(uint32_t number, uint8_t width)
+{
+    char digits[10];
+    size_t count = 0;
+    do
+    {
+        digits[sizeof(digits) - ++count] = '0' + number % 10;
+        number /= 10;
+    } while (number);
+    for (; width > count; --width) append("0", 1);
+    return append(digits + sizeof(digits) - count, count);
+}
+
+FS::Path& FS::Path::truncate(size_t length)
+{
+    if (!m_fileSystem || length < m_rootLength || length >= m_length) return *this;
+    m_length = static_cast<uint16_t>(length);
+    m_path[m_length] = 0;
+    return *this;
+}
+
 void FS::Path::initializeWithVariadicArgs(const char *path, va_list args)
 {
-    m_fileSystem = FileSystemTable::find(path);
-    if (!m_fileSystem || !m_fileSystem->root()) return;
-    va_list argsCopy;
-    va_copy(argsCopy, args);
-    std::vsnprintf(&m_absolutePath[0], maxLength, path, args);
-    std::vsnprintf(&m_relativePath[0], maxLength, path + std::strlen(m_fileSystem->root()), argsCopy);
-    va_end(argsCopy);
+    if (!path) return;
+    auto fs = FileSystemTable::find(path);
+    if (!fs) return;
+    initializeWithVariadicArgs(fs, path + fs->rootLength(), args);
 }
 
 void FS::Path::initializeWithVariadicArgs(const FileSystem* fs, const char *path, va_list args)
 {
-    if (!fs || !fs->root()) return;
+    if (!path || !setRoot(fs)) return;
+    if (!std::strchr(path, '%'))
+    {
+        append(path);
+        return;
+    }
+    const size_t space = maxLength - m_rootLength;
+    int length = std::vsnprintf(m_path + m_rootLength, space, path, args);
+    if (length < 0 || static_cast<size_t>(length) >= space) invalidate();
+    else m_length = m_rootLength + length;
+}
+
+bool FS::Path::setRoot(const FileSystem* fs)
+{
+    if (!fs || !fs->root() || fs->rootLength() >= maxLength) return false;
     m_fileSystem = fs;
-    auto rootLength = std::strlen(m_fileSystem->root());
-    std::memcpy(&m_absolutePath, m_fileSystem->root(), rootLength);
-    va_list argsCopy;
-    va_copy(argsCopy, args);
-    std::vsnprintf(&m_relativePath[0], maxLength, path, args);
-    std::vsnprintf(&m_absolutePath[0] + rootLength, maxLength - rootLength, path, argsCopy);
-    va_end(argsCopy);
+    m_rootLength = m_length = fs->rootLength();
+    std::memcpy(m_path, fs->root(), m_rootLength);
+    m_path[m_length] = 0;
+    return true;
+}
+
+void FS::Path::invalidate()
+{
+    m_fileSystem = nullptr;
+    m_rootLength = m_length = 0;
+    m_path[0] = 0;
 }
@@ -25,6 +25,10 @@ struct Path : protected AdapterTypes
     /// @brief Creates an empty path target.
     Path();
 
+    /// @brief Creates a path pointing to the file system root, to be extended with `join()` and `append()`.
+    /// @param fs File system pointer.
+    explicit Path(const FileSystem* fs);
+
     /// @brief Creates a target file system information from an absolute path string and variadic arguments.
     /// @param args Initialized list of variadic arguments.
     /// @param path Absolute path to the file system entry.
@@ -51,17 +55,47 @@ struct Path : protected AdapterTypes
     inline const FileSystem* fileSystem() const { return m_fileSystem; }
 
     /// @returns The absolute path (containing the file system root path).
-    inline const char* absolutePath() const { return m_absolutePath; }
+    inline const char* absolutePath() const { return m_path; }
 
     /// @returns The relative path (relative to the file system root path).
-    inline const char* relativePath() const { return m_relativePath; }
+    inline const char* relativePath() const { return m_path + m_rootLength; }
+
+    /// @returns The absolute path length.
+    inline size_t length() const { return m_length; }
 
     /// @returns True if the path target is fully configured.
     inline bool isValid() const
     {
-        return !!m_fileSystem && !!m_fileSystem->root() && !!m_fileSystem->media() && !!m_absolutePath[0] && !!m_relativePath[0];
+        return !!m_fileSystem && !!m_fileSystem->root() && !!m_fileSystem->media() && m_length > m_rootLength;
     }
 
+    /// @brief Appends a path segment, inserting the directory separator if needed. No formatting is done.
+    /// @param name File or directory name, or a relative path.
+    /// @returns This path reference. The path becomes invalid if the result doesn't fit.
+    Path& join(const char* name);
+
+    /// @brief Appends the text as is. No formatting is done.
+    /// @param text Text to append.
+    /// @returns This path reference. The path becomes invalid if the result doesn't fit.
+    Path& append(const char* text);
+
+    /// @brief Appends the specified number of characters as is.
+    /// @param text Text to append.
+    /// @param length The number of characters to append.
+    /// @returns This path reference. The path becomes invalid if the result doesn't fit.
+    Path& append(const char* text, size_t length);
+
+    /// @brief Appends a decimal number.
+    /// @param number Number to append.
+    /// @param width Minimal number of digits, the number is padded with leading zeros.
+    /// @returns This path reference. The path becomes invalid if the result doesn't fit.
+    Path& append(uint32_t number, uint8_t width = 0);
+
+    /// @brief Shortens the path, undoing the `join()` and `append()` calls made after the length was read.
+    /// @param length The absolute path length, not less than the root length. Ignored if longer than the path.
+    /// @returns This path reference.
+    Path& truncate(size_t length);
+
 protected:
 
     /// @brief Initializes the structure with the absolute path and variadic arguments to format the path string.
@@ -73,13 +107,23 @@ protected:
     /// @param fs File system pointer.
     /// @param path Relative path to the file system entry.
     /// @param args Variadic arguments list used to format the path string.
+    /// @remarks The path is formatted only if it contains the `%` character, copied otherwise.
     void initializeWithVariadicArgs(const FileSystem* fs, const char* path, va_list args);
 
+    /// @brief Sets the file system and copies its root path to the path buffer.
+    /// @param fs File system pointer.
+    /// @returns True if the file system is valid.
+    bool setRoot(const FileSystem* fs);
+
+    /// @brief Makes the path invalid after a failed operation.
+    void invalidate();
+
 protected:
 
-    const FileSystem* m_fileSystem;       // File system target pointer
-    char m_absolutePath[lfnMaxLength];    // Absolute path string.
-    char m_relativePath[lfnMaxLength];    // Relative path string.
+    const FileSystem* m_fileSystem; // File system target pointer
+    uint16_t m_rootLength;          // The file system root length, the relative path offset.
+    uint16_t m_length;              // The absolute path length.
+    char m_path[lfnMaxLength];      // Absolute path string, the relative path starts at `m_rootLength`.
 
 };
 
@@ -0,0 +1,200 @@
+/**
+ * @file        RamDisk.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A scratch file system media in RAM. Implementation.
+ *              Defines the FileX and FATFS RAM disk drivers.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "RamDisk.hpp"
+#include "FileSystem.hpp"
+#include <cstring>
+
+#if defined(USE_FILEX) || defined(USE_FATFS)
+
+/// @brief RAM disk memory.
+alignas(32) static uint8_t ramDisk[FS::RamDisk::size] __attribute__((section(WTK_FS_RAM_DISK_SECTION)));
+
+/// @brief Gets the disk memory of the sector range.
+/// @param sector The first sector.
+/// @param count The number of sectors.
+/// @returns The first sector memory pointer, `nullptr` if the range exceeds the disk.
+static uint8_t* sectorAddress(uint32_t sector, uint32_t count)
+{
+    if (sector > FS::RamDisk::sectors || count > FS::RamDisk::sectors - sector) return nullptr;
+    return ramDisk + sector * FS::RamDisk::sectorSize;
+}
+
+#endif
+
+#if defined(USE_FILEX)
+
+#include "fx_api.h"
+
+bool FS::RamDisk::mount()
+{
+    auto configuration = MediaServices::getConfiguration(MediaType::RAM);
+    if (!configuration || !configuration->root || !configuration->driver) return false;
+    if (FileSystemTable::find(&m_media)) return true; // Already mounted.
+    CHAR* name = const_cast<CHAR*>("RAM");
+    if (fx_media_format(&m_media, configuration->driver, nullptr, m_cache, cacheSize, name,
+        1, rootEntries, 0, sectors, sectorSize, clusterSectors, 1, 1) != FX_SUCCESS) return false;
+    if (fx_media_open(&m_media, name, configuration->driver, nullptr, m_cache, cacheSize) != FX_SUCCESS) return false;
+    if (MediaServices::mount(m_media, configuration->root)) return true;
+    fx_media_close(&m_media);
+    return false;
+}
+
+bool FS::RamDisk::umount()
+{
+    if (!MediaServices::umount(m_media)) return false;
+    fx_media_close(&m_media);
+    return true;
+}
+
+EXTERN_C_BEGIN
+
+VOID fs_ram_driver(FX_MEDIA* media)
+{
+    uint8_t* address;
+    switch (media->fx_media_driver_request)
+    {
+    case FX_DRIVER_READ:
+    case FX_DRIVER_WRITE:
+        address = sectorAddress(media->fx_media_driver_logical_sector + media->fx_media_hidden_sectors,
+            media->fx_media_driver_sectors);
+        if (!address)
+        {
+            media->fx_media_driver_status = FX_IO_ERROR;
+            return;
+        }
+        if (media->fx_media_driver_request == FX_DRIVER_READ)
+            std::memcpy(media->fx_media_driver_buffer, address, media->fx_media_driver_sectors * FS::RamDisk::sectorSize);
+        else
+            std::memcpy(address, media->fx_media_driver_buffer, media->fx_media_driver_sectors * FS::RamDisk::sectorSize);
+        media->fx_media_driver_status = FX_SUCCESS;
+        return;
+    case FX_DRIVER_BOOT_READ:
+        std::memcpy(media->fx_media_driver_buffer, ramDisk, FS::RamDisk::sectorSize);
+        media->fx_media_driver_status = FX_SUCCESS;
+        return;
+    case FX_DRIVER_BOOT_WRITE:
+        std::memcpy(ramDisk, media->fx_media_driver_buffer, FS::RamDisk::sectorSize);
+        media->fx_media_driver_status = FX_SUCCESS;
+        return;
+    case FX_DRIVER_INIT:
+    case FX_DRIVER_UNINIT:
+    case FX_DRIVER_FLUSH:
+    case FX_DRIVER_ABORT:
+    case FX_DRIVER_RELEASE_SECTORS:
+        media->fx_media_driver_status = FX_SUCCESS; // Nothing to do for memory.
+        return;
+    default:
+        media->fx_media_driver_status = FX_IO_ERROR;
+        return;
+    }
+}
+
+EXTERN_C_END
+
+#elif defined(USE_FATFS)
+
+#include "ff_gen_drv.h"
+
+/// @returns The disk status, always ready.
+static DSTATUS ramDiskStatus(BYTE) { return 0; }
+
+/// @returns The disk status, always ready.
+static DSTATUS ramDiskInitialize(BYTE) { return 0; }
+
+/// @brief Reads the sectors.
+static DRESULT ramDiskRead(BYTE, BYTE* buffer, DWORD sector, UINT count)
+{
+    const uint8_t* address = sectorAddress(sector, count);
+    if (!address) return RES_PARERR;
+    std::memcpy(buffer, address, count * FS::RamDisk::sectorSize);
+    return RES_OK;
+}
+
+#if _USE_WRITE == 1
+/// @brief Writes the sectors.
+static DRESULT ramDiskWrite(BYTE, const BYTE* buffer, DWORD sector, UINT count)
+{
+    uint8_t* address = sectorAddress(sector, count);
+    if (!address) return RES_PARERR;
+    std::memcpy(address, buffer, count * FS::RamDisk::sectorSize);
+    return RES_OK;
+}
+#endif
+
+#if _USE_IOCTL == 1
+/// @brief Reports the disk geometry to `f_mkfs()`.
+static DRESULT ramDiskIoctl(BYTE, BYTE command, void* buffer)
+{
+    switch (command)
+    {
+    case CTRL_SYNC: return RES_OK;
+    case GET_SECTOR_COUNT: *static_cast<DWORD*>(buffer) = FS::RamDisk::sectors; return RES_OK;
+    case GET_SECTOR_SIZE: *static_cast<WORD*>(buffer) = FS::RamDisk::sectorSize; return RES_OK;
+    case GET_BLOCK_SIZE: *static_cast<DWORD*>(buffer) = 1; return RES_OK;
+    default: return RES_PARERR;
+    }
+}
+#endif
+
+EXTERN_C_BEGIN
+
+const Diskio_drvTypeDef fs_ram_driver =
+{
+    ramDiskInitialize,
+    ramDiskStatus,
+    ramDiskRead,
+#if _USE_WRITE == 1
+    ramDiskWrite,
+#endif
+#if _USE_IOCTL == 1
+    ramDiskIoctl,
+#endif
+};
+
+EXTERN_C_END
+
+bool FS::RamDisk::mount()
+{
+    auto configuration = MediaServices::getConfiguration(MediaType::RAM);
+    if (!configuration || !configuration->root || !configuration->driver) return false;
+    if (FileSystemTable::find(&m_media)) return true; // Already mounted.
+    if (!m_path[0] && FATFS_LinkDriver(configuration->driver, m_path) != 0) return false;
+    if (std::strcmp(m_path, configuration->root) != 0) return false; // FATFS assigns the drive numbers in the link order.
+    char buffer[_MAX_SS];
+    if (f_mkfs(configuration->root, FM_FAT, clusterSectors * sectorSize, buffer, sizeof(buffer)) != FR_OK) return false;
+    return MediaServices::mount(m_media, configuration->root);
+}
+
+bool FS::RamDisk::umount()
+{
+    auto entry = FileSystemTable::find(&m_media);
+    if (!entry) return false;
+    f_mount(nullptr, entry->root(), 0);
+    return MediaServices::umount(m_media);
+}
+
+#else
+
+bool FS::RamDisk::mount() { return false; }
+
+bool FS::RamDisk::umount() { return false; }
+
+#endif
+
+EXTERN_C_BEGIN
+
+int fs_ram_mount(void)
+{
+    return FS::RamDisk::mount();
+}
+
+EXTERN_C_END
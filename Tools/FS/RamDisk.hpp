@@ -0,0 +1,59 @@
+/**
+ * @file        RamDisk.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A scratch file system media in RAM. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "Media.hpp"
+#include "StaticClass.hpp"
+
+namespace FS
+{
+
+/// @brief Provides a fast scratch media for temporary files, formatted each time it is mounted.
+/// @remarks The disk memory is `WTK_FS_RAM_DISK` bytes placed in the `WTK_FS_RAM_DISK_SECTION` linker section.
+///          The media type is registered as `MediaType::RAM` with the `fs_ram_driver` driver, like the other media.
+///          The contents are lost when the media is unmounted or the device is reset.
+class RamDisk final : public AdapterTypes
+{
+
+    STATIC(RamDisk)
+
+public:
+
+    static constexpr size_t size = WTK_FS_RAM_DISK;     ///< The disk size in bytes.
+    static constexpr size_t sectorSize = 512;           ///< The sector size in bytes.
+    static constexpr size_t sectors = size / sectorSize;///< The number of sectors.
+    static constexpr size_t clusterSectors = 8;         ///< The number of sectors per cluster, 4KB clusters.
+    static constexpr size_t rootEntries = 64;           ///< The number of the root directory entries.
+
+    static_assert(size % (sectorSize * clusterSectors) == 0, "The RAM disk size must be a multiple of the cluster size.");
+
+    /// @brief Formats the disk and mounts it at the root registered for `MediaType::RAM`.
+    /// @returns True if mounted, false if the media type is not registered or the format failed.
+    static bool mount();
+
+    /// @brief Unmounts the disk. The files stored are lost.
+    /// @returns True if unmounted, false if it was not mounted.
+    static bool umount();
+
+private:
+
+#if defined(USE_FILEX)
+    static constexpr size_t cacheSize = 4 * sectorSize; // The FileX media memory. Sector reads are plain copies.
+    static inline uint8_t m_cache[cacheSize] = {};      // FileX media memory.
+#elif defined(USE_FATFS)
+    static inline char m_path[4] = {};                  // The FATFS logical drive path assigned to the driver.
+#endif
+    static inline Media m_media = {};                   // Media structure.
+
+};
+
+}
@@ -0,0 +1,89 @@
+/**
+ * @file        StatCache.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File and directory metadata cache. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "StatCache.hpp"
+#include "OS/CriticalSection.hpp"
+#include <cctype>
+
+bool FS::StatCache::lookup(const FileSystem* fs, const char* path, FileStat& stat, bool& exists, uint32_t& generation)
+{
+    if (!fs || !path) return false;
+    uint16_t length;
+    const uint32_t key = hash(path, length);
+    OS::CriticalSection lock;
+    generation = m_generation;
+    for (const Entry& entry : m_entries)
+    {
+        if (!entry.isUsed || entry.hash != key || entry.length != length || entry.root != fs->rootId()) continue;
+        exists = entry.exists;
+        if (exists) stat = entry.stat;
+        ++m_hits;
+        return true;
+    }
+    ++m_misses;
+    return false;
+}
+
+void FS::StatCache::store(const FileSystem* fs, const char* path, const FileStat* stat, uint32_t generation)
+{
+    if (!fs || !path) return;
+    uint16_t length;
+    const uint32_t key = hash(path, length);
+    OS::CriticalSection lock;
+    if (generation != m_generation) return; // Invalidated while the metadata was read.
+    Entry* target = nullptr;
+    for (Entry& entry : m_entries) if (entry.isUsed && entry.hash == key && entry.length == length && entry.root == fs->rootId())
+    {
+        target = &entry;
+        break;
+    }
+    if (!target)
+    {
+        target = &m_entries[m_next];
+        m_next = (m_next + 1) % size;
+    }
+    target->root = fs->rootId();
+    target->hash = key;
+    target->length = length;
+    target->isUsed = true;
+    target->exists = !!stat;
+    target->stat = stat ? *stat : FileStat();
+}
+
+void FS::StatCache::invalidate(const FileSystem* fs, const char* path)
+{
+    if (!fs || !path) return;
+    uint16_t length;
+    const uint32_t key = hash(path, length);
+    OS::CriticalSection lock;
+    ++m_generation;
+    for (Entry& entry : m_entries)
+        if (entry.isUsed && entry.hash == key && entry.length == length && entry.root == fs->rootId()) entry.isUsed = false;
+}
+
+void FS::StatCache::invalidate(const FileSystem* fs)
+{
+    OS::CriticalSection lock;
+    ++m_generation;
+    for (Entry& entry : m_entries) if (!fs || entry.root == fs->rootId()) entry.isUsed = false;
+}
+
+uint32_t FS::StatCache::hash(const char* path, uint16_t& length)
+{
+    while (*path == '/' || *path == '\\') ++path;
+    uint32_t value = 2166136261u;
+    length = 0;
+    for (; *path; ++path, ++length)
+    {
+        const char c = *path == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(*path)));
+        value = (value ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return value;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file        StatCache.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       File and directory metadata cache. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "FileSystem.hpp"
+#include "StaticClass.hpp"
+
+namespace FS
+{
+
+/// @brief Caches the results of `FS::stat()`, including the entries not found, keyed by the file system root and path hash.
+/// @remarks Entries are invalidated when the file or directory is created, renamed or deleted through the toolkit,
+///          when a file is written, extended, flushed or closed,
+///          and all entries of a file system when it is mounted or unmounted. Thread safe.
+///          Each invalidation advances the cache generation, `store()` drops the metadata read before it,
+///          so a `stat()` racing with a change never caches the old metadata.
+class StatCache final
+{
+
+    STATIC(StatCache)
+
+public:
+
+    static constexpr size_t size = WTK_FS_STAT_CACHE; ///< The number of cached entries.
+
+    /// @brief Finds the cached metadata.
+    /// @param fs File system pointer.
+    /// @param path Path relative to the file system root.
+    /// @param stat Metadata target reference, set if found and the entry exists.
+    /// @param exists Set to true if the entry exists, false if it was cached as not found.
+    /// @param generation Set to the cache generation, pass it to `store()` after reading the metadata on a miss.
+    /// @returns True if the path is cached.
+    static bool lookup(const FileSystem* fs, const char* path, FileStat& stat, bool& exists, uint32_t& generation);
+
+    /// @brief Stores the metadata, replacing the oldest entry if the cache is full.
+    ///        Does nothing if an entry was invalidated since the generation was read, the metadata could be outdated.
+    /// @param fs File system pointer.
+    /// @param path Path relative to the file system root.
+    /// @param stat Metadata pointer, `nullptr` if the entry doesn't exist.
+    /// @param generation The cache generation set by `lookup()` before the metadata was read.
+    static void store(const FileSystem* fs, const char* path, const FileStat* stat, uint32_t generation);
+
+    /// @brief Removes the cached metadata of the path.
+    /// @param fs File system pointer.
+    /// @param path Path relative to the file system root.
+    static void invalidate(const FileSystem* fs, const char* path);
+
+    /// @brief Removes all cached metadata of the file system, or all entries if `fs` is `nullptr`.
+    /// @param fs File system pointer.
+    static void invalidate(const FileSystem* fs);
+
+    /// @returns The number of lookups served from the cache.
+    static inline uint32_t hits() { return m_hits; }
+
+    /// @returns The number of lookups not found in the cache.
+    static inline uint32_t misses() { return m_misses; }
+
+private:
+
+    /// @brief Cache entry.
+    struct Entry
+    {
+        RootId root;        // File system root identifier.
+        uint32_t hash;      // Path hash.
+        uint16_t length;    // Path length, reduces the risk of hash collisions.
+        bool isUsed;        // The entry holds cached metadata.
+        bool exists;        // The path exists.
+        FileStat stat;      // Cached metadata.
+    };
+
+    /// @brief Calculates the path key. Case insensitive, `\` is the same as `/`, leading separators are ignored.
+    /// @param path Path relative to the file system root.
+    /// @param length Path length target reference.
+    /// @returns Path hash.
+    static uint32_t hash(const char* path, uint16_t& length);
+
+    static inline Entry m_entries[size] = {};   // Cached entries.
+    static inline size_t m_next = {};           // The entry to replace next.
+    static inline uint32_t m_hits = {};         // The number of cache hits.
+    static inline uint32_t m_misses = {};       // The number of cache misses.
+    static inline uint32_t m_generation = {};   // Advanced on each invalidation.
+
+};
+
+}
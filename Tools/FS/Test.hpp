@@ -11,8 +11,20 @@
 #pragma once
 
 #include "API.hpp"
+#include "AsyncIO.hpp"
+#include "Benchmark.hpp"
+#include "BufferedFile.hpp"
+#include "CompressedFile.hpp"
+#include "Copy.hpp"
+#include "KVStore.hpp"
 #include "Log.hpp"
+#include "MediaCache.hpp"
+#include "StatCache.hpp"
+#include "TimeSeries.hpp"
+#include "WriteScheduler.hpp"
 #include "StaticClass.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <cstdio>
 
@@ -29,6 +41,9 @@ public:
 
     static constexpr size_t bufferSize = 16384; // Test buffer size.
     static constexpr size_t slack = 10; // Make the actual file size this amount of byte smaller than the buffer size.
+    static constexpr size_t bufferedSize = 4096; // Buffered file test buffer size.
+    static constexpr size_t treeLevels = CopyEngine::maxDepth + 1; // Tree copy test directory levels, the deepest is skipped.
+    static constexpr uint32_t treeFiles = 3; // Tree copy test files per directory level.
 
     /// @brief Tests the file API.
     /// @param fs File system pointer.
@@ -60,6 +75,12 @@ public:
                 return false;
             }
         } // ...and it is closed here, or wherever the braced block is left.
+        Log::msg("Flushing the media...");
+        if (!flush(fs)) // Closing the file leaves its sectors in the media cache, this writes them to the media.
+        {
+            Log::msg(LogMessage::error, "Flush failed!");
+            return false;
+        }
         { // The file for the write operation is closed to free the stack memory.
             Log::msg("Opening file...");
             File file(fs, fileName, FileMode::read);
@@ -78,7 +99,7 @@ public:
             }
             if (readResult.value() != bufferSize - slack)
             {
-                Log::msg(LogMessage::error, "Invalid file size: %u bytes!", readResult.value());
+                Log::msg(LogMessage::error, "Invalid file size: %lu bytes!", static_cast<unsigned long>(readResult.value()));
                 return false;
             }
             if (!bufferTest(buffer))
@@ -86,10 +107,16 @@ public:
                 Log::msg(LogMessage::error, "Invalid file data!", readResult.value());
                 return false;
             }
+            if (file.read(buffer, bufferSize) != ReadResult(0)) // All adapters read 0 bytes at the end of the file, not an error.
+            {
+                Log::msg(LogMessage::error, "Read at the end of the file failed!");
+                return false;
+            }
         } // And now it can and should be closed before we modify its entry.
         { // We prefix the created file with a dot, to make it hidden for Linux based systems.
             Log::msg("Prefixing the file...");
-            Path prefixed(fs, ".%s", fileName);
+            Path prefixed(fs);
+            prefixed.append(".").append(fileName);
             if (fileExists(fs, prefixed.relativePath())) // But if the file with the new name exists, it would fail...
             {
                 Log::msg("Prefixed file exists, deleting prefixed...");
@@ -120,8 +147,665 @@ public:
         return true;
     }
 
+    /// @brief Tests the buffered file access with small records.
+    /// @param fs File system pointer.
+    /// @param fileName Test file name.
+    /// @param records The number of records to write and read back.
+    /// @returns True if passed, false if failed.
+    static bool bufferedAPI(const FileSystem* fs, const char* fileName, uint32_t records = 10000)
+    {
+        if (!fs || !fileName)
+        {
+            Log::msg(LogMessage::error, "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS buffered file API, file = %s%s:", fs->root(), fileName);
+        {
+            File file(fs, fileName, FileMode::write | FileMode::createAlways);
+            BufferedFileT<bufferedSize> buffered(file);
+            if (!buffered)
+            {
+                Log::msg(LogMessage::error, "Create failed!");
+                return false;
+            }
+            // Twice the space needed, the file should be truncated on close.
+            if (!file.preallocate(2 * records * sizeof(uint32_t[2]))) Log::msg("Pre-allocation not available.");
+            Log::msg("Writing %lu records...", static_cast<unsigned long>(records));
+            for (uint32_t i = 0; i < records; ++i)
+            {
+                uint32_t record[2] = { i, ~i };
+                if (!buffered.write(record))
+                {
+                    Log::msg(LogMessage::error, "Write failed at record %lu!", static_cast<unsigned long>(i));
+                    return false;
+                }
+            }
+        } // The buffered file is flushed here, then the file is closed.
+        {
+            File file(fs, fileName, FileMode::read);
+            BufferedFileT<bufferedSize> buffered(file);
+            if (!buffered)
+            {
+                Log::msg(LogMessage::error, "Open failed!");
+                return false;
+            }
+            File::FileOffset length;
+            if (!file.size(length) || length != records * sizeof(uint32_t[2]))
+            {
+                Log::msg(LogMessage::error, "Invalid file size!");
+                return false;
+            }
+            Log::msg("Reading...");
+            for (uint32_t i = 0; i < records; ++i)
+            {
+                uint32_t record[2];
+                if (!buffered.read(record) || record[0] != i || record[1] != ~i)
+                {
+                    Log::msg(LogMessage::error, "Invalid record %lu!", static_cast<unsigned long>(i));
+                    return false;
+                }
+            }
+        }
+        if (!fileDelete(fs, fileName))
+        {
+            Log::msg(LogMessage::error, "Delete failed!");
+            return false;
+        }
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the directory enumeration: creates a directory with files, lists and filters them, then deletes them.
+    /// @param fs File system pointer.
+    /// @param directoryName Test directory name.
+    /// @param files The number of test files to create.
+    /// @returns True if passed, false if failed.
+    static bool directoryAPI(const FileSystem* fs, const char* directoryName, uint32_t files = 20)
+    {
+        if (!fs || !directoryName)
+        {
+            Log::msg(LogMessage::error, "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS directory API, directory = %s%s:", fs->root(), directoryName);
+        if (!directoryExists(fs, directoryName) && !directoryCreate(fs, directoryName))
+        {
+            Log::msg(LogMessage::error, "Directory create failed!");
+            return false;
+        }
+        Log::msg("Creating %lu files...", static_cast<unsigned long>(files));
+        for (uint32_t i = 0; i < files; ++i)
+        {
+            Path path(fs, directoryName);
+            path.join("t").append(i, 3).append(i & 1 ? ".txt" : ".dat");
+            File file(path, FileMode::write | FileMode::createAlways);
+            if (!file || !file.write(&i, sizeof(i)))
+            {
+                Log::msg(LogMessage::error, "Create failed!");
+                return false;
+            }
+        }
+        uint32_t listed = 0, matched = 0;
+        {
+            Directory directory(fs, directoryName);
+            if (!directory)
+            {
+                Log::msg(LogMessage::error, "Open failed!");
+                return false;
+            }
+            for (const DirectoryItem& item : directory) if (!item.isDirectory()) ++listed;
+            directory.filter("T*.DAT", 0, DirectoryItem::directory | DirectoryItem::volume);
+            if (!directory.rewind())
+            {
+                Log::msg(LogMessage::error, "Rewind failed!");
+                return false;
+            }
+            while (const DirectoryItem* item = directory.next()) if (item->size == sizeof(uint32_t)) ++matched;
+            if (!directory.isComplete())
+            {
+                Log::msg(LogMessage::error, "Enumeration failed!");
+                return false;
+            }
+        }
+        if (listed != files || matched != (files + 1) / 2)
+        {
+            Log::msg(LogMessage::error, "Listed %lu files, matched %lu!", static_cast<unsigned long>(listed), static_cast<unsigned long>(matched));
+            return false;
+        }
+        Log::msg("Deleting...");
+        for (uint32_t i = 0; i < files; ++i)
+        {
+            Path path(fs, directoryName);
+            path.join("t").append(i, 3).append(i & 1 ? ".txt" : ".dat");
+            if (!fileDelete(fs, path.relativePath()))
+            {
+                Log::msg(LogMessage::error, "Delete failed!");
+                return false;
+            }
+        }
+        if (!directoryDelete(fs, directoryName))
+        {
+            Log::msg(LogMessage::error, "Directory delete failed!");
+            return false;
+        }
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Logs the media sector cache and the metadata cache statistics.
+    /// @param fs File system pointer.
+    static void cacheStatistics(const FileSystem* fs)
+    {
+        MediaCache::Statistics statistics;
+        if (fs && fs->media() && MediaCache::statistics(*fs->media(), statistics))
+            Log::msg("Media cache %s: %lu bytes, sectors %lu hits / %lu misses, FAT %lu hits / %lu misses.", fs->root(),
+                static_cast<unsigned long>(statistics.size), static_cast<unsigned long>(statistics.sectorHits),
+                static_cast<unsigned long>(statistics.sectorMisses), static_cast<unsigned long>(statistics.fatHits),
+                static_cast<unsigned long>(statistics.fatMisses));
+        Log::msg("Stat cache: %lu hits / %lu misses.", static_cast<unsigned long>(StatCache::hits()),
+            static_cast<unsigned long>(StatCache::misses()));
+    }
+
+    /// @brief Tests the pipelined copy: writes a file, copies it to the other file system with verification, then deletes both.
+    ///        Repeats with an empty file and with a file one byte longer, so the end of the file is hit at a block boundary,
+    ///        on the first read and inside a block.
+    /// @param source Source file system pointer.
+    /// @param target Target file system pointer.
+    /// @param fileName Test file name.
+    /// @param blocks The number of test buffers the file consists of, a multiple of the copy and verification block sizes.
+    /// @returns True if passed, false if failed.
+    static bool copyAPI(const FileSystem* source, const FileSystem* target, const char* fileName, uint32_t blocks = 64)
+    {
+        if (!source || !target || !fileName || m_asyncFileSystem)
+        {
+            Log::msg(LogMessage::error, m_asyncFileSystem ? "Asynchronous test in progress!" : "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS copy, %s%s to %s%s:", source->root(), fileName, target->root(), fileName);
+        const size_t size = blocks * bufferSize;
+        if (!copyTest(source, target, fileName, size) || !copyTest(source, target, fileName, 0) ||
+            !copyTest(source, target, fileName, size + 1)) return false;
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the directory tree copy: creates a tree one level deeper than `CopyEngine::maxDepth` with files on each level,
+    ///        copies it to the other file system with verification, checks the deepest level is skipped and reported
+    ///        and the other files are copied, then deletes both trees.
+    /// @param source Source file system pointer.
+    /// @param target Target file system pointer.
+    /// @param directoryName Tree root directory name.
+    /// @returns True if passed, false if failed.
+    static bool copyTreeAPI(const FileSystem* source, const FileSystem* target, const char* directoryName)
+    {
+        if (!source || !target || !directoryName || m_asyncFileSystem)
+        {
+            Log::msg(LogMessage::error, m_asyncFileSystem ? "Asynchronous test in progress!" : "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS tree copy, %s%s to %s%s:", source->root(), directoryName, target->root(), directoryName);
+        for (size_t level = 0; level < treeLevels; ++level)
+        {
+            Path directory = treePath(source, directoryName, level);
+            if (!directoryCreate(source, "%s", directory.relativePath()))
+            {
+                Log::msg(LogMessage::error, "Directory create failed!");
+                return false;
+            }
+            for (uint32_t i = 0; i < treeFiles; ++i)
+            {
+                Path path(directory);
+                path.join("f").append(i).append(".bin");
+                File file(path, FileMode::write | FileMode::createAlways);
+                if (!file || !file.write(&i, sizeof(i)))
+                {
+                    Log::msg(LogMessage::error, "Create failed!");
+                    return false;
+                }
+            }
+        }
+        Log::msg("Copying %lu levels...", static_cast<unsigned long>(treeLevels));
+        m_treeSkipped = 0;
+        const bool isCopied = copyTree(source, directoryName, target, directoryName, [](const CopyEngine::Progress& progress)
+        {
+            m_treeSkipped = progress.skipped;
+            return true;
+        }, true);
+        uint32_t copied = 0;
+        for (size_t level = 0; level < treeLevels; ++level) for (uint32_t i = 0; i < treeFiles; ++i)
+        {
+            Path path = treePath(target, directoryName, level);
+            path.join("f").append(i).append(".bin");
+            if (fileExists(target, "%s", path.relativePath())) ++copied;
+        }
+        const bool isSourceDeleted = treeDelete(source, directoryName);
+        const bool isTargetDeleted = treeDelete(target, directoryName);
+        if (isCopied || m_treeSkipped != 1 || copied != (treeLevels - 1) * treeFiles)
+        {
+            Log::msg(LogMessage::error, "Copied %lu files, skipped %lu directories!", static_cast<unsigned long>(copied), static_cast<unsigned long>(m_treeSkipped));
+            return false;
+        }
+        if (!isSourceDeleted || !isTargetDeleted)
+        {
+            Log::msg(LogMessage::error, "Delete failed!");
+            return false;
+        }
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the key-value store: updates a counter, reopens the store to rebuild the index, then removes the key.
+    /// @param fs File system pointer.
+    /// @param directoryName Store directory name.
+    /// @param updates The number of counter updates.
+    /// @returns True if passed, false if failed.
+    static bool kvAPI(const FileSystem* fs, const char* directoryName, uint32_t updates = 1000)
+    {
+        static KVStoreT<16> store;
+        if (!fs || !directoryName)
+        {
+            Log::msg(LogMessage::error, "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS key-value store, %s%s:", fs->root(), directoryName);
+        uint32_t counter = 0;
+        if (!store.open(fs, directoryName))
+        {
+            Log::msg(LogMessage::error, "Open failed!");
+            return false;
+        }
+        store.get("counter", counter);
+        const uint32_t expected = counter + updates;
+        while (counter < expected) if (!store.put("counter", ++counter))
+        {
+            Log::msg(LogMessage::error, "Put failed!");
+            store.close();
+            return false;
+        }
+        Log::msg("Counter updated %lu times, %lu segments.", static_cast<unsigned long>(updates), static_cast<unsigned long>(store.segments()));
+        store.close();
+        counter = 0;
+        if (!store.open(fs, directoryName) || !store.get("counter", counter) || counter != expected)
+        {
+            Log::msg(LogMessage::error, "Recovery failed!");
+            store.close();
+            return false;
+        }
+        const bool isRemoved = store.remove("counter") && !store.contains("counter") && store.compact();
+        store.close();
+        if (!isRemoved)
+        {
+            Log::msg(LogMessage::error, "Remove failed!");
+            return false;
+        }
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the time-series store: records a ramp, reads a time range back and downsamples the whole recording.
+    /// @param fs File system pointer.
+    /// @param directoryName Series directory name, deleted when passed.
+    /// @param samples The number of samples recorded, 10ms apart.
+    /// @returns True if passed, false if failed.
+    static bool timeSeriesAPI(const FileSystem* fs, const char* directoryName, uint32_t samples = 10000)
+    {
+        static TimeSeriesT<> series;
+        static TimeSeries::Sample buffer[100];
+        static TimeSeries::Bucket buckets[10];
+        if (!fs || !directoryName || samples < 2 * std::size(buffer))
+        {
+            Log::msg(LogMessage::error, "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS time series, %s%s:", fs->root(), directoryName);
+        if (!series.open(fs, directoryName, 1000))
+        {
+            Log::msg(LogMessage::error, "Open failed!");
+            return false;
+        }
+        TimeSeries::Time first = 0, last = 0;
+        const TimeSeries::Time start = series.range(first, last) ? last + 10 : 0;
+        for (uint32_t i = 0; i < samples; ++i) if (!series.append(start + i * 10, static_cast<float>(i)))
+        {
+            Log::msg(LogMessage::error, "Append failed!");
+            series.close();
+            return false;
+        }
+        const TimeSeries::Time from = start + samples / 2 * 10;
+        ReadResult result = series.read(from, from + std::size(buffer) * 10, buffer, std::size(buffer));
+        bool isValid = result.has_value() && result.value() == std::size(buffer);
+        for (size_t i = 0; isValid && i < std::size(buffer); ++i) isValid = buffer[i].value == static_cast<float>(samples / 2 + i);
+        if (!isValid)
+        {
+            Log::msg(LogMessage::error, "Range read failed!");
+            series.close();
+            return false;
+        }
+        isValid = series.downsample(start, start + samples * 10, buckets, std::size(buckets));
+        for (size_t i = 0; isValid && i < std::size(buckets); ++i)
+            isValid = buckets[i].count == samples / std::size(buckets) && buckets[i].min == static_cast<float>(i * buckets[i].count);
+        series.close();
+        if (!isValid)
+        {
+            Log::msg(LogMessage::error, "Downsampling failed!");
+            return false;
+        }
+        fileDelete(fs, "%s/series.dat", directoryName);
+        fileDelete(fs, "%s/series.idx", directoryName);
+        directoryDelete(fs, "%s", directoryName);
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the compressed file: writes log-like text lines compressed, reads them back and logs the ratio.
+    /// @param fs File system pointer.
+    /// @param fileName Test file name, deleted when passed.
+    /// @param lines The number of lines written.
+    /// @returns True if passed, false if failed.
+    static bool compressionAPI(const FileSystem* fs, const char* fileName, uint32_t lines = 10000)
+    {
+        alignas(32) static uint8_t buffer[2 * bufferSize];
+        static uint16_t table[1u << WTK_FS_LZ4_HASH_BITS];
+        if (!fs || !fileName)
+        {
+            Log::msg(LogMessage::error, "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS compression, %s%s:", fs->root(), fileName);
+        char line[64];
+        {
+            File file(fs, fileName, FileMode::write | FileMode::createAlways);
+            CompressedFile output(file, buffer, bufferSize, table);
+            for (uint32_t i = 0; i < lines; ++i)
+            {
+                const int length = std::snprintf(line, sizeof(line), "[%8lu] ADC2: Value: %u.%03u\n", i * 10ul,
+                    static_cast<unsigned>(i % 4), static_cast<unsigned>(i % 1000));
+                if (!file || !output.write(line, length))
+                {
+                    Log::msg(LogMessage::error, "Write failed!");
+                    return false;
+                }
+            }
+            if (!output.finish())
+            {
+                Log::msg(LogMessage::error, "Write failed!");
+                return false;
+            }
+            Log::msg("Compressed %lu bytes to %lu bytes.", static_cast<unsigned long>(output.size()), static_cast<unsigned long>(output.compressedSize()));
+        }
+        char text[sizeof(line)];
+        bool isValid = true;
+        {
+            File file(fs, fileName, FileMode::read);
+            CompressedFile input(file, buffer, bufferSize, table);
+            for (uint32_t i = 0; isValid && i < lines; ++i)
+            {
+                const int length = std::snprintf(line, sizeof(line), "[%8lu] ADC2: Value: %u.%03u\n", i * 10ul,
+                    static_cast<unsigned>(i % 4), static_cast<unsigned>(i % 1000));
+                ReadResult result = input.read(text, length);
+                isValid = result.has_value() && result.value() == static_cast<size_t>(length) && !std::memcmp(text, line, length);
+            }
+            isValid = isValid && input.read(text, 1) == ReadResult(0);
+        }
+        if (!isValid)
+        {
+            Log::msg(LogMessage::error, "Decompressed data invalid!");
+            return false;
+        }
+        fileDelete(fs, fileName);
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the write scheduler: queues interleaved writes to 2 files and a priority file, checks the file sizes.
+    /// @param fs File system pointer.
+    /// @param blocks The number of test buffers written to each of the 2 files.
+    /// @returns True if passed, false if failed.
+    static bool schedulerAPI(const FileSystem* fs, uint32_t blocks = 64)
+    {
+        static const char* names[] = { "fs-sched-1.dat", "fs-sched-2.dat", "fs-sched-log.txt" };
+        alignas(32) static uint8_t buffers[2][2 * bufferSize];
+        static uint8_t logBuffer[512];
+        if (!fs || m_asyncFileSystem)
+        {
+            Log::msg(LogMessage::error, m_asyncFileSystem ? "Asynchronous test in progress!" : "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS write scheduler, %s:", fs->root());
+        bufferFill(m_asyncBuffer);
+        bool isWritten = true;
+        {
+            File file1(fs, names[0], FileMode::write | FileMode::createAlways);
+            File file2(fs, names[1], FileMode::write | FileMode::createAlways);
+            File file3(fs, names[2], FileMode::write | FileMode::createAlways);
+            ScheduledFile stream1(file1, buffers[0], sizeof(buffers[0]));
+            ScheduledFile stream2(file2, buffers[1], sizeof(buffers[1]));
+            ScheduledFile log(file3, logBuffer, sizeof(logBuffer), true);
+            for (uint32_t i = 0; isWritten && i < blocks; ++i)
+                isWritten = stream1.write(m_asyncBuffer, bufferSize) && stream2.write(m_asyncBuffer, bufferSize) && log.write("block\n", 6);
+            isWritten = isWritten && stream1.close() && stream2.close() && log.close();
+            Log::msg("Written in %lu / %lu bursts, %lu / %lu stalls, queue depth up to %lu / %lu bytes.",
+                static_cast<unsigned long>(stream1.bursts()), static_cast<unsigned long>(stream2.bursts()),
+                static_cast<unsigned long>(stream1.stalls()), static_cast<unsigned long>(stream2.stalls()),
+                static_cast<unsigned long>(stream1.maxPending()), static_cast<unsigned long>(stream2.maxPending()));
+        }
+        FileStat stats[3];
+        const uint64_t sizes[3] = { uint64_t(blocks) * bufferSize, uint64_t(blocks) * bufferSize, uint64_t(blocks) * 6 };
+        for (size_t i = 0; i < 3; ++i)
+        {
+            isWritten = isWritten && stat(fs, names[i], stats[i]) && stats[i].size == sizes[i];
+            fileDelete(fs, names[i]);
+        }
+        if (!isWritten)
+        {
+            Log::msg(LogMessage::error, "Scheduled write failed!");
+            return false;
+        }
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Runs the file system benchmark and logs its CSV results.
+    /// @remarks Uses its own `Benchmark::maxBlockSize` buffer placed in the `WTK_FS_BENCHMARK_SECTION` linker section.
+    /// @param fs File system pointer.
+    /// @param directoryName Test directory name.
+    /// @returns True if passed, false if failed.
+    static bool benchmark(const FileSystem* fs, const char* directoryName)
+    {
+        if (!fs || !directoryName || m_asyncFileSystem)
+        {
+            Log::msg(LogMessage::error, m_asyncFileSystem ? "Asynchronous test in progress!" : "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Benchmarking FS, directory = %s%s:", fs->root(), directoryName);
+        if (!Benchmark::run(fs, directoryName, m_benchmarkBuffer, sizeof(m_benchmarkBuffer), [](const char* line) { Log::msg("%s", line); }))
+        {
+            Log::msg(LogMessage::error, "Benchmark failed!");
+            return false;
+        }
+        cacheStatistics(fs);
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the asynchronous file API. Returns immediately, the result is logged when the test completes.
+    ///        Call from the application thread, the requests are completed there.
+    /// @param fs File system pointer.
+    /// @param fileName Test file name. Must stay valid until the test completes.
+    /// @returns True if the test was started, false if failed to start.
+    static bool asyncAPI(const FileSystem* fs, const char* fileName)
+    {
+        if (!fs || !fileName || m_asyncFileSystem)
+        {
+            Log::msg(LogMessage::error, m_asyncFileSystem ? "Asynchronous test in progress!" : "Invalid parameters!");
+            return false;
+        }
+        Log::msg("Testing FS asynchronous file API, file = %s%s:", fs->root(), fileName);
+        m_asyncFileSystem = fs;
+        m_asyncFileName = fileName;
+        m_asyncFailed = false;
+        bufferClear(m_asyncBuffer);
+        bufferFill(m_asyncBuffer);
+        Log::msg("Queuing create, write and close...");
+        AsyncIO::Batch batch;
+        AsyncFile file;
+        if (!queued(AsyncIO::open(file, fs, fileName, FileMode::write | FileMode::createAlways)) ||
+            !queued(AsyncIO::write(file, m_asyncBuffer, bufferSize - slack)) ||
+            !queued(AsyncIO::close(file), asyncWritten))
+        {
+            if (file != AsyncIO::noFile) AsyncIO::close(file);
+            return asyncDone(false, "Queue full!");
+        }
+        return true;
+    }
+
+    /// @returns True while the asynchronous test started with `asyncAPI()` runs.
+    static inline bool asyncPending() { return m_asyncFileSystem.load() != nullptr; }
+
+    /// @returns True if the last asynchronous test passed.
+    static inline bool asyncPassed() { return m_asyncPassed; }
+
 private:
 
+    /// @brief Writes a test file of the specified size, copies it to the other file system with verification, then deletes both.
+    /// @param source Source file system pointer.
+    /// @param target Target file system pointer.
+    /// @param fileName Test file name.
+    /// @param size Test file size in bytes.
+    /// @returns True if passed, false if failed.
+    static bool copyTest(const FileSystem* source, const FileSystem* target, const char* fileName, size_t size)
+    {
+        {
+            File file(source, fileName, FileMode::write | FileMode::createAlways);
+            bufferFill(m_asyncBuffer);
+            bool isCreated = file;
+            for (size_t offset = 0; isCreated && offset < size; offset += bufferSize)
+                isCreated = file.write(m_asyncBuffer, std::min(size - offset, bufferSize));
+            if (!isCreated)
+            {
+                Log::msg(LogMessage::error, "Create failed!");
+                return false;
+            }
+        }
+        Log::msg("Copying %lu bytes...", static_cast<unsigned long>(size));
+        const bool isCopied = copy(source, fileName, target, fileName, [](const CopyEngine::Progress& progress)
+        {
+            if (progress.fileCopied == progress.fileSize) Log::msg("Copied %lu bytes.", static_cast<unsigned long>(progress.fileCopied));
+            return true;
+        }, true);
+        fileDelete(source, fileName);
+        File::FileOffset copiedSize = 0;
+        if (isCopied)
+        {
+            File file(target, fileName, FileMode::read);
+            if (!file || !file.size(copiedSize)) copiedSize = size + 1;
+        }
+        if (!isCopied || copiedSize != size)
+        {
+            Log::msg(LogMessage::error, "Copy or verification failed!");
+            fileDelete(target, fileName);
+            return false;
+        }
+        if (!fileDelete(target, fileName))
+        {
+            Log::msg(LogMessage::error, "Delete failed!");
+            return false;
+        }
+        return true;
+    }
+
+    /// @param fs File system pointer.
+    /// @param directoryName Tree root directory name.
+    /// @param level Directory level, 0 for the root.
+    /// @returns The tree copy test directory path of the level.
+    static Path treePath(const FileSystem* fs, const char* directoryName, size_t level)
+    {
+        Path path(fs, "%s", directoryName);
+        for (uint32_t i = 1; i <= level; ++i) path.join("d").append(i);
+        return path;
+    }
+
+    /// @brief Deletes the tree copy test directories and files, the deepest first. The missing ones are ignored.
+    /// @param fs File system pointer.
+    /// @param directoryName Tree root directory name.
+    /// @returns True if the tree root directory was deleted.
+    static bool treeDelete(const FileSystem* fs, const char* directoryName)
+    {
+        for (size_t level = treeLevels; level-- > 0; )
+        {
+            Path directory = treePath(fs, directoryName, level);
+            for (uint32_t i = 0; i < treeFiles; ++i)
+            {
+                Path path(directory);
+                path.join("f").append(i).append(".bin");
+                fileDelete(fs, "%s", path.relativePath());
+            }
+            if (!directoryDelete(fs, "%s", directory.relativePath()) && !level) return false;
+        }
+        return true;
+    }
+
+    /// @brief Sets the asynchronous test continuations.
+    /// @param result Asynchronous result pointer.
+    /// @param next Optional continuation called on success.
+    /// @returns True if the request was queued.
+    static bool queued(AsyncResultT<size_t>* result, void(*next)(size_t) = nullptr)
+    {
+        if (!result) return false;
+        result->failed(asyncFailed);
+        if (next) result->then(next);
+        return true;
+    }
+
+    /// @brief Marks the asynchronous test failed, called from the application thread.
+    static void asyncFailed()
+    {
+        Log::msg(LogMessage::error, "Asynchronous operation failed!");
+        m_asyncFailed = true;
+    }
+
+    /// @brief Queues reading the file back when the written file is closed.
+    static void asyncWritten(size_t)
+    {
+        if (m_asyncFailed) { asyncDone(false, "Write failed!"); return; }
+        bufferClear(m_asyncBuffer);
+        m_asyncLength = 0;
+        Log::msg("Queuing open, read and close...");
+        AsyncIO::Batch batch;
+        AsyncFile file;
+        if (!queued(AsyncIO::open(file, m_asyncFileSystem, m_asyncFileName, FileMode::read)) ||
+            !queued(AsyncIO::read(file, m_asyncBuffer, bufferSize), [](size_t length) { m_asyncLength = length; }) ||
+            !queued(AsyncIO::close(file), asyncRead))
+        {
+            if (file != AsyncIO::noFile) AsyncIO::close(file);
+            asyncDone(false, "Queue full!");
+        }
+    }
+
+    /// @brief Verifies the data read when the file is closed.
+    static void asyncRead(size_t)
+    {
+        if (m_asyncFailed) asyncDone(false, "Read failed!");
+        else if (m_asyncLength != bufferSize - slack) asyncDone(false, "Invalid file size!");
+        else if (!bufferTest(m_asyncBuffer)) asyncDone(false, "Invalid file data!");
+        else if (!fileDelete(m_asyncFileSystem, m_asyncFileName)) asyncDone(false, "Delete failed!");
+        else asyncDone(true, "SUCCESS!");
+    }
+
+    /// @brief Ends the asynchronous test.
+    /// @param isPassed True if passed.
+    /// @param message Message to log.
+    /// @returns The `isPassed` value.
+    static bool asyncDone(bool isPassed, const char* message)
+    {
+        if (isPassed) Log::msg(message);
+        else Log::msg(LogMessage::error, message);
+        cacheStatistics(m_asyncFileSystem);
+        m_asyncPassed = isPassed;
+        m_asyncFileSystem = nullptr;
+        return isPassed;
+    }
+
     /// @brief Fills the buffer with zeroes.
     /// @param buffer The buffer pointer.
     static void bufferClear(char* buffer)
@@ -153,6 +837,15 @@ private:
         return (offset & 0xffu) ^ 0xAA; // We flip every other bit of subsequent values to make them a little less boring.
     }
 
+    static inline uint32_t m_treeSkipped = {};                           // The number of directories skipped by the tree copy test.
+    static inline std::atomic<const FileSystem*> m_asyncFileSystem = {}; // Asynchronous test file system, set while the test runs.
+    static inline const char* m_asyncFileName = {};                      // Asynchronous test file name.
+    static inline size_t m_asyncLength = {};                             // The number of bytes read by the asynchronous test.
+    static inline bool m_asyncFailed = {};                               // Set when an asynchronous test operation failed.
+    static inline bool m_asyncPassed = {};                               // The result of the last asynchronous test.
+    static inline char m_asyncBuffer[bufferSize] = {};                   // Asynchronous test buffer, it must outlive the requests.
+    alignas(32) static inline uint8_t m_benchmarkBuffer[Benchmark::maxBlockSize] __attribute__((section(WTK_FS_BENCHMARK_SECTION))); // Benchmark buffer, the largest block.
+
 };
 
 }
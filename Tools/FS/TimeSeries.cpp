@@ -0,0 +1,304 @@
+/**
+ * @file        TimeSeries.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Chunked time-series store with a time index. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "TimeSeries.hpp"
+#include "API.hpp"
+#include "BufferedFile.hpp"
+#include <algorithm>
+#include <cstring>
+
+static constexpr const char* dataName = "series.dat";   // Data file name.
+static constexpr const char* indexName = "series.idx";  // Index file name.
+static constexpr size_t readSamples = 32;               // The number of samples read from the data file at a time.
+
+FS::TimeSeries::TimeSeries(StoredSample* buffer, size_t capacity)
+    : m_buffer(buffer), m_capacity(capacity), m_count(0), m_fs(nullptr), m_directory(), m_chunkDuration(defaultChunkDuration),
+      m_chunks(0), m_dataSize(0), m_chunkFirst(0), m_first(0), m_last(0), m_lock() { }
+
+FS::TimeSeries::~TimeSeries()
+{
+    close();
+}
+
+bool FS::TimeSeries::open(const FileSystem* fs, const char* directory, uint32_t chunkDuration)
+{
+    if (!fs || !directory || !m_buffer || !m_capacity) return false;
+    m_lock.acquire();
+    if (isOpen()) write();
+    m_fs = nullptr;
+    m_count = 0;
+    m_chunks = 0;
+    m_dataSize = 0;
+    m_first = m_last = 0;
+    m_chunkDuration = chunkDuration ? chunkDuration : defaultChunkDuration;
+    std::strncpy(m_directory, directory, Path::maxLength);
+    m_directory[Path::maxLength] = 0;
+    bool isOpen = directoryExists(fs, "%s", m_directory) || directoryCreate(fs, "%s", m_directory);
+    if (isOpen)
+    {
+        m_fs = fs;
+        Path indexPath = path(indexName);
+        File index(indexPath, FileMode::read);
+        File::FileOffset size = 0;
+        if (index && index.size(size)) m_chunks = static_cast<uint32_t>(size / sizeof(Chunk)); // A torn entry is overwritten.
+        Chunk chunk;
+        if (m_chunks)
+        {
+            isOpen = readChunk(index, m_chunks - 1, chunk);
+            m_dataSize = chunk.offset + chunk.count * sizeof(StoredSample);
+            m_last = chunk.first + chunk.duration;
+            isOpen = isOpen && readChunk(index, 0, chunk);
+            m_first = chunk.first;
+        }
+        if (!isOpen) m_fs = nullptr;
+    }
+    m_lock.release();
+    return isOpen;
+}
+
+bool FS::TimeSeries::close()
+{
+    m_lock.acquire();
+    const bool isWritten = !isOpen() || write();
+    m_fs = nullptr;
+    m_count = 0;
+    m_lock.release();
+    return isWritten;
+}
+
+bool FS::TimeSeries::append(Time time, float value)
+{
+    m_lock.acquire();
+    const bool isEmpty = !m_chunks && !m_count;
+    bool isAdded = isOpen() && (isEmpty || time >= m_last);
+    if (isAdded && m_count && (time / m_chunkDuration != m_chunkFirst / m_chunkDuration || m_count == m_capacity))
+        isAdded = write();
+    if (isAdded)
+    {
+        if (isEmpty) m_first = time;
+        if (!m_count) m_chunkFirst = time;
+        m_buffer[m_count++] = { static_cast<uint32_t>(time - m_chunkFirst), value };
+        m_last = time;
+    }
+    m_lock.release();
+    return isAdded;
+}
+
+bool FS::TimeSeries::flush()
+{
+    m_lock.acquire();
+    const bool isWritten = isOpen() && write();
+    m_lock.release();
+    return isWritten;
+}
+
+bool FS::TimeSeries::range(Time& first, Time& last)
+{
+    m_lock.acquire();
+    const bool isFound = isOpen() && (m_chunks || m_count);
+    if (isFound)
+    {
+        first = m_first;
+        last = m_last;
+    }
+    m_lock.release();
+    return isFound;
+}
+
+FS::ReadResult FS::TimeSeries::read(Time from, Time to, Sample* samples, size_t count)
+{
+    /// @brief Copies the samples to the array.
+    struct Reader final : Visitor
+    {
+        Reader(Sample* samples, size_t count) : samples(samples), count(count), length(0) { }
+        bool chunk(const Chunk&) override { return true; }
+        bool sample(Time time, float value) override
+        {
+            samples[length++] = { time, value };
+            return length < count;
+        }
+        Sample* samples;
+        size_t count;
+        size_t length;
+    };
+
+    if (!samples || !count) return {};
+    Reader reader(samples, count);
+    if (!scan(from, to, reader)) return {};
+    return reader.length;
+}
+
+bool FS::TimeSeries::downsample(Time from, Time to, Bucket* buckets, size_t count)
+{
+    /// @brief Merges the chunk summaries and the samples into the buckets.
+    struct Sampler final : Visitor
+    {
+        Sampler(Time from, Time to, Bucket* buckets, size_t count) : from(from), to(to), buckets(buckets), count(count) { }
+
+        /// @returns The index of the bucket containing the time.
+        inline size_t bucketOf(Time time) const { return static_cast<size_t>((time - from) * count / (to - from)); }
+
+        /// @brief Merges the values into the bucket.
+        static void merge(Bucket& bucket, float min, float max, float mean, uint32_t n)
+        {
+            if (!bucket.count)
+            {
+                bucket = { min, max, mean, n };
+                return;
+            }
+            bucket.min = std::min(bucket.min, min);
+            bucket.max = std::max(bucket.max, max);
+            bucket.count += n;
+            bucket.mean += (mean - bucket.mean) * n / bucket.count;
+        }
+
+        bool chunk(const Chunk& chunk) override
+        {
+            const Time last = chunk.first + chunk.duration;
+            if (chunk.first < from || last >= to || bucketOf(chunk.first) != bucketOf(last)) return true;
+            merge(buckets[bucketOf(chunk.first)], chunk.min, chunk.max, chunk.mean, chunk.count);
+            return false;
+        }
+
+        bool sample(Time time, float value) override
+        {
+            merge(buckets[bucketOf(time)], value, value, value, 1);
+            return true;
+        }
+
+        Time from;
+        Time to;
+        Bucket* buckets;
+        size_t count;
+    };
+
+    if (!buckets || !count) return false;
+    std::memset(buckets, 0, count * sizeof(Bucket));
+    if (from >= to) return true;
+    Sampler sampler(from, to, buckets, count);
+    return scan(from, to, sampler);
+}
+
+bool FS::TimeSeries::scan(Time from, Time to, Visitor& visitor)
+{
+    if (from >= to) return true;
+    m_lock.acquire();
+    const bool isReady = isOpen();
+    const uint32_t end = m_chunks;
+    m_lock.release();
+    if (!isReady) return false;
+    bool isEnd = false;
+    uint32_t index = 0;
+    if (end && (!findChunk(from, end, index) || !scanChunks(from, to, index, end, visitor, isEnd))) return false;
+    m_lock.acquire();
+    bool isDone = isEnd || end >= m_chunks || scanChunks(from, to, end, m_chunks, visitor, isEnd); // Written meanwhile.
+    for (size_t i = 0; isDone && !isEnd && i < m_count; ++i)
+    {
+        const Time time = m_chunkFirst + m_buffer[i].offset;
+        if (time >= to) break;
+        if (time >= from) isEnd = !visitor.sample(time, m_buffer[i].value);
+    }
+    m_lock.release();
+    return isDone;
+}
+
+bool FS::TimeSeries::scanChunks(Time from, Time to, uint32_t index, uint32_t end, Visitor& visitor, bool& isEnd)
+{
+    Path indexPath = path(indexName);
+    Path dataPath = path(dataName);
+    File indexFile(indexPath, FileMode::read);
+    File dataFile(dataPath, FileMode::read);
+    if (!indexFile || !indexFile.seek(index * sizeof(Chunk))) return false;
+    BufferedFileT<16 * sizeof(Chunk)> entries(indexFile);
+    StoredSample samples[readSamples];
+    for (Chunk chunk; index < end && !isEnd; ++index)
+    {
+        if (!entries.read(chunk)) return false;
+        if (chunk.first >= to)
+        {
+            isEnd = true;
+            break;
+        }
+        if (chunk.first + chunk.duration < from || !visitor.chunk(chunk)) continue;
+        if (!dataFile || !dataFile.seek(chunk.offset)) return false;
+        for (uint32_t done = 0; done < chunk.count && !isEnd;)
+        {
+            const size_t length = std::min<size_t>(chunk.count - done, readSamples);
+            ReadResult result = dataFile.read(samples, length * sizeof(StoredSample));
+            if (!result.has_value() || result.value() != length * sizeof(StoredSample)) return false;
+            for (size_t i = 0; i < length && !isEnd; ++i)
+            {
+                const Time time = chunk.first + samples[i].offset;
+                if (time >= to) isEnd = true;
+                else if (time >= from) isEnd = !visitor.sample(time, samples[i].value);
+            }
+            done += length;
+        }
+    }
+    return true;
+}
+
+bool FS::TimeSeries::findChunk(Time time, uint32_t end, uint32_t& index)
+{
+    Path indexPath = path(indexName);
+    File file(indexPath, FileMode::read);
+    if (!file) return false;
+    uint32_t low = 0, high = end;
+    Chunk chunk;
+    while (low < high)
+    {
+        const uint32_t middle = low + (high - low) / 2;
+        if (!readChunk(file, middle, chunk)) return false;
+        if (chunk.first + chunk.duration < time) low = middle + 1;
+        else high = middle;
+    }
+    index = low;
+    return true;
+}
+
+bool FS::TimeSeries::readChunk(File& file, uint32_t index, Chunk& chunk)
+{
+    return file.seek(index * sizeof(Chunk)) && file.read(chunk);
+}
+
+bool FS::TimeSeries::write()
+{
+    if (!m_count) return true;
+    Chunk chunk = { m_chunkFirst, m_buffer[m_count - 1].offset, m_dataSize, static_cast<uint32_t>(m_count),
+        m_buffer[0].value, m_buffer[0].value, 0 };
+    double sum = 0;
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        chunk.min = std::min(chunk.min, m_buffer[i].value);
+        chunk.max = std::max(chunk.max, m_buffer[i].value);
+        sum += m_buffer[i].value;
+    }
+    chunk.mean = static_cast<float>(sum / m_count);
+    const size_t size = m_count * sizeof(StoredSample);
+    { // The samples first, an index entry never points past the data written.
+        Path dataPath = path(dataName);
+        File data(dataPath, FileMode::write | FileMode::openAlways);
+        if (!data || !data.seek(m_dataSize) || !data.write(m_buffer, size) || !data.flush()) return false;
+    }
+    {
+        Path indexPath = path(indexName);
+        File index(indexPath, FileMode::write | FileMode::openAlways);
+        if (!index || !index.seek(m_chunks * sizeof(Chunk)) || !index.write(chunk) || !index.flush()) return false;
+    }
+    m_dataSize += size;
+    ++m_chunks;
+    m_count = 0;
+    return true;
+}
+
+FS::Path FS::TimeSeries::path(const char* name) const
+{
+    return Path(m_fs, "%s/%s", m_directory, name);
+}
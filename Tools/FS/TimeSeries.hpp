@@ -0,0 +1,225 @@
+/**
+ * @file        TimeSeries.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Chunked time-series store with a time index. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @remarks     A series is a directory with 2 files. `series.dat` holds the samples, chunk after chunk,
+ *              each sample is the time offset from the chunk start and the value. `series.idx` holds one fixed size entry
+ *              per chunk: the chunk time span, its data offset, the number of samples and the value minimum, maximum and mean.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "target.h"
+#include "File.hpp"
+#include "OS/Mutex.hpp"
+
+namespace FS
+{
+
+/// @brief Records a value sampled over time and reads any time range back without scanning the recording from the start.
+/// @remarks The appended samples are buffered until the chunk duration passes or the buffer is full,
+///          then the chunk is written to the data file and its summary to the index file,
+///          each flushed to the media before the next, so a power loss leaves no index entry pointing past the data.
+///          The queries find the first chunk with a binary search over the index file,
+///          the downsampled queries use the chunk summaries instead of the samples when a chunk fits in one bucket,
+///          so a query costs about the number of chunks in the range, not the size of the recording.
+///          The buffered samples are included in the queries. The queries don't block `append()` while reading the files.
+///          Thread safe, but don't close the series while it is queried.
+class TimeSeries
+{
+
+public:
+
+    using Time = uint64_t; ///< Time in milliseconds.
+
+    static constexpr uint32_t defaultChunkDuration = WTK_FS_TS_CHUNK; ///< The default chunk duration in milliseconds.
+
+    /// @brief Sample buffer item, also the sample stored in the data file.
+    struct StoredSample final
+    {
+        uint32_t offset;    ///< The time from the chunk start in milliseconds.
+        float value;        ///< Sample value.
+    };
+
+    /// @brief Sample read.
+    struct Sample final
+    {
+        Time time;          ///< Sample time.
+        float value;        ///< Sample value.
+    };
+
+    /// @brief Downsampled time range.
+    struct Bucket final
+    {
+        float min;          ///< The minimal value.
+        float max;          ///< The maximal value.
+        float mean;         ///< The mean value.
+        uint32_t count;     ///< The number of samples, zero if there are no samples in the range.
+    };
+
+    TimeSeries(const TimeSeries&) = delete; // This type should not be copied.
+    TimeSeries(TimeSeries&&) = delete; // This type should not be moved.
+
+    /// @brief Creates a closed series using the caller provided sample buffer.
+    /// @param buffer Sample buffer pointer.
+    /// @param capacity The number of samples in the buffer, the maximal number of samples in a chunk.
+    TimeSeries(StoredSample* buffer, size_t capacity);
+
+    /// @brief Writes the buffered samples and closes the series.
+    ~TimeSeries();
+
+    /// @brief Opens the series, creating the directory if needed. The new samples are appended to the existing ones.
+    /// @param fs File system pointer.
+    /// @param directory Series directory path relative to the file system root.
+    /// @param chunkDuration Chunk duration in milliseconds, the time resolution of the index. Default: `WTK_FS_TS_CHUNK`.
+    /// @returns True if open.
+    bool open(const FileSystem* fs, const char* directory, uint32_t chunkDuration = defaultChunkDuration);
+
+    /// @brief Writes the buffered samples and closes the series.
+    /// @returns True if the buffered samples were written.
+    bool close();
+
+    /// @returns True if the series is open.
+    inline bool isOpen() const { return m_fs != nullptr; }
+
+    /// @returns True if the series is open.
+    inline operator bool() const { return m_fs != nullptr; }
+
+    /// @brief Adds a sample. Writes the buffered chunk first when the sample belongs to the next chunk or the buffer is full.
+    /// @param time Sample time, not earlier than the previous sample time.
+    /// @param value Sample value.
+    /// @returns True if added. False if the series is closed, the time is earlier than the last sample or the write failed.
+    bool append(Time time, float value);
+
+    /// @brief Writes the buffered samples as a chunk and flushes it to the media.
+    /// @returns True if written or nothing to write.
+    bool flush();
+
+    /// @brief Gets the time range of the samples.
+    /// @param first Set to the time of the first sample.
+    /// @param last Set to the time of the last sample.
+    /// @returns True if there are samples.
+    bool range(Time& first, Time& last);
+
+    /// @brief Reads the samples from the time range, oldest first.
+    /// @param from Start time, inclusive.
+    /// @param to End time, exclusive.
+    /// @param samples Sample array pointer.
+    /// @param count The number of samples in the array.
+    /// @returns The number of samples read, or an empty value if the read failed.
+    ReadResult read(Time from, Time to, Sample* samples, size_t count);
+
+    /// @brief Splits the time range into equal buckets and gets the minimal, maximal and mean value of each one.
+    /// @param from Start time, inclusive.
+    /// @param to End time, exclusive.
+    /// @param buckets Bucket array pointer, one bucket for each displayed point.
+    /// @param count The number of buckets.
+    /// @returns True if done, false if the read failed.
+    bool downsample(Time from, Time to, Bucket* buckets, size_t count);
+
+private:
+
+    /// @brief Index file entry.
+    struct Chunk final
+    {
+        Time first;         // The time of the first sample.
+        uint32_t duration;  // The time from the first to the last sample.
+        uint32_t offset;    // The offset of the first sample in the data file.
+        uint32_t count;     // The number of samples.
+        float min;          // The minimal value.
+        float max;          // The maximal value.
+        float mean;         // The mean value.
+    };
+
+    /// @brief Receives the chunks and the samples of a query.
+    struct Visitor
+    {
+        /// @brief Receives a chunk overlapping the query range.
+        /// @param chunk Chunk reference.
+        /// @returns True to receive the chunk samples, false to skip them.
+        virtual bool chunk(const Chunk& chunk) = 0;
+
+        /// @brief Receives a sample from the query range.
+        /// @param time Sample time.
+        /// @param value Sample value.
+        /// @returns True to continue, false to end the query.
+        virtual bool sample(Time time, float value) = 0;
+    };
+
+    /// @brief Passes the chunks and the samples of the time range to the visitor.
+    /// @param from Start time, inclusive.
+    /// @param to End time, exclusive.
+    /// @param visitor Visitor reference.
+    /// @returns True if done, false if a read failed.
+    bool scan(Time from, Time to, Visitor& visitor);
+
+    /// @brief Passes the chunks from the index file to the visitor, starting at the index.
+    /// @param from Start time, inclusive.
+    /// @param to End time, exclusive.
+    /// @param index The first chunk index.
+    /// @param end The chunk index to stop at.
+    /// @param visitor Visitor reference.
+    /// @param isEnd Set when the visitor ended the query.
+    /// @returns True if done, false if a read failed.
+    bool scanChunks(Time from, Time to, uint32_t index, uint32_t end, Visitor& visitor, bool& isEnd);
+
+    /// @brief Finds the first chunk that ends at or after the specified time with a binary search over the index file.
+    /// @param time Time.
+    /// @param end The number of chunks searched.
+    /// @param index Set to the chunk index, `end` if all chunks end earlier.
+    /// @returns True if found, false if a read failed.
+    bool findChunk(Time time, uint32_t end, uint32_t& index);
+
+    /// @brief Reads the chunk entry from the index file.
+    /// @param file Index file reference.
+    /// @param index Chunk index.
+    /// @param chunk Chunk reference.
+    /// @returns True if read.
+    static bool readChunk(File& file, uint32_t index, Chunk& chunk);
+
+    /// @brief Writes the buffered samples as a chunk, flushing the data file, then the index file, the caller holds the lock.
+    /// @returns True if written or nothing to write.
+    bool write();
+
+    /// @param name File name.
+    /// @returns The path of the series file.
+    Path path(const char* name) const;
+
+    StoredSample* m_buffer;                 // Sample buffer.
+    size_t m_capacity;                      // The number of samples in the buffer.
+    size_t m_count;                         // The number of buffered samples.
+    const FileSystem* m_fs;                 // File system pointer, `nullptr` when closed.
+    char m_directory[Path::maxLength + 1];  // Series directory path.
+    uint32_t m_chunkDuration;               // Chunk duration.
+    uint32_t m_chunks;                      // The number of chunks in the index file.
+    uint32_t m_dataSize;                    // The size of the samples written to the data file.
+    Time m_chunkFirst;                      // The time of the first buffered sample.
+    Time m_first;                           // The time of the first sample.
+    Time m_last;                            // The time of the last sample.
+    OS::Mutex m_lock;                       // Series state lock.
+
+};
+
+/// @brief Chunked time-series store with the internal sample buffer.
+/// @tparam TCapacity The number of samples buffered, the maximal number of samples in a chunk.
+template<size_t TCapacity = WTK_FS_TS_SAMPLES>
+class TimeSeriesT final : public TimeSeries
+{
+
+public:
+
+    /// @brief Creates a closed series.
+    TimeSeriesT() : TimeSeries(m_storage, TCapacity) { }
+
+private:
+
+    StoredSample m_storage[TCapacity]; // Sample buffer storage.
+
+};
+
+}
@@ -0,0 +1,190 @@
+/**
+ * @file        WriteScheduler.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Write scheduler merging the concurrent file writes into per-file bursts. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#include "WriteScheduler.hpp"
+#include <algorithm>
+#include <cstring>
+
+FS::ScheduledFile::ScheduledFile(File& file, uint8_t* buffer, size_t size, bool isPriority)
+    : m_file(file), m_buffer(buffer), m_mask(0), m_head(0), m_tail(0), m_maxPending(0), m_stalls(0), m_bursts(0), m_written(0),
+      m_isPriority(isPriority), m_isAttached(false), m_isFailed(false), m_events()
+{
+    while (size >> 1 > m_mask) m_mask = m_mask << 1 | 1; // The largest power of 2 not exceeding the size, minus 1.
+    if (!m_buffer || !size) return;
+    m_events.wait(writtenEvent, OS::noClear, 0); // Creates the event group before the scheduler signals it.
+    m_isAttached = WriteScheduler::attach(*this);
+}
+
+FS::ScheduledFile::~ScheduledFile()
+{
+    flush();
+    if (m_isAttached) WriteScheduler::detach(*this);
+}
+
+bool FS::ScheduledFile::write(const void* buffer, size_t size, OS::TickCount timeout)
+{
+    if (!m_isAttached || m_isFailed || (!buffer && size)) return false;
+    const uint8_t* data = static_cast<const uint8_t*>(buffer);
+    while (size)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t space = m_mask + 1 - (head - m_tail.load(std::memory_order_acquire));
+        if (!space)
+        {
+            ++m_stalls;
+            WriteScheduler::wakeUp();
+            if (!m_events.wait(writtenEvent, OS::waitAny, timeout) || m_isFailed) return false;
+            continue;
+        }
+        const size_t offset = head & m_mask;
+        const size_t length = std::min({ size, space, m_mask + 1 - offset });
+        std::memcpy(m_buffer + offset, data, length);
+        m_head.store(head + length, std::memory_order_release);
+        data += length;
+        size -= length;
+    }
+    const size_t queued = pending();
+    if (queued > m_maxPending) m_maxPending = queued;
+    if (m_isPriority || queued > (m_mask + 1) / 2) WriteScheduler::wakeUp();
+    return true;
+}
+
+bool FS::ScheduledFile::flush(OS::TickCount timeout)
+{
+    if (!m_isAttached) return false;
+    while (pending() && !m_isFailed)
+    {
+        WriteScheduler::wakeUp();
+        if (!m_events.wait(writtenEvent, OS::waitAny, timeout)) return false;
+    }
+    return !m_isFailed;
+}
+
+bool FS::ScheduledFile::close()
+{
+    const bool isWritten = flush();
+    if (m_isAttached) WriteScheduler::detach(*this);
+    m_isAttached = false;
+    m_file.close();
+    return isWritten;
+}
+
+FS::WriteScheduler::Statistics FS::WriteScheduler::statistics()
+{
+    m_lock.acquire();
+    Statistics statistics = m_statistics;
+    statistics.streams = 0;
+    statistics.pending = 0;
+    for (ScheduledFile* stream : m_streams) if (stream)
+    {
+        ++statistics.streams;
+        statistics.pending += stream->pending();
+    }
+    m_lock.release();
+    return statistics;
+}
+
+void FS::WriteScheduler::wakeUp()
+{
+    m_events.signal(wakeUpEvent);
+}
+
+bool FS::WriteScheduler::attach(ScheduledFile& stream)
+{
+    bool isAttached = false;
+    m_lock.acquire();
+    for (ScheduledFile*& slot : m_streams) if (!slot)
+    {
+        slot = &stream;
+        isAttached = true;
+        break;
+    }
+    if (isAttached && !m_thread.active())
+    {
+        m_events.wait(wakeUpEvent, OS::noClear, 0); // Creates the event group before the scheduler thread starts.
+        m_thread.start(schedulerThread, "FS::WriteScheduler", OS::ThreadPriority::normal);
+    }
+    m_lock.release();
+    return isAttached;
+}
+
+void FS::WriteScheduler::detach(ScheduledFile& stream)
+{
+    m_lock.acquire();
+    for (ScheduledFile*& slot : m_streams) if (slot == &stream) slot = nullptr;
+    m_lock.release();
+}
+
+bool FS::WriteScheduler::cycle(bool isWokenUp)
+{
+    m_lock.acquire();
+    ++m_statistics.cycles;
+    if (isWokenUp) ++m_statistics.wakeUps;
+    for (ScheduledFile* stream : m_streams) if (stream && stream->m_isPriority) drain(*stream, SIZE_MAX);
+    const AdapterTypes::Media* served[maxStreams];
+    size_t servedCount = 0;
+    for (size_t i = 0; i < maxStreams; ++i)
+    {
+        const ScheduledFile* first = m_streams[(m_next + i) % maxStreams];
+        if (!first || first->m_isPriority) continue;
+        const AdapterTypes::Media* current = media(*first);
+        if (std::find(served, served + servedCount, current) != served + servedCount) continue;
+        served[servedCount++] = current;
+        for (size_t j = i; j < maxStreams; ++j) // The streams on the same media, back to back.
+        {
+            ScheduledFile* stream = m_streams[(m_next + j) % maxStreams];
+            if (stream && !stream->m_isPriority && media(*stream) == current) drain(*stream, burstSize);
+        }
+    }
+    m_next = (m_next + 1) % maxStreams;
+    bool isBacklogged = false;
+    for (ScheduledFile* stream : m_streams) if (stream && !stream->m_isFailed && stream->pending() >= burstSize) isBacklogged = true;
+    m_lock.release();
+    return isBacklogged;
+}
+
+void FS::WriteScheduler::drain(ScheduledFile& stream, size_t limit)
+{
+    size_t done = 0;
+    while (done < limit && !stream.m_isFailed)
+    {
+        const size_t tail = stream.m_tail.load(std::memory_order_relaxed);
+        const size_t head = stream.m_head.load(std::memory_order_acquire);
+        const size_t offset = tail & stream.m_mask;
+        const size_t length = std::min({ head - tail, limit - done, stream.m_mask + 1 - offset });
+        if (!length) break;
+        if (!stream.m_file.write(stream.m_buffer + offset, length))
+        {
+            stream.m_isFailed = true;
+            stream.m_tail.store(head, std::memory_order_release); // Dropped.
+            break;
+        }
+        stream.m_tail.store(tail + length, std::memory_order_release);
+        done += length;
+    }
+    if (done)
+    {
+        ++stream.m_bursts;
+        ++m_statistics.bursts;
+        stream.m_written += done;
+    }
+    if (done || stream.m_isFailed) stream.m_events.signal(ScheduledFile::writtenEvent);
+}
+
+void FS::WriteScheduler::schedulerThread(OS::ThreadArg arg)
+{
+    (void)arg;
+    bool isBacklogged = false;
+    for (;;)
+    {
+        const bool isWokenUp = !isBacklogged && m_events.wait(wakeUpEvent, OS::waitAny, OS::msToTicks(m_period));
+        isBacklogged = cycle(isWokenUp);
+    }
+}
@@ -0,0 +1,221 @@
+/**
+ * @file        WriteScheduler.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Write scheduler merging the concurrent file writes into per-file bursts. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), File System API.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "target.h"
+#include "File.hpp"
+#include "StaticClass.hpp"
+#include "OS/EventGroup.hpp"
+#include "OS/Mutex.hpp"
+#include "OS/Thread.hpp"
+
+namespace FS
+{
+
+class WriteScheduler;
+
+/// @brief Queues the writes to an open `File`, the `WriteScheduler` thread writes them to the file in large bursts.
+/// @remarks The writes are copied to the caller provided ring buffer and return immediately unless the buffer is full.
+///          Use one writing thread per stream. Don't access the file directly until the stream is closed or discarded.
+///          A priority stream wakes the scheduler on each write and is written first, for the latency sensitive data.
+///          The other streams are written each scheduler period, or sooner when their buffer is half full.
+///          If a file write fails the queued data is dropped and the next writes fail.
+class ScheduledFile
+{
+
+    friend class WriteScheduler;
+
+public:
+
+    ScheduledFile(const ScheduledFile&) = delete; // This type should not be copied.
+    ScheduledFile(ScheduledFile&&) = delete; // This type should not be moved.
+
+    /// @brief Creates a scheduled access to the file using the caller provided ring buffer.
+    /// @param file Open file reference.
+    /// @param buffer Buffer pointer.
+    /// @param size Buffer size in bytes, a power of 2, preferably 2 bursts or more.
+    /// @param isPriority True to write the data as soon as possible, before the other streams.
+    ScheduledFile(File& file, uint8_t* buffer, size_t size, bool isPriority = false);
+
+    /// @brief Waits until the queued data is written and leaves the scheduler.
+    ~ScheduledFile();
+
+    /// @returns True if the stream is served by the scheduler, false if all `WTK_FS_WRITE_STREAMS` were taken.
+    inline bool isAttached() const { return m_isAttached; }
+
+    /// @returns True if the stream is served and no write failed.
+    inline operator bool() const { return m_isAttached && !m_isFailed; }
+
+    /// @returns The number of bytes queued, the queue depth.
+    inline size_t pending() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+
+    /// @returns The largest number of bytes queued at a time.
+    inline size_t maxPending() const { return m_maxPending; }
+
+    /// @returns The number of times a write waited for the buffer space.
+    inline uint32_t stalls() const { return m_stalls; }
+
+    /// @returns The number of bursts written to the file.
+    inline uint32_t bursts() const { return m_bursts; }
+
+    /// @returns The number of bytes written to the file.
+    inline uint64_t written() const { return m_written; }
+
+    /// @brief Queues the data, waiting for the buffer space if needed.
+    /// @param buffer Buffer pointer.
+    /// @param size Number of bytes to write.
+    /// @param timeout The time to wait for the buffer space in RTOS ticks. Default: `waitForever`.
+    /// @returns True if queued. False if the stream is not served, a previous write failed or the time is out.
+    bool write(const void* buffer, size_t size, OS::TickCount timeout = OS::waitForever);
+
+    /// @brief Queues a structure or a primitive type.
+    /// @tparam T  The type of the structure, can also be a primitive type.
+    /// @param data The data reference.
+    /// @returns True if queued. False otherwise.
+    template<typename T> bool write(T& data) { return write(&data, sizeof(data)); }
+
+    /// @brief Wakes the scheduler and waits until the queued data is written.
+    /// @param timeout The time to wait in RTOS ticks. Default: `waitForever`.
+    /// @returns True if written. False if a write failed or the time is out.
+    bool flush(OS::TickCount timeout = OS::waitForever);
+
+    /// @brief Waits until the queued data is written, leaves the scheduler and closes the file.
+    /// @returns True if the queued data was written successfully.
+    bool close();
+
+private:
+
+    static constexpr OS::EventFlags writtenEvent = 1; // The event flag set when the scheduler wrote a burst.
+
+    File& m_file;                       // Underlying file reference.
+    uint8_t* m_buffer;                  // Ring buffer pointer.
+    size_t m_mask;                      // Ring buffer size - 1.
+    std::atomic<size_t> m_head;         // The number of bytes queued, wraps.
+    std::atomic<size_t> m_tail;         // The number of bytes written, wraps.
+    size_t m_maxPending;                // The largest number of bytes queued.
+    uint32_t m_stalls;                  // The number of waits for the buffer space.
+    uint32_t m_bursts;                  // The number of bursts written.
+    uint64_t m_written;                 // The number of bytes written.
+    bool m_isPriority;                  // Priority stream.
+    bool m_isAttached;                  // The stream is served by the scheduler.
+    std::atomic<bool> m_isFailed;       // A file write failed.
+    OS::EventGroup m_events;            // Stream events.
+
+};
+
+/// @brief Scheduled access to an open `File` with the internal ring buffer.
+/// @tparam TSize Buffer size in bytes, a power of 2.
+template<size_t TSize>
+class ScheduledFileT final : public ScheduledFile
+{
+
+    static_assert(TSize && !(TSize & (TSize - 1)), "The buffer size must be a power of 2.");
+
+public:
+
+    /// @brief Creates a scheduled access to the file.
+    /// @param file Open file reference.
+    /// @param isPriority True to write the data as soon as possible, before the other streams.
+    ScheduledFileT(File& file, bool isPriority = false) : ScheduledFile(file, m_storage, TSize, isPriority) { }
+
+private:
+
+    alignas(32) uint8_t m_storage[TSize]; // Ring buffer storage.
+
+};
+
+/// @brief Writes the data queued in the `ScheduledFile` streams from one thread, in large per-file bursts.
+/// @remarks Each cycle writes the priority streams first, all their data. Then the other streams grouped by the media,
+///          so each media gets its files written back to back, up to `burstSize` bytes per stream,
+///          starting from a different stream each cycle, so no stream is starved.
+///          When a stream has more than a burst queued, the next cycle starts at once instead of after the period.
+class WriteScheduler final
+{
+
+    STATIC(WriteScheduler)
+
+    friend class ScheduledFile;
+
+public:
+
+    static constexpr size_t maxStreams = WTK_FS_WRITE_STREAMS;    ///< The maximal number of streams served.
+    static constexpr size_t burstSize = WTK_FS_WRITE_BURST;       ///< The maximal number of bytes of a stream written per cycle.
+
+    /// @brief Scheduler statistics.
+    struct Statistics final
+    {
+        uint32_t cycles;    ///< The number of cycles run.
+        uint32_t wakeUps;   ///< The number of cycles started before the period passed.
+        uint32_t bursts;    ///< The number of bursts written.
+        uint32_t streams;   ///< The number of streams served.
+        size_t pending;     ///< The number of bytes queued in all streams.
+    };
+
+    /// @brief Sets the time between the cycles writing the queued data.
+    /// @param milliseconds Write period in milliseconds. Longer periods make larger bursts and use more buffer space.
+    static inline void setPeriod(uint32_t milliseconds) { m_period = milliseconds ? milliseconds : 1; }
+
+    /// @returns The write period in milliseconds.
+    static inline uint32_t period() { return m_period; }
+
+    /// @brief Gets the scheduler statistics.
+    /// @returns Statistics.
+    static Statistics statistics();
+
+    /// @brief Starts a cycle now.
+    static void wakeUp();
+
+private:
+
+    static constexpr OS::EventFlags wakeUpEvent = 1; // The event flag that starts a cycle before the period passed.
+
+    /// @brief Adds the stream, starts the scheduler thread if not started.
+    /// @param stream Stream reference.
+    /// @returns True if added, false if all slots are taken.
+    static bool attach(ScheduledFile& stream);
+
+    /// @brief Removes the stream. Waits for the current cycle to finish.
+    /// @param stream Stream reference.
+    static void detach(ScheduledFile& stream);
+
+    /// @brief Writes the queued data of the streams once.
+    /// @param isWokenUp True if the cycle was started by `wakeUp()` before the period passed.
+    /// @returns True if a stream has more than a burst still queued.
+    static bool cycle(bool isWokenUp);
+
+    /// @brief Writes the queued data of the stream.
+    /// @param stream Stream reference.
+    /// @param limit The maximal number of bytes to write.
+    static void drain(ScheduledFile& stream, size_t limit);
+
+    /// @param stream Stream reference.
+    /// @returns The media the stream file is stored on.
+    static inline const AdapterTypes::Media* media(const ScheduledFile& stream)
+    {
+        return stream.m_file.fileSystem() ? stream.m_file.fileSystem()->media() : nullptr;
+    }
+
+    /// @brief Scheduler thread loop.
+    /// @param arg Not used.
+    static void schedulerThread(OS::ThreadArg arg);
+
+    static inline ScheduledFile* m_streams[maxStreams] = {};              // Served streams.
+    static inline size_t m_next = {};                                     // The stream slot the next cycle starts with.
+    static inline std::atomic<uint32_t> m_period = WTK_FS_WRITE_PERIOD;   // Write period in milliseconds.
+    static inline Statistics m_statistics = {};                           // Statistics, `pending` not used.
+    static inline OS::ThreadT<WTK_FS_WRITE_STACK> m_thread = {};          // Scheduler thread.
+    static inline OS::EventGroup m_events = {};                           // Scheduler wake-up events.
+    static inline OS::Mutex m_lock = {};                                  // Protects the stream slots.
+
+};
+
+}
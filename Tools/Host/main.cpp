@@ -0,0 +1,102 @@
+/**
+ * @file        main.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Host test runner, runs the toolkit tests on a PC with the `USE_POSIX` build.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @remarks     Build and run with `make -C Tools/Host run`. The file systems are mounted on temporary host directories.
+ *              The exit status is 0 when all tests passed, 1 otherwise.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#if defined(USE_POSIX)
+
+#include "FS/Test.hpp"
+#include "OS/Test.hpp"
+#include "OS/AppThread.hpp"
+#include "OS/Thread.hpp"
+#include "Log.hpp"
+#include <atomic>
+#include <cstdio>
+#include <ftw.h>
+#include <unistd.h>
+
+static char sdDirectory[] = "/tmp/wtk-sd-XXXXXX";       // SD media host directory.
+static char usbDirectory[] = "/tmp/wtk-usb-XXXXXX";     // USB media host directory.
+static FS::AdapterTypes::Media sd = {};                 // SD media.
+static FS::AdapterTypes::Media usb = {};                // USB media.
+static OS::ThreadT<8192> testThread = {};               // Test thread, the application thread runs the task scheduler.
+static int failures = 0;                                // The number of failed tests.
+static std::atomic<int> asyncStart = -1;                // The asynchronous test start result, -1 until started.
+
+/// @brief Counts the failed test.
+/// @param isPassed Test result.
+static void check(bool isPassed)
+{
+    if (!isPassed) ++failures;
+}
+
+/// @brief Mounts a temporary host directory as the file system root.
+/// @param media Media reference.
+/// @param directory Directory name template.
+/// @param type Media type.
+/// @param root File system root.
+/// @returns True if mounted.
+static bool mount(FS::AdapterTypes::Media& media, char* directory, FS::MediaType type, const char* root)
+{
+    if (!mkdtemp(directory)) return false;
+    media.directory = directory;
+    FS::MediaServices::registerType(type, root);
+    return FS::MediaServices::mount(media, root);
+}
+
+/// @brief Removes a temporary host directory with its contents.
+/// @param directory Directory path.
+static void removeAll(const char* directory)
+{
+    nftw(directory, [](const char* path, const struct stat*, int, struct FTW*) { return ::remove(path); }, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+/// @brief Runs the tests, then ends the process with the result.
+static void testThreadEntry(OS::ThreadArg)
+{
+    const FS::FileSystem* source = FS::FileSystemTable::find(FS_SD_ROOT);
+    const FS::FileSystem* target = FS::FileSystemTable::find(FS_USB_ROOT);
+    check(OS::Test::ringBuffer());
+    check(OS::Test::seqlock());
+    check(OS::Test::timers());
+    check(FS::Test::fileAPI(source, "test.bin"));
+    check(FS::Test::bufferedAPI(source, "buffered.bin"));
+    check(FS::Test::directoryAPI(source, "directory"));
+    check(FS::Test::copyAPI(source, target, "copy.bin"));
+    check(FS::Test::copyTreeAPI(source, target, "tree"));
+    check(FS::Test::kvAPI(source, "kv"));
+    check(FS::Test::timeSeriesAPI(source, "ts"));
+    check(FS::Test::compressionAPI(source, "log.lz4"));
+    check(FS::Test::schedulerAPI(source));
+    check(FS::Test::benchmark(source, "benchmark"));
+    OS::AppThread::sync([] { asyncStart = FS::Test::asyncAPI(FS::FileSystemTable::find(FS_SD_ROOT), "async.bin"); });
+    while (asyncStart < 0 || FS::Test::asyncPending()) OS::delay(1); // The requests are submitted and completed in the application thread.
+    check(asyncStart && FS::Test::asyncPassed());
+    if (failures) Log::msg(LogMessage::error, "%d test(s) failed!", failures);
+    else Log::msg("All tests passed.");
+    removeAll(sdDirectory);
+    removeAll(usbDirectory);
+    _exit(failures ? 1 : 0);
+}
+
+int main()
+{
+    Log::init();
+    if (!mount(sd, sdDirectory, FS::MediaType::SD, FS_SD_ROOT) || !mount(usb, usbDirectory, FS::MediaType::USB, FS_USB_ROOT))
+    {
+        std::perror("Can't create the test directories");
+        return 1;
+    }
+    testThread.start(testThreadEntry, "Test", OS::ThreadPriority::normal);
+    OS::AppThread::start();
+}
+
+#endif
@@ -9,19 +9,29 @@
  */
 
 #include "Log.hpp"
+#if defined(USE_POSIX)
+#include "LogPOSIX.hpp"
+#else
 #include "LogITM.hpp"
 #include "LogUART.hpp"
+#endif
 
 void Log::init(bool isRelase)
 {
     level(isRelase ? LogMessage::info : LogMessage::detail);
+#if defined(USE_POSIX)
+    m_output = LogPOSIX::getInstance(m_pool);
+#else
     m_output = LogITM::getInstance(m_pool);
+#endif
 }
 
+#if !defined(USE_POSIX)
 void Log::initUART(UART_HandleTypeDef *huart)
 {
     m_output = LogUART::getInstance(huart, m_pool);
 }
+#endif
 
 void Log::startAsync(void)
 {
@@ -24,13 +24,15 @@ class Log final
 
 public:
 
-    /// @brief Initializes the default log level.
+    /// @brief Initializes the default log level and the ITM output, the standard output on the host build.
     /// @param isRelase 1: RELEASE build, fewer messages. 0: DEBUG build, more messages.
     static void init(bool isRelase = false);
 
+#if !defined(USE_POSIX)
     /// @brief Initializes the logger with the UART output.
     /// @param huart UART handle pointer.
     static void initUART(UART_HandleTypeDef* huart);
+#endif
 
     /// @brief Starts asynchronous operation as soon as the RTOS is started.
     /// @remarks If not defined in the current output, it does nothing.
@@ -0,0 +1,93 @@
+/**
+ * @file        Log2Histogram.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A histogram with power of 2 bins for latency and duration measurements. Header only.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @remarks     Adding a sample costs a count leading zeros instruction and 4 increments.
+ *              The histogram has no RTOS or HAL dependencies, so it can be compiled and tested on the host.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief A histogram of 32-bit values with power of 2 bins.
+/// @remarks Bin 0 counts values 0 and 1, bin `n` counts values from `2^n` to `2^(n+1) - 1`.
+///          Not synchronized: add samples from one context only.
+class Log2Histogram
+{
+
+public:
+
+    static constexpr size_t bins = 32; ///< The number of bins.
+
+    /// @brief Creates an empty histogram.
+    Log2Histogram() : m_counts(), m_count(0), m_max(0), m_total(0) { }
+
+    /// @brief Adds a sample.
+    /// @param value Sample value.
+    inline void add(uint32_t value)
+    {
+        ++m_counts[binOf(value)];
+        ++m_count;
+        m_total += value;
+        if (value > m_max) m_max = value;
+    }
+
+    /// @brief Removes all samples.
+    inline void clear() { *this = Log2Histogram(); }
+
+    /// @returns The number of samples.
+    inline uint32_t count() const { return m_count; }
+
+    /// @returns The maximal sample value.
+    inline uint32_t max() const { return m_max; }
+
+    /// @returns The average sample value, zero if empty.
+    inline uint32_t mean() const { return m_count ? static_cast<uint32_t>(m_total / m_count) : 0; }
+
+    /// @param bin Bin index.
+    /// @returns The number of samples in the bin.
+    inline uint32_t at(size_t bin) const { return m_counts[bin]; }
+
+    /// @brief Estimates a percentile as the upper bound of the bin it falls into, limited by the maximal value.
+    /// @param percent Percentile, 0 to 100.
+    /// @returns The value not exceeded by `percent` of the samples, zero if empty.
+    uint32_t percentile(uint32_t percent) const
+    {
+        if (!m_count) return 0;
+        const uint64_t rank = (static_cast<uint64_t>(m_count) * percent + 99) / 100;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < bins; ++i)
+        {
+            sum += m_counts[i];
+            if (sum >= rank && sum) return upperBound(i) < m_max ? upperBound(i) : m_max;
+        }
+        return m_max;
+    }
+
+    /// @param value Sample value.
+    /// @returns The index of the bin the value falls into.
+    static inline size_t binOf(uint32_t value) { return value > 1 ? 31 - __builtin_clz(value) : 0; }
+
+    /// @param bin Bin index.
+    /// @returns The smallest value of the bin.
+    static inline uint32_t lowerBound(size_t bin) { return bin ? 1UL << bin : 0; }
+
+    /// @param bin Bin index.
+    /// @returns The largest value of the bin.
+    static inline uint32_t upperBound(size_t bin) { return bin < bins - 1 ? (2UL << bin) - 1 : UINT32_MAX; }
+
+private:
+
+    uint32_t m_counts[bins];    // Sample counts per bin.
+    uint32_t m_count;           // Total number of samples.
+    uint32_t m_max;             // The maximal sample value.
+    uint64_t m_total;           // The sum of all samples.
+
+};
@@ -20,7 +20,9 @@ EXTERN_C_BEGIN
 
 void log_level(bool isRelease) { Log::init(isRelease); }
 
+#if !defined(USE_POSIX)
 void log_init(UART_HandleTypeDef* huart) { Log::initUART(huart); }
+#endif
 
 void log_msg(uint8_t severity, const char* format, ...)
 {
@@ -8,6 +8,8 @@
  * @copyright	(c)2024 CodeDog, All rights reserved.
  */
 
+#if !defined(USE_POSIX)
+
 #include "LogITM.hpp"
 
 LogITM::LogITM(ILogMessagePool& pool) :
@@ -90,3 +92,5 @@ void LogITM::senderThreadEntry(OS::ThreadArg)
     } // Then it waits for the next signal.
     m_instance->m_isAsync = false;
 }
+
+#endif
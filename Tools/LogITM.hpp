@@ -10,6 +10,8 @@
 
 #pragma once
 
+#if !defined(USE_POSIX)
+
 #include "hal.h"
 #include "ILogOutput.hpp"
 #include "ILogMessagePool.hpp"
@@ -112,7 +114,7 @@ private:
 
 private:
     ILogMessagePool& m_pool;                    // Log message pool reference.
-    OS::Thread m_thread;                        // Sender thread.
+    OS::ThreadT<WTK_LOG_THREAD_STACK> m_thread; // Sender thread.
     OS::Semaphore m_semaphore;                  // Sender thread release semaphore.
     bool m_isAsync;                             // True if the sender thread is started (asynchronous mode).
     bool m_isSending;                           // True if the sender thread is busy sending a message.
@@ -120,3 +122,5 @@ private:
     static inline LogITM* m_instance = {};      // Singleton instance pointer for static methods.
 
 };
+
+#endif
@@ -13,6 +13,7 @@
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
+#include "target.h"
 #include "DateTimeEx.hpp"
 
 /// @brief System log message class.
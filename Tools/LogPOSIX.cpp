@@ -0,0 +1,47 @@
+/**
+ * @file        LogPOSIX.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Host standard output debug output implementation.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#if defined(USE_POSIX)
+
+#include "LogPOSIX.hpp"
+#include <unistd.h>
+
+LogPOSIX* LogPOSIX::getInstance(ILogMessagePool& pool)
+{
+    static LogPOSIX instance(pool);
+    return &instance;
+}
+
+void LogPOSIX::send(int index)
+{
+    if (m_isSending || index > m_pool.lastIndex()) return;
+    LogMessage* message = m_pool[index];
+    if (!message || message->empty()) return;
+    m_isSending = true;
+    m_pool.lastSentIndex(index);
+    auto [buffer, length] = message->buffer();
+    for (size_t done = 0; done < length; )
+    {
+        ssize_t written = ::write(STDOUT_FILENO, buffer + done, length - done);
+        if (written <= 0) break;
+        done += written;
+    }
+    message->clear();
+    m_isSending = false;
+    sendNext();
+}
+
+void LogPOSIX::sendNext()
+{
+    if (m_pool.lastSentIndex() < m_pool.lastIndex()) send(m_pool.lastSentIndex(m_pool.lastSentIndex() + 1));
+    else m_pool.clear();
+}
+
+#endif
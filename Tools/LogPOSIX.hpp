@@ -0,0 +1,52 @@
+/**
+ * @file        LogPOSIX.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Host standard output debug output implementation. Header file.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#if defined(USE_POSIX)
+
+#include "ILogOutput.hpp"
+#include "ILogMessagePool.hpp"
+
+/// @brief Host standard output debug output, for the `USE_POSIX` build.
+class LogPOSIX final : public ILogOutput
+{
+
+private:
+
+    /// @brief Creates the standard output debug output for the message pool.
+    /// @param pool Message pool reference.
+    LogPOSIX(ILogMessagePool& pool) : m_pool(pool), m_isSending(false) { }
+
+    LogPOSIX(const LogPOSIX&) = delete; // Instances should not be copied.
+    LogPOSIX(LogPOSIX&&) = delete; // Instances should not be moved.
+
+public:
+
+    /// @brief Creates the standard output debug output instance.
+    /// @param pool Message pool reference.
+    /// @returns Singleton instance.
+    static LogPOSIX* getInstance(ILogMessagePool& pool);
+
+    /// @brief Sends a message to the output.
+    /// @param index Message index.
+    void send(int index) override;
+
+private:
+
+    /// @brief Sends the next message from the pool if available.
+    void sendNext();
+
+    ILogMessagePool& m_pool;                    // Log message pool reference.
+    bool m_isSending;                           // True while a message is being written.
+
+};
+
+#endif
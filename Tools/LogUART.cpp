@@ -8,6 +8,8 @@
  * @copyright	(c)2024 CodeDog, All rights reserved.
  */
 
+#if !defined(USE_POSIX)
+
 #include "LogUART.hpp"
 
 LogUART::LogUART(UART_HandleTypeDef* huart, ILogMessagePool& pool) : m_uart(huart), m_pool(pool)
@@ -54,3 +56,5 @@ void LogUART::tx_complete(UART_HandleTypeDef *huart)
     m_instance->m_isSending = false;
     m_instance->sendNext();
 }
+
+#endif
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#if !defined(USE_POSIX)
+
 #include "hal.h"
 #include "ILogOutput.hpp"
 #include "ILogMessagePool.hpp"
@@ -63,3 +65,5 @@ private:
     static inline LogUART* m_instance = {};   // Singleton instance pointer for static methods.
 
 };
+
+#endif
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "CycleCounter.hpp"
 #include "StaticClass.hpp"
 #include "TaskScheduler.hpp"
 
@@ -26,9 +27,28 @@ public:
     /// @brief Starts the main application thread task scheduler.
     static inline void start() { m_scheduler.start(); }
 
-    /// @brief Calls actions scheduled to the GUI display frame.
+    /// @brief Calls actions scheduled to the GUI display frame within the frame time budget.
+    /// @remarks Called from the GUI thread on each display frame (`Model::tick()`).
     static inline void frame() { m_scheduler.frameTick(); }
 
+    /// @brief Sets the CPU time the `frame` context tasks can use in one display frame.
+    ///        Tasks that don't fit are carried over to the next frame.
+    /// @param microseconds Time budget in microseconds. Default: `WTK_OS_FRAME_BUDGET_US`.
+    static inline void frameBudget(uint32_t microseconds) { m_scheduler.frameBudget(CycleCounter::fromMicroseconds(microseconds)); }
+
+    /// @returns Frame context processing statistics.
+    static inline const FrameStats& frameStats() { return m_scheduler.frameStats(); }
+
+    /// @param context Thread context, `application` or `frame`.
+    /// @returns The schedule-to-start latency and run duration histograms of the tasks run in the context, in CPU cycles.
+    static inline const SchedulingStats& schedulingStats(ThreadContext context = application) { return m_scheduler.schedulingStats(context); }
+
+    /// @brief Clears the scheduling latency and duration histograms.
+    static inline void clearSchedulingStats() { m_scheduler.clearSchedulingStats(); }
+
+    /// @brief Logs the scheduling latency and duration histograms of all contexts.
+    static inline void dumpSchedulingStats() { m_scheduler.dumpSchedulingStats(); }
+
     /// @brief Schedules the action to be executed in the selected thread context.
     /// @param action Action that passes no argument.
     /// @param context Target thread context.
@@ -68,30 +88,44 @@ public:
     }
 
     /// @brief Schedules the action to be repeated when the `time` elapses with the regular `time` interval.
+    ///        Release times are absolute (previous release + `time`), so the period does not drift.
     /// @param time The number of RTOS ticks to wait.
     /// @param action Action that passes no argument.
     /// @param context Target thread context.
+    /// @param policy What to do when the task misses its release time. Default: `catchUp`.
     /// @returns Unique task identifier that can be used to cancel a scheduled task.
-    static inline TaskId repeat(TickCount time, Action action, ThreadContext context = application)
+    static inline TaskId repeat(TickCount time, Action action, ThreadContext context = application, MissedReleasePolicy policy = catchUp)
     {
-        return m_scheduler.schedule(nullptr, action, context, time, time);
+        return m_scheduler.schedule(nullptr, action, context, time, time, policy);
     }
 
     /// @brief Schedules the action to be repeated when the `time` elapses with the regular `time` interval.
+    ///        Release times are absolute (previous release + `time`), so the period does not drift.
     /// @param time The number of RTOS ticks to wait.
     /// @param argument Pointer to pass to the action.
     /// @param action Action that passes an argument pointer.
     /// @param context Target thread context.
+    /// @param policy What to do when the task misses its release time. Default: `catchUp`.
     /// @returns Unique task identifier that can be used to cancel a scheduled task.
-    static inline TaskId repeat(TickCount time, void* argument, BindingAction action, ThreadContext context = application)
+    static inline TaskId repeat(TickCount time, void* argument, BindingAction action, ThreadContext context = application,
+                                MissedReleasePolicy policy = catchUp)
     {
-        return m_scheduler.schedule(argument, action, context, time, time);
+        return m_scheduler.schedule(argument, action, context, time, time, policy);
     }
 
+    /// @brief Wakes up the scheduler delay thread, so it recalculates the nearest deadline. ISR safe.
+    static inline void wake() { m_scheduler.wake(); }
+
     /// @brief Cancels an active task. Thread safe.
     /// @param id Task identifier reference. Gets zeroed if task canceled.
     static inline void cancel(TaskId& taskId) { m_scheduler.cancel(taskId); }
 
+    /// @brief Gets the timing statistics (runs, missed release times, lateness) of an active task. Thread safe.
+    /// @param taskId Task identifier.
+    /// @param timing Target reference.
+    /// @returns True if the task was found.
+    static inline bool timing(TaskId taskId, TaskTiming& timing) { return m_scheduler.timing(taskId, timing); }
+
 private:
 
     static inline TaskScheduler m_scheduler{};
@@ -0,0 +1,81 @@
+/**
+ * @file        CriticalSection.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       RAII interrupt lock for short, ISR-safe critical sections. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "target.h"
+
+#if defined(USE_POSIX)
+
+#include <mutex>
+
+namespace OS
+{
+
+/// @brief Locks the global recursive mutex for the lifetime of the object. Host build replacement for disabling interrupts.
+class CriticalSection final
+{
+
+public:
+
+    /// @brief Locks the global mutex.
+    CriticalSection() { mutex().lock(); }
+
+    /// @brief Unlocks the global mutex.
+    ~CriticalSection() { mutex().unlock(); }
+
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+private:
+
+    /// @returns The global mutex reference.
+    static std::recursive_mutex& mutex()
+    {
+        static std::recursive_mutex instance;
+        return instance;
+    }
+
+};
+
+}
+
+#else
+
+#include "hal_mcu.h"
+
+namespace OS
+{
+
+/// @brief Disables interrupts for the lifetime of the object, then restores the previous state.
+/// @remarks Can be nested and used in ISR. Keep the protected code short and never block inside.
+class CriticalSection final
+{
+
+public:
+
+    /// @brief Saves the interrupt mask and disables interrupts.
+    CriticalSection() : m_primask(__get_PRIMASK()) { __disable_irq(); }
+
+    /// @brief Restores the saved interrupt mask.
+    ~CriticalSection() { __set_PRIMASK(m_primask); }
+
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+private:
+    uint32_t m_primask; // Saved interrupt mask.
+
+};
+
+}
+
+#endif
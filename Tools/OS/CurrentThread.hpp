@@ -11,7 +11,9 @@
 #pragma once
 
 #include "target.h"
+#if !defined(USE_POSIX)
 #include "hal_mcu.h"
+#endif
 #include "ThreadBase.hpp"
 #include "StaticClass.hpp"
 #include <cstddef>
@@ -35,13 +37,30 @@ public:
         auto handle = tx_thread_identify();
 #elif defined(USE_FREE_RTOS)
         auto handle = xTaskGetCurrentTaskHandle();
+#elif defined(USE_POSIX)
+        auto handle = m_handle;
 #endif
         return ThreadBase(handle);
     }
 
+#if defined(USE_POSIX)
+
+    /// @returns 0: There are no interrupts on a host.
+    static inline bool isISRContext() { return false; }
+
+private:
+
+    friend class ThreadStorage;
+
+    static inline thread_local ThreadHandle m_handle = nullptr; // The thread started by `ThreadStorage`, `nullptr` for the other threads.
+
+#else
+
     /// @returns 1: Called from ISR. 0: Not called from ISR.
     static inline bool isISRContext() { return (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0; }
 
+#endif
+
 };
 
 }
@@ -0,0 +1,77 @@
+/**
+ * @file        EventBus.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A static publish / subscribe event bus with per-subscriber delivery context. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "EventBus.hpp"
+#include "AppThread.hpp"
+#include "CurrentThread.hpp"
+
+void OS::EventDispatcher::schedule(SubscriptionBase& subscription)
+{
+    const size_t context = subscription.m_delivery == Delivery::frame ? 1 : 0;
+    bool isNew = false;
+    {
+        CriticalSection cs;
+        if (subscription.m_isPending) return;
+        subscription.m_isPending = true;
+        subscription.m_nextPending = nullptr;
+        if (m_last[context]) m_last[context]->m_nextPending = &subscription;
+        else m_first[context] = &subscription;
+        m_last[context] = &subscription;
+        if (!m_isScheduled[context]) isNew = m_isScheduled[context] = true;
+    }
+    if (!isNew) return;
+    if (CurrentThread::isISRContext())
+    {
+        m_isRequested[context] = true;
+        AppThread::wake(); // The task scheduler is not ISR safe, so the delay thread schedules the dispatch.
+        return;
+    }
+    post(context);
+}
+
+void OS::EventDispatcher::flush(void)
+{
+    for (size_t context = 0; context < contexts; ++context)
+    {
+        {
+            CriticalSection cs;
+            if (!m_isRequested[context]) continue;
+            m_isRequested[context] = false;
+        }
+        post(context);
+    }
+}
+
+void OS::EventDispatcher::post(size_t context)
+{
+    if (context) AppThread::sync([]{ dispatch(1); }, ThreadContext::frame);
+    else AppThread::sync([]{ dispatch(0); }, ThreadContext::application);
+}
+
+void OS::EventDispatcher::dispatch(size_t context)
+{
+    for (;;)
+    {
+        SubscriptionBase* subscription;
+        {
+            CriticalSection cs;
+            subscription = m_first[context];
+            if (!subscription)
+            {
+                m_isScheduled[context] = false;
+                return;
+            }
+            m_first[context] = subscription->m_nextPending;
+            if (!m_first[context]) m_last[context] = nullptr;
+            subscription->m_isPending = false;
+        }
+        subscription->deliver();
+    }
+}
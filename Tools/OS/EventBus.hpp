@@ -0,0 +1,264 @@
+/**
+ * @file        EventBus.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A static publish / subscribe event bus with per-subscriber delivery context. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     Events are plain types. Subscriptions are static objects that link themselves to the event type list
+ *              on construction, so adding a listener never touches the producer and publishing never allocates.
+ *              Queued events are delivered in one batch per context, using one scheduler task for all subscriptions.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Action.hpp"
+#include "StaticClass.hpp"
+#include "CriticalSection.hpp"
+#include "RTOS.hpp"
+
+namespace OS
+{
+
+/// @brief Event delivery context.
+enum class Delivery : uint8_t
+{
+    direct,         // Called synchronously in the publisher context (can be an ISR).
+    application,    // Queued and called in the application thread.
+    frame           // Queued and called in the display frame context.
+};
+
+/// @brief A subscription part known to the dispatcher.
+class SubscriptionBase
+{
+
+    friend class EventDispatcher;
+
+public:
+
+    SubscriptionBase(const SubscriptionBase&) = delete;
+    SubscriptionBase& operator=(const SubscriptionBase&) = delete;
+
+    /// @returns The delivery context.
+    inline Delivery delivery() const { return m_delivery; }
+
+protected:
+
+    /// @param delivery Delivery context.
+    SubscriptionBase(Delivery delivery) : m_delivery(delivery), m_isPending(false), m_nextPending() { }
+
+    /// @brief Calls the handler with all queued events. Called by the dispatcher in the delivery context.
+    virtual void deliver() = 0;
+
+private:
+
+    Delivery m_delivery;                // Delivery context.
+    bool m_isPending;                   // True if linked to the dispatcher pending list.
+    SubscriptionBase* m_nextPending;    // Next subscription in the dispatcher pending list.
+
+};
+
+/// @brief Calls queued subscriptions in their delivery contexts.
+class EventDispatcher final
+{
+    STATIC(EventDispatcher)
+
+public:
+
+    /// @brief Links the subscription to the pending list of its context and schedules the dispatch if needed. ISR safe.
+    /// @param subscription Subscription with queued events.
+    static void schedule(SubscriptionBase& subscription);
+
+    /// @brief Schedules the dispatch requested from an ISR. Called by the `TaskScheduler` delay thread.
+    static void flush(void);
+
+private:
+
+    static constexpr size_t contexts = 2; // Queued delivery contexts: application and frame.
+
+    /// @brief Schedules the dispatch task in the context.
+    /// @param context Context index.
+    static void post(size_t context);
+
+    /// @brief Delivers the events of all pending subscriptions of the context.
+    /// @param context Context index.
+    static void dispatch(size_t context);
+
+    static inline SubscriptionBase* m_first[contexts] = {};     // Pending list heads.
+    static inline SubscriptionBase* m_last[contexts] = {};      // Pending list tails.
+    static inline bool m_isScheduled[contexts] = {};            // True if the context dispatch task is scheduled or requested.
+    static inline bool m_isRequested[contexts] = {};            // True if the dispatch was requested from an ISR.
+
+};
+
+template<typename TEvent> class EventBus;
+
+/// @brief A subscription part known to the event type list.
+/// @tparam TEvent Event type.
+template<typename TEvent>
+class Subscriber : public SubscriptionBase
+{
+
+    friend class EventBus<TEvent>;
+
+public:
+
+    using Handler = Ac1<const TEvent&>; // Event handler type.
+
+protected:
+
+    /// @brief Links the subscriber to the event type list.
+    /// @param handler Event handler.
+    /// @param delivery Delivery context.
+    Subscriber(Handler handler, Delivery delivery);
+
+    /// @brief Unlinks the subscriber from the event type list.
+    ~Subscriber();
+
+    /// @brief Accepts a published event. Called in the publisher context.
+    /// @param event Event reference.
+    virtual void accept(const TEvent& event) = 0;
+
+    Handler m_handler; // Event handler.
+
+private:
+
+    Subscriber* m_next; // Next subscriber of the same event type.
+
+};
+
+/**
+ * @brief The event type publishing point.
+ * @tparam TEvent Event type. Must be trivially copyable.
+ */
+template<typename TEvent>
+class EventBus final
+{
+    STATIC(EventBus)
+
+    static_assert(std::is_trivially_copyable<TEvent>::value, "Events must be trivially copyable.");
+
+    friend class Subscriber<TEvent>;
+
+public:
+
+    /// @brief Passes the event to all subscribers. Never blocks, never allocates. ISR safe.
+    /// @param event Event reference.
+    static void publish(const TEvent& event)
+    {
+        for (Subscriber<TEvent>* s = m_first; s; s = s->m_next) s->accept(event);
+    }
+
+private:
+
+    static inline Subscriber<TEvent>* m_first = {}; // The first subscriber of the event type.
+
+};
+
+/**
+ * @brief A static subscription to the events of the `TEvent` type.
+ *
+ * @tparam TEvent Event type.
+ * @tparam TDepth The number of events queued between deliveries.
+ *         1 coalesces the events: only the latest one is delivered, the older ones are counted as coalesced.
+ *         Above 1 the events are delivered in order, the ones that don't fit are counted as dropped.
+ */
+template<typename TEvent, size_t TDepth = 1>
+class Subscription final : public Subscriber<TEvent>
+{
+
+    static_assert(TDepth > 0, "Subscription depth must be at least 1.");
+
+public:
+
+    using Handler = typename Subscriber<TEvent>::Handler;
+
+    /// @brief Creates a subscription. Declare it as a static object.
+    /// @param handler Event handler.
+    /// @param delivery Delivery context. Default: application thread.
+    Subscription(Handler handler, Delivery delivery = Delivery::application)
+        : Subscriber<TEvent>(handler, delivery), m_events(), m_head(), m_length(), m_coalesced(), m_dropped() { }
+
+    /// @returns The number of events replaced by a newer one before delivery.
+    inline uint32_t coalesced() const { return m_coalesced; }
+
+    /// @returns The number of events dropped because the queue was full.
+    inline uint32_t dropped() const { return m_dropped; }
+
+protected:
+
+    void accept(const TEvent& event) override
+    {
+        if (this->delivery() == Delivery::direct)
+        {
+            this->m_handler(event);
+            return;
+        }
+        bool wasEmpty;
+        {
+            CriticalSection cs;
+            wasEmpty = !m_length;
+            if (TDepth == 1)
+            {
+                if (m_length) ++m_coalesced;
+                m_events[0] = event;
+                m_length = 1;
+            }
+            else if (m_length >= TDepth) ++m_dropped;
+            else m_events[(m_head + m_length++) % TDepth] = event;
+        }
+        if (wasEmpty) EventDispatcher::schedule(*this);
+    }
+
+    void deliver() override
+    {
+        for (;;)
+        {
+            TEvent event;
+            {
+                CriticalSection cs;
+                if (!m_length) return;
+                event = m_events[m_head];
+                m_head = (m_head + 1) % TDepth;
+                --m_length;
+            }
+            this->m_handler(event);
+        }
+    }
+
+private:
+
+    TEvent m_events[TDepth];    // Queued events.
+    size_t m_head;              // The oldest queued event index.
+    size_t m_length;            // The number of queued events.
+    uint32_t m_coalesced;       // The number of coalesced events.
+    uint32_t m_dropped;         // The number of dropped events.
+
+};
+
+template<typename TEvent>
+Subscriber<TEvent>::Subscriber(Handler handler, Delivery delivery) : SubscriptionBase(delivery), m_handler(handler), m_next()
+{
+    CriticalSection cs;
+    m_next = EventBus<TEvent>::m_first;
+    EventBus<TEvent>::m_first = this;
+}
+
+template<typename TEvent>
+Subscriber<TEvent>::~Subscriber()
+{
+    CriticalSection cs;
+    for (Subscriber** link = &EventBus<TEvent>::m_first; *link; link = &(*link)->m_next)
+        if (*link == this)
+        {
+            *link = m_next;
+            break;
+        }
+}
+
+}
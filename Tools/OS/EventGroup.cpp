@@ -25,6 +25,7 @@ OS::EventGroup::~EventGroup()
 
 bool OS::EventGroup::signal(EventFlags bits)
 {
+    if (!m_isCreated && CurrentThread::isISRContext()) return false; // Can't create in ISR, nobody waits yet anyway.
     init();
     auto result = tx_event_flags_set(&m_controlBlock, bits, TX_OR);
     return result == TX_SUCCESS;
@@ -36,8 +37,8 @@ OS::EventFlags OS::EventGroup::wait(EventFlags bits, WaitOptions options, TickCo
     if (CurrentThread::isISRContext()) Crash::here(); // Can't wait in ISR!
     EventFlags actualFlags;
     UINT txOption = (options & noClear)
-        ? ((options & waitAny) ? TX_OR : (options & waitAll) ? TX_AND : 0)
-        : ((options & waitAny) ? TX_OR_CLEAR : (options & waitAll) ? TX_AND_CLEAR : 0);
+        ? ((options & waitAll) ? TX_AND : TX_OR)
+        : ((options & waitAll) ? TX_AND_CLEAR : TX_OR_CLEAR);
     auto result = tx_event_flags_get(&m_controlBlock, bits, txOption, &actualFlags, timeout);
     return result == TX_SUCCESS ? actualFlags : 0;
 }
@@ -61,6 +62,7 @@ OS::EventGroup::~EventGroup()
 
 bool OS::EventGroup::signal(EventFlags bits)
 {
+    if (!m_handle && CurrentThread::isISRContext()) return false; // Can't create in ISR, nobody waits yet anyway.
     init();
     if (CurrentThread::isISRContext())
     {
@@ -89,4 +91,33 @@ void OS::EventGroup::init(void)
     if (!m_handle) Crash::here(); // Event group creation failed!
 }
 
+#elif defined(USE_POSIX)
+
+OS::EventGroup::EventGroup() : m_mutex(), m_changed(), m_flags() { }
+
+OS::EventGroup::~EventGroup() { }
+
+bool OS::EventGroup::signal(EventFlags bits)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flags |= bits;
+    }
+    m_changed.notify_all();
+    return true;
+}
+
+OS::EventFlags OS::EventGroup::wait(EventFlags bits, WaitOptions options, TickCount timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto isSet = [this, bits, options]() { return (options & waitAll) ? (m_flags & bits) == bits : (m_flags & bits) != 0; };
+    if (timeout == waitForever) m_changed.wait(lock, isSet);
+    else if (!m_changed.wait_for(lock, toDuration(timeout), isSet)) return 0;
+    const EventFlags actualFlags = m_flags;
+    if (!(options & noClear)) m_flags &= ~bits;
+    return actualFlags;
+}
+
+void OS::EventGroup::init(void) { }
+
 #endif
@@ -12,6 +12,11 @@
 
 #include "RTOS.hpp"
 
+#if defined(USE_POSIX)
+#include <condition_variable>
+#include <mutex>
+#endif
+
 namespace OS
 {
 
@@ -49,6 +54,10 @@ private:
 #elif defined(USE_FREE_RTOS)
     StaticEventGroup_t m_buffer;    // A statically allocated buffer for the data.
     EventGroupHandle_t m_handle;    // A pointer used to access the data.
+#elif defined(USE_POSIX)
+    std::mutex m_mutex;                 // Protects the flags.
+    std::condition_variable m_changed;  // Notified when the flags are set.
+    EventFlags m_flags;                 // Event flags.
 #endif
 
 };
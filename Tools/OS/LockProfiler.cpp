@@ -0,0 +1,140 @@
+/**
+ * @file        LockProfiler.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Opt-in contention statistics for mutexes and semaphores. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "LockProfiler.hpp"
+#include "CriticalSection.hpp"
+#include "CurrentThread.hpp"
+#include "CycleCounter.hpp"
+#include "Log.hpp"
+
+#if defined(USE_AZURE_RTOS) && defined(TX_MUTEX_ENABLE_PERFORMANCE_INFO)
+#include "tx_mutex.h"
+#endif
+
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS) or defined(USE_POSIX)
+
+/// @param handle RTOS thread handle.
+/// @returns Thread name or "-" for no thread.
+static const char* threadName(OS::ThreadHandle handle)
+{
+    if (!handle) return "-";
+#if defined(USE_AZURE_RTOS)
+    return handle->tx_thread_name ? handle->tx_thread_name : "?";
+#elif defined(USE_FREE_RTOS)
+    return pcTaskGetName(handle);
+#elif defined(USE_POSIX)
+    return handle->name ? handle->name : "?";
+#endif
+}
+
+OS::LockStats* OS::LockProfiler::attach(const char* name)
+{
+    CycleCounter::init();
+    CriticalSection cs;
+    if (m_count >= capacity) return nullptr;
+    LockStats* stats = &m_stats[m_count++];
+    *stats = {};
+    stats->name = name;
+    return stats;
+}
+
+void OS::LockProfiler::reset(void)
+{
+    CriticalSection cs;
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        LockStats& stats = m_stats[i];
+        const char* name = stats.name;
+        const uint32_t depth = stats.depth;
+        const uint32_t acquiredAt = stats.acquiredAt;
+        stats = {};
+        stats.name = name;
+        stats.depth = depth; // A mutex held during the reset is still released later.
+        stats.acquiredAt = acquiredAt;
+    }
+}
+
+void OS::LockProfiler::acquired(LockStats* stats, uint32_t waitCycles, bool contended)
+{
+    ++stats->acquires;
+    if (contended) ++stats->contended;
+    stats->totalWaitCycles += waitCycles;
+    if (waitCycles > stats->maxWaitCycles) stats->maxWaitCycles = waitCycles;
+    stats->lastOwner = CurrentThread::get().handle();
+}
+
+void OS::LockProfiler::locked(LockStats* stats)
+{
+    if (!stats->depth++) stats->acquiredAt = CycleCounter::now();
+}
+
+void OS::LockProfiler::failed(LockStats* stats, uint32_t waitCycles)
+{
+    CriticalSection cs; // The caller does not own the lock.
+    ++stats->timeouts;
+    stats->totalWaitCycles += waitCycles;
+    if (waitCycles > stats->maxWaitCycles) stats->maxWaitCycles = waitCycles;
+}
+
+void OS::LockProfiler::released(LockStats* stats)
+{
+    if (!stats->depth || --stats->depth) return;
+    const uint32_t holdCycles = CycleCounter::since(stats->acquiredAt);
+    stats->totalHoldCycles += holdCycles;
+    if (holdCycles > stats->maxHoldCycles) stats->maxHoldCycles = holdCycles;
+}
+
+void OS::LockProfiler::dump(void)
+{
+    Log::msg("Locks (acquires / contended / timeouts / avg wait / max wait / avg hold / max hold [us] / last owner):");
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        LockStats stats;
+        {
+            CriticalSection cs;
+            stats = m_stats[i];
+        }
+        const uint32_t waits = stats.acquires + stats.timeouts;
+        const uint32_t avgWait = waits ? static_cast<uint32_t>(stats.totalWaitCycles / waits) : 0;
+        const uint32_t avgHold = stats.acquires ? static_cast<uint32_t>(stats.totalHoldCycles / stats.acquires) : 0;
+        Log::msg("  %-24s %8u %8u %6u %8u %8u %8u %8u %s",
+            stats.name ? stats.name : "?",
+            static_cast<unsigned>(stats.acquires),
+            static_cast<unsigned>(stats.contended),
+            static_cast<unsigned>(stats.timeouts),
+            static_cast<unsigned>(CycleCounter::toMicroseconds(avgWait)),
+            static_cast<unsigned>(CycleCounter::toMicroseconds(stats.maxWaitCycles)),
+            static_cast<unsigned>(CycleCounter::toMicroseconds(avgHold)),
+            static_cast<unsigned>(CycleCounter::toMicroseconds(stats.maxHoldCycles)),
+            threadName(stats.lastOwner));
+    }
+#if defined(USE_AZURE_RTOS) && defined(TX_MUTEX_ENABLE_PERFORMANCE_INFO)
+    Log::msg("ThreadX mutexes (gets / puts / suspensions / timeouts / inversions):");
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    TX_MUTEX* mutex = _tx_mutex_created_ptr;
+    ULONG remaining = _tx_mutex_created_count;
+    TX_RESTORE
+    for (; mutex && remaining; --remaining, mutex = mutex->tx_mutex_created_next)
+    {
+        ULONG puts = 0, gets = 0, suspensions = 0, timeouts = 0, inversions = 0, inheritances = 0;
+        if (tx_mutex_performance_info_get(mutex, &puts, &gets, &suspensions, &timeouts, &inversions, &inheritances) != TX_SUCCESS) continue;
+        Log::msg("  %-24s %8u %8u %8u %6u %6u",
+            mutex->tx_mutex_name ? mutex->tx_mutex_name : "?",
+            static_cast<unsigned>(gets),
+            static_cast<unsigned>(puts),
+            static_cast<unsigned>(suspensions),
+            static_cast<unsigned>(timeouts),
+            static_cast<unsigned>(inversions));
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file        LockProfiler.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Opt-in contention statistics for mutexes and semaphores. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     Call `profile("name")` on a `Mutex` or `Semaphore` to start collecting its statistics.
+ *              Locks that are not profiled pay one pointer test per call.
+ *              Azure RTOS: with `TX_MUTEX_ENABLE_PERFORMANCE_INFO` defined `dump()` also lists the counters
+ *              of all ThreadX mutexes, including the ones internal to FileX and USBX.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "StaticClass.hpp"
+#include "RTOS.hpp"
+
+namespace OS
+{
+
+/// @brief Contention statistics of a single mutex or semaphore.
+/// @remarks The counters are updated by the lock owner, so they need no additional synchronization.
+struct LockStats
+{
+    const char* name;           ///< The name given in `profile()`.
+    uint32_t acquires;          ///< The number of successful acquisitions.
+    uint32_t contended;         ///< The number of acquisitions that had to wait.
+    uint32_t timeouts;          ///< The number of acquisitions that failed.
+    uint64_t totalWaitCycles;   ///< Total CPU cycles spent waiting.
+    uint32_t maxWaitCycles;     ///< The longest wait in CPU cycles.
+    uint64_t totalHoldCycles;   ///< Total CPU cycles the mutex was held. Zero for semaphores.
+    uint32_t maxHoldCycles;     ///< The longest hold in CPU cycles. Zero for semaphores.
+    ThreadHandle lastOwner;     ///< The last thread that acquired the lock.
+    uint32_t acquiredAt;        ///< The cycle count at the outermost acquisition.
+    uint32_t depth;             ///< Recursive acquisition depth.
+};
+
+/// @brief A static registry of the lock statistics.
+class LockProfiler final
+{
+    STATIC(LockProfiler)
+
+public:
+
+    static constexpr size_t capacity = WTK_OS_LOCK_STATS; ///< The maximal number of profiled locks.
+
+    /// @brief Claims a statistics slot.
+    /// @param name Lock name, must point to a static string.
+    /// @returns Statistics pointer or `nullptr` if all slots are taken.
+    static LockStats* attach(const char* name);
+
+    /// @returns The number of profiled locks.
+    static inline size_t count() { return m_count; }
+
+    /// @param index Lock index, less than `count()`.
+    /// @returns Statistics of the lock.
+    static inline const LockStats& at(size_t index) { return m_stats[index]; }
+
+    /// @brief Zeroes all counters, keeps the names.
+    static void reset(void);
+
+    /// @brief Logs the statistics of all profiled locks. DO NOT CALL FROM ISR!
+    static void dump(void);
+
+public: // Hooks called by the locks:
+
+    /// @brief Records a successful acquisition.
+    /// @param stats Lock statistics.
+    /// @param waitCycles CPU cycles spent waiting, zero if not contended.
+    /// @param contended True if the caller had to wait.
+    static void acquired(LockStats* stats, uint32_t waitCycles, bool contended);
+
+    /// @brief Records the start of the hold time after a mutex acquisition.
+    /// @param stats Lock statistics.
+    static void locked(LockStats* stats);
+
+    /// @brief Records a failed acquisition.
+    /// @param stats Lock statistics.
+    /// @param waitCycles CPU cycles spent waiting.
+    static void failed(LockStats* stats, uint32_t waitCycles);
+
+    /// @brief Records a mutex release by the owner.
+    /// @param stats Lock statistics.
+    static void released(LockStats* stats);
+
+private:
+
+    static inline LockStats m_stats[capacity] = {}; // Statistics slots.
+    static inline size_t m_count = {};              // The number of slots taken.
+
+};
+
+}
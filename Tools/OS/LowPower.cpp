@@ -0,0 +1,143 @@
+/**
+ * @file        LowPower.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Tickless idle for the Azure RTOS `TX_LOW_POWER` build. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "LowPower.hpp"
+#include "CriticalSection.hpp"
+#include "Log.hpp"
+
+#if defined(USE_AZURE_RTOS)
+
+#include "hal_mcu.h"
+#include "tx_timer.h"
+
+void OS::LowPower::inhibit(void)
+{
+    CriticalSection cs;
+    ++m_inhibitCount;
+}
+
+void OS::LowPower::allow(void)
+{
+    CriticalSection cs;
+    if (m_inhibitCount) --m_inhibitCount;
+}
+
+void OS::LowPower::dump(void)
+{
+    LowPowerStats stats;
+    {
+        CriticalSection cs;
+        stats = m_stats;
+    }
+    Log::msg("Tickless idle: %lu sleeps, %lu woken early, %lu ticks suppressed.",
+        static_cast<unsigned long>(stats.sleeps),
+        static_cast<unsigned long>(stats.earlyWakes),
+        static_cast<unsigned long>(stats.suppressedTicks));
+}
+
+/// @brief Finds the number of ticks that can pass without a ThreadX timer expiring.
+/// @param limit The maximal number of ticks to return.
+/// @returns The number of empty timer wheel slots before the first active one, up to `limit`.
+static uint32_t idleTicks(uint32_t limit)
+{
+    if (_tx_timer_time_slice) return 0; // A time-slice is counting down.
+    const size_t entries = static_cast<size_t>(_tx_timer_list_end - _tx_timer_list_start);
+    TX_TIMER_INTERNAL** slot = _tx_timer_current_ptr;
+    uint32_t ticks = 0;
+    for (size_t i = 0; i < entries && ticks < limit; ++i, ++ticks)
+    {
+        if (*slot) break; // Expires on the tick after skipping `ticks` (or later, if re-inserted for the next wheel turn).
+        if (++slot == _tx_timer_list_end) slot = _tx_timer_list_start;
+    }
+    if (ticks == entries) ticks = limit; // No active timers at all.
+    return ticks < limit ? ticks : limit;
+}
+
+/// @brief Waits for an interrupt, unless the ThreadX port does it after the hook.
+static inline void waitForInterrupt(void)
+{
+#ifndef TX_ENABLE_WFI
+    __DSB();
+    __WFI();
+    __ISB();
+#endif
+}
+
+void OS::LowPower::enter(void)
+{
+    m_sleepTicks = 0;
+    if (m_inhibitCount || !(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+    {
+        waitForInterrupt(); // Sleep with the regular tick.
+        return;
+    }
+    if (!m_tickCycles) m_tickCycles = SysTick->LOAD + 1;
+    const uint32_t maxTicks = (SysTick_LOAD_RELOAD_Msk + 1) / m_tickCycles - 1;
+    const uint32_t ticks = idleTicks(maxTicks);
+    if (ticks < minimumTicks)
+    {
+        waitForInterrupt();
+        return;
+    }
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    m_partialCycles = SysTick->LOAD - SysTick->VAL; // The part of the current tick already elapsed.
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) // The tick ended while stopping the timer.
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return;
+    }
+    SysTick->LOAD = (ticks + 1) * m_tickCycles - m_partialCycles - 1; // Fires on the boundary of the tick that processes the timer.
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    HAL_SuspendTick();
+    m_sleepTicks = ticks;
+    waitForInterrupt();
+}
+
+void OS::LowPower::exit(void)
+{
+    if (!m_sleepTicks) return;
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    const bool isComplete = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0; // The tick interrupt is pending, as the interrupts are disabled.
+    uint32_t skipped = m_sleepTicks; // The pending tick interrupt counts the last tick.
+    if (!isComplete)
+    {
+        const uint32_t elapsed = m_partialCycles + (SysTick->LOAD - SysTick->VAL);
+        skipped = elapsed / m_tickCycles;
+        if (skipped > m_sleepTicks) skipped = m_sleepTicks;
+        ++m_stats.earlyWakes;
+    }
+    SysTick->LOAD = m_tickCycles - 1;
+    SysTick->VAL = 0; // The current tick restarts, the drift is below one tick per early wake-up.
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    _tx_timer_system_clock += skipped;
+    TX_TIMER_INTERNAL** slot = _tx_timer_current_ptr; // The skipped slots are empty, so the wheel just turns.
+    for (uint32_t i = 0; i < skipped; ++i) if (++slot == _tx_timer_list_end) slot = _tx_timer_list_start;
+    _tx_timer_current_ptr = slot;
+    uwTick += skipped * (1000U / TX_TIMER_TICKS_PER_SECOND);
+    HAL_ResumeTick();
+    ++m_stats.sleeps;
+    m_stats.suppressedTicks += skipped;
+    m_sleepTicks = 0;
+}
+
+#if defined(TX_LOW_POWER)
+
+EXTERN_C_BEGIN
+
+void tx_low_power_enter(void) { OS::LowPower::enter(); }
+
+void tx_low_power_exit(void) { OS::LowPower::exit(); }
+
+EXTERN_C_END
+
+#endif
+
+#endif
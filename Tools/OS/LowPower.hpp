@@ -0,0 +1,78 @@
+/**
+ * @file        LowPower.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Tickless idle for the Azure RTOS `TX_LOW_POWER` build. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     Azure RTOS: build with `TX_LOW_POWER` defined for both C and assembler sources.
+ *              The ThreadX scheduler then calls `tx_low_power_enter()` / `tx_low_power_exit()` when no thread is ready.
+ *              The hooks stop the SysTick and the HAL time base until the nearest ThreadX timer expiry,
+ *              sleep, then add the ticks that passed to the ThreadX and HAL clocks.
+ *              The `TaskScheduler` delay thread sleeps with a timeout equal to its nearest task release or timer expiry,
+ *              so the scheduler deadline is the ThreadX timer the hook finds.
+ *              FreeRTOS: use `configUSE_TICKLESS_IDLE`, the delay thread wait timeout is the expected idle time there.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "StaticClass.hpp"
+#include "RTOS.hpp"
+
+namespace OS
+{
+
+/// @brief Tickless idle statistics.
+struct LowPowerStats
+{
+    uint32_t sleeps;            ///< The number of tickless sleeps.
+    uint32_t earlyWakes;        ///< The number of sleeps ended by an interrupt before the deadline.
+    uint32_t suppressedTicks;   ///< The number of ticks that passed with the tick interrupt stopped.
+};
+
+/// @brief Controls the tickless idle.
+class LowPower final
+{
+    STATIC(LowPower)
+
+public:
+
+    static constexpr uint32_t minimumTicks = 2; ///< Shorter idle periods keep the tick running.
+
+    /// @brief Disables the tickless idle until `allow()` is called, for code relying on a regular tick interrupt. Calls nest.
+    static void inhibit(void);
+
+    /// @brief Reverts one `inhibit()` call.
+    static void allow(void);
+
+    /// @returns True if the tickless idle is not inhibited.
+    static inline bool allowed() { return !m_inhibitCount; }
+
+    /// @returns Tickless idle statistics.
+    static inline const LowPowerStats& stats() { return m_stats; }
+
+    /// @brief Logs the tickless idle statistics.
+    static void dump(void);
+
+public: // Hooks called by the RTOS:
+
+    /// @brief Stops the tick until the nearest timer expiry and sleeps. Called with interrupts disabled.
+    static void enter(void);
+
+    /// @brief Restarts the tick and adds the ticks that passed during the sleep. Called with interrupts disabled.
+    static void exit(void);
+
+private:
+
+    static inline LowPowerStats m_stats = {};       // Tickless idle statistics.
+    static inline uint32_t m_inhibitCount = {};     // The number of `inhibit()` calls not reverted.
+    static inline uint32_t m_tickCycles = {};       // SysTick cycles per tick.
+    static inline uint32_t m_sleepTicks = {};       // Ticks to skip in the current sleep, zero when not sleeping.
+    static inline uint32_t m_partialCycles = {};    // Cycles of the current tick elapsed before the sleep.
+
+};
+
+}
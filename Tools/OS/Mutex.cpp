@@ -10,11 +10,13 @@
 
 #include "Mutex.hpp"
 #include "CurrentThread.hpp"
+#include "LockProfiler.hpp"
+#include "CycleCounter.hpp"
 #include "Crash.hpp"
 
 #if defined(USE_AZURE_RTOS)
 
-OS::Mutex::Mutex() : m_controlBlock(), m_isCreated(false) { }
+OS::Mutex::Mutex() : m_controlBlock(), m_isCreated(false), m_stats() { }
 
 OS::Mutex::~Mutex()
 {
@@ -24,46 +26,41 @@ OS::Mutex::~Mutex()
     }
 }
 
-bool OS::Mutex::acquire(TickCount timeout)
+bool OS::Mutex::take(TickCount timeout)
 {
-    if (CurrentThread::isISRContext()) return false;
-    init();
     return tx_mutex_get(&m_controlBlock, timeout) == TX_SUCCESS;
 }
 
-bool OS::Mutex::release()
+bool OS::Mutex::give(void)
 {
-    if (!m_isCreated || CurrentThread::isISRContext()) return false;
-    return tx_mutex_put(&m_controlBlock) == TX_SUCCESS;
+    return m_isCreated && tx_mutex_put(&m_controlBlock) == TX_SUCCESS;
 }
 
 void OS::Mutex::init(void)
 {
     if (m_isCreated) return;
-    m_isCreated = tx_mutex_create(&m_controlBlock, nullptr, 0) == TX_SUCCESS;
+    CHAR* name = m_stats ? const_cast<CHAR*>(m_stats->name) : nullptr;
+    m_isCreated = tx_mutex_create(&m_controlBlock, name, 0) == TX_SUCCESS;
     if (!m_isCreated) Crash::here(); // Mutex creation failed!
 }
 
 #elif defined(USE_FREE_RTOS)
 
-OS::Mutex::Mutex() : m_buffer(), m_handle() { }
+OS::Mutex::Mutex() : m_buffer(), m_handle(), m_stats() { }
 
 OS::Mutex::~Mutex()
 {
     if (m_handle) m_handle = nullptr;
 }
 
-bool OS::Mutex::acquire(TickCount timeout)
+bool OS::Mutex::take(TickCount timeout)
 {
-    if (CurrentThread::isISRContext()) return false;
-    init();
     return xSemaphoreTake(m_handle, timeout) == pdTRUE;
 }
 
-bool OS::Mutex::release()
+bool OS::Mutex::give(void)
 {
-    if (!m_handle || CurrentThread::isISRContext()) return false;
-    return xSemaphoreGive(m_handle) == pdTRUE;
+    return m_handle && xSemaphoreGive(m_handle) == pdTRUE;
 }
 
 void OS::Mutex::init(void)
@@ -73,4 +70,69 @@ void OS::Mutex::init(void)
     if (!m_handle) Crash::here(); // Mutex creation failed!
 }
 
+#elif defined(USE_POSIX)
+
+OS::Mutex::Mutex() : m_mutex(), m_stats() { }
+
+OS::Mutex::~Mutex() { }
+
+bool OS::Mutex::take(TickCount timeout)
+{
+    if (timeout == waitForever)
+    {
+        m_mutex.lock();
+        return true;
+    }
+    return timeout ? m_mutex.try_lock_for(toDuration(timeout)) : m_mutex.try_lock();
+}
+
+bool OS::Mutex::give(void)
+{
+    m_mutex.unlock();
+    return true;
+}
+
+void OS::Mutex::init(void) { }
+
+#endif
+
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS) or defined(USE_POSIX)
+
+bool OS::Mutex::acquire(TickCount timeout)
+{
+    if (CurrentThread::isISRContext()) return false;
+    init();
+    if (!m_stats) return take(timeout);
+    bool contended = false;
+    uint32_t start = CycleCounter::now();
+    bool ok = take(0);
+    if (!ok && timeout)
+    {
+        contended = true;
+        ok = take(timeout);
+    }
+    const uint32_t waitCycles = contended ? CycleCounter::since(start) : 0;
+    if (!ok)
+    {
+        LockProfiler::failed(m_stats, waitCycles);
+        return false;
+    }
+    LockProfiler::acquired(m_stats, waitCycles, contended);
+    LockProfiler::locked(m_stats);
+    return true;
+}
+
+bool OS::Mutex::release()
+{
+    if (CurrentThread::isISRContext()) return false;
+    if (m_stats) LockProfiler::released(m_stats); // Must be recorded while still owning the mutex.
+    return give();
+}
+
+bool OS::Mutex::profile(const char* name)
+{
+    if (!m_stats) m_stats = LockProfiler::attach(name);
+    return m_stats != nullptr;
+}
+
 #endif
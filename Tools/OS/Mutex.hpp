@@ -12,9 +12,15 @@
 
 #include "RTOS.hpp"
 
+#if defined(USE_POSIX)
+#include <mutex>
+#endif
+
 namespace OS
 {
 
+struct LockStats;
+
 /// @brief Defines an object that provides mutually exclusive access to a resource.
 class  Mutex
 {
@@ -36,19 +42,37 @@ public:
     /// @returns True if the system call completed successfully. False if error occurred or called from ISR.
     bool release();
 
+    /// @brief Starts collecting the contention statistics of this mutex in `LockProfiler`.
+    /// @param name Mutex name shown in the statistics, must point to a static string.
+    /// @returns True if profiled, false if there are no free `LockProfiler` slots.
+    bool profile(const char* name);
+
 private:
 
     /// @brief Performs the lazy initialization of the control block if required.
     void init(void);
 
+    /// @brief Takes the native mutex.
+    /// @param timeout The time to wait expressed in RTOS ticks.
+    /// @returns True if taken.
+    bool take(TickCount timeout);
+
+    /// @brief Gives the native mutex back.
+    /// @returns True if given.
+    bool give(void);
+
 #if defined(USE_AZURE_RTOS)
     TX_MUTEX m_controlBlock;
     bool m_isCreated;
 #elif defined(USE_FREE_RTOS)
     StaticSemaphore_t m_buffer; // A statically allocated buffer for the data.
     SemaphoreHandle_t m_handle; // A pointer used to access the data.
+#elif defined(USE_POSIX)
+    std::recursive_timed_mutex m_mutex; // Host mutex, recursive like the ThreadX one.
 #endif
 
+    LockStats* m_stats; // Contention statistics, `nullptr` if not profiled.
+
 };
 
 }
@@ -0,0 +1,206 @@
+/**
+ * @file        Profiler.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Attributes CPU cycles to RTOS threads and interrupts. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "Profiler.hpp"
+#include "CycleCounter.hpp"
+#include "CurrentThread.hpp"
+#include "Log.hpp"
+
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS)
+
+void OS::Profiler::start(uint32_t windowMs)
+{
+    CycleCounter::init();
+    ThreadHandle current = CurrentThread::get().handle();
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (auto& slot : m_slots) slot = {};
+    m_bucketCycles = static_cast<uint32_t>(static_cast<uint64_t>(windowMs) * CycleCounter::frequency() / 1000U / buckets);
+    if (!m_bucketCycles) m_bucketCycles = 1;
+    m_bucket = 0;
+    m_isrNesting = 0;
+    m_last = m_bucketStart = CycleCounter::now();
+    m_owner = current ? slotOf(current) : idleSlot;
+    m_isActive = true;
+    __set_PRIMASK(primask);
+}
+
+void OS::Profiler::stop(void)
+{
+    m_isActive = false;
+}
+
+size_t OS::Profiler::get(ThreadLoad* load, size_t capacity)
+{
+    static uint32_t sums[maxThreads];
+    static ThreadHandle handles[maxThreads];
+    uint64_t total = 0;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (m_isActive) charge();
+    for (size_t i = 0; i < maxThreads; ++i)
+    {
+        uint32_t sum = 0;
+        for (size_t b = 0; b < buckets; ++b) sum += m_slots[i].cycles[b];
+        sums[i] = sum;
+        handles[i] = m_slots[i].handle;
+        total += sum;
+    }
+    __set_PRIMASK(primask);
+    size_t count = 0;
+    for (size_t i = 0; i < maxThreads && count < capacity; ++i)
+    {
+        if (i >= firstThreadSlot && !handles[i]) continue;
+        const char* name =
+            i == idleSlot ? "(idle)" :
+            i == isrSlot ? "(interrupts)" :
+            i == otherSlot ? "(other)" :
+#if defined(USE_AZURE_RTOS)
+            handles[i]->tx_thread_name;
+#elif defined(USE_FREE_RTOS)
+            pcTaskGetName(handles[i]);
+#endif
+        load[count++] = { handles[i], name, sums[i], total ? 100.0f * sums[i] / total : 0.0f };
+    }
+    return count;
+}
+
+float OS::Profiler::idle(void)
+{
+    ThreadLoad load[1];
+    return get(load, 1) ? load[0].percent : 0.0f;
+}
+
+void OS::Profiler::dump(void)
+{
+    static ThreadLoad load[maxThreads];
+    size_t count = get(load, maxThreads);
+    Log::msg("CPU load (cycles / percent):");
+    for (size_t i = 0; i < count; ++i)
+        Log::msg("  %-32s %10u %6.2f%%",
+            load[i].name ? load[i].name : "?",
+            static_cast<unsigned>(load[i].cycles),
+            static_cast<double>(load[i].percent));
+}
+
+void OS::Profiler::threadEnter(ThreadHandle handle)
+{
+    if (!m_isActive) return;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    charge();
+    if (m_isrNesting) m_resumeOwner = slotOf(handle); else m_owner = slotOf(handle);
+    __set_PRIMASK(primask);
+}
+
+void OS::Profiler::threadExit(void)
+{
+    if (!m_isActive) return;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    charge();
+    if (m_isrNesting) m_resumeOwner = idleSlot; else m_owner = idleSlot;
+    __set_PRIMASK(primask);
+}
+
+void OS::Profiler::isrEnter(void)
+{
+    if (!m_isActive) return;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    charge();
+    if (!m_isrNesting++)
+    {
+        m_resumeOwner = m_owner;
+        m_owner = isrSlot;
+    }
+    __set_PRIMASK(primask);
+}
+
+void OS::Profiler::isrExit(void)
+{
+    if (!m_isActive) return;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    charge();
+    if (m_isrNesting && !--m_isrNesting) m_owner = m_resumeOwner;
+    __set_PRIMASK(primask);
+}
+
+void OS::Profiler::charge(void)
+{
+    uint32_t now = CycleCounter::now();
+    uint32_t elapsed = now - m_bucketStart;
+    if (elapsed >= m_bucketCycles)
+    {
+        size_t steps = elapsed / m_bucketCycles;
+        if (steps > buckets) steps = buckets;
+        while (steps--)
+        {
+            m_bucket = (m_bucket + 1) % buckets;
+            for (auto& slot : m_slots) slot.cycles[m_bucket] = 0;
+        }
+        m_bucketStart = now;
+    }
+    m_slots[m_owner].cycles[m_bucket] += now - m_last;
+    m_last = now;
+}
+
+size_t OS::Profiler::slotOf(ThreadHandle handle)
+{
+    if (!handle) return idleSlot;
+    constexpr size_t threadSlots = maxThreads - firstThreadSlot;
+    size_t index = (reinterpret_cast<uintptr_t>(handle) >> 3) % threadSlots;
+    for (size_t probe = 0; probe < threadSlots; ++probe, index = (index + 1) % threadSlots)
+    {
+        Slot& slot = m_slots[firstThreadSlot + index];
+        if (slot.handle == handle) return firstThreadSlot + index;
+        if (!slot.handle)
+        {
+            slot.handle = handle;
+            return firstThreadSlot + index;
+        }
+    }
+    return otherSlot; // The table is full.
+}
+
+#include "os_bindings.h"
+
+EXTERN_C_BEGIN
+
+void os_profiler_switched_in(void* handle) { OS::Profiler::threadEnter(static_cast<OS::ThreadHandle>(handle)); }
+
+void os_profiler_switched_out(void) { OS::Profiler::threadExit(); }
+
+void os_profiler_isr_enter(void) { OS::Profiler::isrEnter(); }
+
+void os_profiler_isr_exit(void) { OS::Profiler::isrExit(); }
+
+#if defined(USE_AZURE_RTOS) && defined(TX_ENABLE_EXECUTION_CHANGE_NOTIFY)
+
+#include "tx_thread.h"
+
+// ThreadX execution change notification hooks, called from the port scheduler and `SysTick_Handler`.
+
+void _tx_execution_initialize(void) { }
+
+void _tx_execution_thread_enter(void) { OS::Profiler::threadEnter(_tx_thread_current_ptr); }
+
+void _tx_execution_thread_exit(void) { OS::Profiler::threadExit(); }
+
+void _tx_execution_isr_enter(void) { OS::Profiler::isrEnter(); }
+
+void _tx_execution_isr_exit(void) { OS::Profiler::isrExit(); }
+
+#endif
+
+EXTERN_C_END
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file        Profiler.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Attributes CPU cycles to RTOS threads and interrupts. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     Azure RTOS: build with `TX_ENABLE_EXECUTION_CHANGE_NOTIFY` defined for both C and assembler sources.
+ *              The profiler then provides the `_tx_execution_*` hooks called by the ThreadX scheduler and `SysTick_Handler`.
+ *              On the Cortex-M33 port no other interrupt calls them, the HAL handlers in `stm32u5xx_it.c`
+ *              call `os_profiler_isr_enter()` / `os_profiler_isr_exit()` instead.
+ *              FreeRTOS: add to `FreeRTOSConfig.h`:
+ *              `#define traceTASK_SWITCHED_IN() os_profiler_switched_in(pxCurrentTCB)`
+ *              `#define traceTASK_SWITCHED_OUT() os_profiler_switched_out()`
+ *              Interrupts that are not wrapped with `isrEnter()` / `isrExit()` are attributed to the preempted thread.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "StaticClass.hpp"
+#include "RTOS.hpp"
+
+namespace OS
+{
+
+/// @brief CPU load of a single RTOS thread over the profiler window.
+struct ThreadLoad
+{
+    ThreadHandle handle;    ///< RTOS thread handle, `nullptr` for idle, interrupts and other.
+    const char* name;       ///< Thread name.
+    uint32_t cycles;        ///< CPU cycles used within the window.
+    float percent;          ///< CPU usage percentage within the window.
+};
+
+/// @brief Attributes CPU cycles to RTOS threads and interrupts using the DWT cycle counter.
+/// @remarks Cycles are accumulated in `buckets` sub-windows, so the reported load covers a sliding window.
+///          The per-switch cost is a cycle counter read and a short hash table lookup.
+class Profiler final
+{
+    STATIC(Profiler)
+
+public:
+
+    static constexpr size_t buckets = 8;                            ///< The number of sub-windows in the sliding window.
+    static constexpr size_t maxThreads = WTK_OS_PROFILER_THREADS;   ///< The number of thread slots, including idle, interrupts and other.
+
+    /// @brief Starts profiling.
+    /// @param windowMs Sliding window length in milliseconds. Default 1000.
+    static void start(uint32_t windowMs = 1000);
+
+    /// @brief Stops profiling. The last results are preserved.
+    static void stop(void);
+
+    /// @returns True if the profiler is started.
+    static inline bool active() { return m_isActive; }
+
+    /// @brief Gets the CPU load of the threads over the sliding window.
+    /// @param load An array to fill. The first 3 elements are idle, interrupts and other (untracked threads).
+    /// @param capacity The array length.
+    /// @returns The number of elements filled.
+    static size_t get(ThreadLoad* load, size_t capacity);
+
+    /// @returns The idle CPU percentage over the sliding window.
+    static float idle(void);
+
+    /// @brief Logs the CPU load of all threads over the sliding window.
+    static void dump(void);
+
+public: // Hooks called by the RTOS:
+
+    /// @brief Called when the thread is scheduled to run.
+    /// @param handle RTOS thread handle.
+    static void threadEnter(ThreadHandle handle);
+
+    /// @brief Called when the current thread stops running.
+    static void threadExit(void);
+
+    /// @brief Called when an interrupt service routine starts.
+    static void isrEnter(void);
+
+    /// @brief Called when an interrupt service routine ends.
+    static void isrExit(void);
+
+private:
+
+    static constexpr size_t idleSlot = 0;   // Cycles spent without a thread running.
+    static constexpr size_t isrSlot = 1;    // Cycles spent in interrupt service routines.
+    static constexpr size_t otherSlot = 2;  // Cycles spent in threads not fitting the table.
+    static constexpr size_t firstThreadSlot = 3;
+
+    /// @brief Per-thread counters.
+    struct Slot
+    {
+        ThreadHandle handle;        // RTOS thread handle.
+        uint32_t cycles[buckets];   // Cycles used in each bucket.
+    };
+
+    /// @brief Attributes the cycles elapsed since the last event to the current owner, rotates the buckets if needed.
+    static void charge(void);
+
+    /// @param handle RTOS thread handle.
+    /// @returns The slot index for the thread.
+    static size_t slotOf(ThreadHandle handle);
+
+    static inline Slot m_slots[maxThreads] = {};    // Thread slots.
+    static inline size_t m_owner = {};              // The slot the current cycles are attributed to.
+    static inline size_t m_resumeOwner = {};        // The slot to return to after the interrupt.
+    static inline uint32_t m_isrNesting = {};       // Interrupt nesting level.
+    static inline uint32_t m_last = {};             // Cycle count at the last event.
+    static inline uint32_t m_bucketStart = {};      // Cycle count at the current bucket start.
+    static inline uint32_t m_bucketCycles = {};     // Bucket length in cycles.
+    static inline size_t m_bucket = {};             // Current bucket index.
+    static inline bool m_isActive = {};             // True if the profiler is started.
+
+};
+
+}
@@ -54,4 +54,28 @@ OS::TickCount OS::getTick(void)
     return CurrentThread::isISRContext() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
 }
 
+#elif defined(USE_POSIX)
+
+#include <chrono>
+#include <thread>
+
+/// @brief The time the ticks are counted from.
+static const auto tickStart = std::chrono::steady_clock::now();
+
+void OS::yield(void)
+{
+    std::this_thread::yield();
+}
+
+void OS::delay(TickCount ticks)
+{
+    std::this_thread::sleep_for(toDuration(ticks));
+}
+
+OS::TickCount OS::getTick(void)
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart);
+    return static_cast<TickCount>(static_cast<uint64_t>(elapsed.count()) * WTK_OS_TICKS_PER_SECOND / 1000000U);
+}
+
 #endif
@@ -28,6 +28,8 @@ using ThreadEntry = void(*)(ThreadArg); // Thread entry function pointer type.
 using ThreadHandle = TX_THREAD*;        // A pointer used to identify a RTOS thread.
 using NativePriority = unsigned int;    // An integer containing numerical value of a thread priority.
 
+static constexpr uint32_t stackFill = TX_STACK_FILL; // The pattern the thread stacks are filled with on creation.
+
 }
 
 #elif defined(USE_FREE_RTOS)
@@ -46,11 +48,52 @@ using ThreadEntry = void(*)(ThreadArg); // Thread entry function pointer type.
 using ThreadHandle = TaskHandle_t;      // A pointer used to identify a RTOS thread.
 using NativePriority = uint32_t;        // An integer containing numerical value of a thread priority.
 
+static constexpr uint32_t stackFill = 0xa5a5a5a5UL; // The pattern the thread stacks are filled with on creation.
+
+}
+
+#elif defined(USE_POSIX)
+
+#include <chrono>
+#include <cstdint>
+#include <pthread.h>
+
+namespace OS
+{
+
+using EventFlags = uint32_t;            // An integer containing event flags of the `EventGroup`.
+using TickCount = uint32_t;             // An integer containing a number of RTOS ticks to wait.
+using ThreadArg = void*;                // Thread entry function argument type.
+using ThreadEntry = void(*)(ThreadArg); // Thread entry function pointer type.
+using NativePriority = uint32_t;        // An integer containing numerical value of a thread priority.
+
+/// @brief Host thread control block.
+struct HostThread
+{
+    pthread_t thread;           // POSIX thread.
+    ThreadEntry entry;          // Thread entry function.
+    ThreadArg arg;              // Entry function argument.
+    const char* name;           // Thread name.
+    NativePriority priority;    // Thread priority, the host scheduler doesn't use it.
+};
+
+using ThreadHandle = HostThread*;       // A pointer used to identify a host thread.
+
+static constexpr uint32_t stackFill = 0; // Not used, the host threads run on the system allocated stacks.
+
+/// @brief Converts RTOS ticks to the host clock duration.
+/// @param ticks The number of RTOS ticks.
+/// @returns Duration.
+inline std::chrono::microseconds toDuration(TickCount ticks)
+{
+    return std::chrono::microseconds(static_cast<uint64_t>(ticks) * 1000000U / WTK_OS_TICKS_PER_SECOND);
+}
+
 }
 
 #endif
 
-#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS)
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS) or defined(USE_POSIX)
 
 // Common types and functions:
 
@@ -79,6 +122,27 @@ enum WaitOptions : uint32_t
 /// @brief A `TickCount` value indicating no timeout or infinite wait time.
 static constexpr TickCount waitForever = static_cast<TickCount>(-1);
 
+/// @brief Converts milliseconds to RTOS ticks using integer arithmetic, rounding up.
+/// @param milliseconds Time in milliseconds.
+/// @returns The number of RTOS ticks.
+static constexpr TickCount msToTicks(uint32_t milliseconds)
+{
+    return static_cast<TickCount>((static_cast<uint64_t>(milliseconds) * WTK_OS_TICKS_PER_SECOND + 999U) / 1000U);
+}
+
+/// @brief A time amount in milliseconds, a distinct type, so it's never confused with a plain number of seconds or ticks.
+struct Milliseconds final
+{
+    /// @brief Creates the time amount.
+    /// @param value Time in milliseconds.
+    explicit constexpr Milliseconds(uint32_t value) : value(value) { }
+
+    /// @returns The number of RTOS ticks, rounded up.
+    constexpr TickCount ticks() const { return msToTicks(value); }
+
+    uint32_t value; ///< Time in milliseconds.
+};
+
 /// @brief Yields the execution of the current thread and lets the system resume other threads.
 void yield(void);
 
@@ -10,11 +10,13 @@
 
 #include "Semaphore.hpp"
 #include "CurrentThread.hpp"
+#include "LockProfiler.hpp"
+#include "CycleCounter.hpp"
 #include "Crash.hpp"
 
 #if defined(USE_AZURE_RTOS)
 
-OS::Semaphore::Semaphore() : m_controlBlock(), m_isCreated(false), m_isTaken(false) { }
+OS::Semaphore::Semaphore() : m_controlBlock(), m_isCreated(false), m_isTaken(false), m_stats() { }
 
 OS::Semaphore::~Semaphore()
 {
@@ -25,14 +27,9 @@ OS::Semaphore::~Semaphore()
     }
 }
 
-bool OS::Semaphore::wait(TickCount timeout)
+bool OS::Semaphore::take(TickCount timeout)
 {
-    if (m_isTaken || CurrentThread::isISRContext()) Crash::here();
-    init();
-    m_isTaken = true;
-    bool ok = tx_semaphore_get(&m_controlBlock, timeout) == TX_SUCCESS;
-    m_isTaken = false;
-    return ok;
+    return tx_semaphore_get(&m_controlBlock, timeout) == TX_SUCCESS;
 }
 
 bool OS::Semaphore::release(void)
@@ -44,28 +41,24 @@ bool OS::Semaphore::release(void)
 void OS::Semaphore::init(void)
 {
     if (m_isCreated) return;
-    auto result = tx_semaphore_create(&m_controlBlock, nullptr, 0);
+    CHAR* name = m_stats ? const_cast<CHAR*>(m_stats->name) : nullptr;
+    auto result = tx_semaphore_create(&m_controlBlock, name, 0);
     m_isCreated = result == TX_SUCCESS;
     if (!m_isCreated) Crash::here(); // Semaphore creation failed!
 }
 
 #elif defined(USE_FREE_RTOS)
 
-OS::Semaphore::Semaphore() : m_buffer(), m_handle(), m_isTaken(false) { }
+OS::Semaphore::Semaphore() : m_buffer(), m_handle(), m_isTaken(false), m_stats() { }
 
 OS::Semaphore::~Semaphore()
 {
     if (m_handle) m_handle = nullptr;
 }
 
-bool OS::Semaphore::wait(TickCount timeout)
+bool OS::Semaphore::take(TickCount timeout)
 {
-    if (m_isTaken || CurrentThread::isISRContext()) Crash::here();
-    init();
-    m_isTaken = true;
-    bool ok = xSemaphoreTake(m_handle, timeout) == pdTRUE;
-    m_isTaken = false;
-    return ok;
+    return xSemaphoreTake(m_handle, timeout) == pdTRUE;
 }
 
 bool OS::Semaphore::release(void)
@@ -91,4 +84,68 @@ void OS::Semaphore::init(void)
     if (!m_handle) Crash::here(); // Semaphore creation failed!
 }
 
+#elif defined(USE_POSIX)
+
+OS::Semaphore::Semaphore() : m_mutex(), m_released(), m_isReleased(false), m_isTaken(false), m_stats() { }
+
+OS::Semaphore::~Semaphore() { }
+
+bool OS::Semaphore::take(TickCount timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto isReleased = [this]() { return m_isReleased; };
+    if (timeout == waitForever) m_released.wait(lock, isReleased);
+    else if (!m_released.wait_for(lock, toDuration(timeout), isReleased)) return false;
+    m_isReleased = false;
+    return true;
+}
+
+bool OS::Semaphore::release(void)
+{
+    if (!m_isTaken) return false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isReleased = true;
+    }
+    m_released.notify_one();
+    return true;
+}
+
+void OS::Semaphore::init(void) { }
+
+#endif
+
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS) or defined(USE_POSIX)
+
+bool OS::Semaphore::wait(TickCount timeout)
+{
+    if (m_isTaken || CurrentThread::isISRContext()) Crash::here();
+    init();
+    m_isTaken = true;
+    bool ok;
+    if (!m_stats) ok = take(timeout);
+    else
+    {
+        bool contended = false;
+        uint32_t start = CycleCounter::now();
+        ok = take(0);
+        if (!ok && timeout)
+        {
+            contended = true;
+            ok = take(timeout);
+        }
+        const uint32_t waitCycles = contended ? CycleCounter::since(start) : 0;
+        if (ok) LockProfiler::acquired(m_stats, waitCycles, contended);
+        else LockProfiler::failed(m_stats, waitCycles);
+    }
+    m_isTaken = false;
+    return ok;
+}
+
+bool OS::Semaphore::profile(const char* name)
+{
+    if (!m_stats) m_stats = LockProfiler::attach(name);
+    return m_stats != nullptr;
+}
+
 #endif
@@ -12,9 +12,16 @@
 
 #include "RTOS.hpp"
 
+#if defined(USE_POSIX)
+#include <condition_variable>
+#include <mutex>
+#endif
+
 namespace OS
 {
 
+struct LockStats;
+
 /// @brief Binary semaphore.
 class Semaphore
 {
@@ -36,8 +43,18 @@ public:
     /// @returns True if the system call completed successfully.
     bool release(void);
 
+    /// @brief Starts collecting the wait statistics of this semaphore in `LockProfiler`.
+    /// @param name Semaphore name shown in the statistics, must point to a static string.
+    /// @returns True if profiled, false if there are no free `LockProfiler` slots.
+    bool profile(const char* name);
+
 private:
 
+    /// @brief Takes the native semaphore.
+    /// @param timeout The time to wait expressed in RTOS ticks.
+    /// @returns True if taken.
+    bool take(TickCount timeout);
+
     /// @brief Performs the lazy initialization of the control block if required.
     void init(void);
 
@@ -47,9 +64,14 @@ private:
 #elif defined(USE_FREE_RTOS)
     StaticSemaphore_t m_buffer; // A statically allocated buffer for the data.
     SemaphoreHandle_t m_handle; // A pointer used to access the data.
+#elif defined(USE_POSIX)
+    std::mutex m_mutex;                 // Protects the state.
+    std::condition_variable m_released; // Notified when the semaphore is released.
+    bool m_isReleased;                  // True if released and not taken yet.
 #endif
 
-    bool m_isTaken; // True if the semaphore is taken.
+    bool m_isTaken;     // True if the semaphore is taken.
+    LockStats* m_stats; // Wait statistics, `nullptr` if not profiled.
 
 };
 
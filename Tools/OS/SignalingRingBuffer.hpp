@@ -0,0 +1,99 @@
+/**
+ * @file        SignalingRingBuffer.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A single-producer / single-consumer ring buffer that wakes up a waiting consumer thread. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "RingBuffer.hpp"
+#include "EventGroup.hpp"
+
+namespace OS
+{
+
+/**
+ * @brief A lock-free ring buffer for passing data from an ISR (or a thread) to a consumer thread.
+ *        The producer never blocks. The consumer can block until the data is available.
+ *
+ * @remarks The event group is signaled only when the consumer is actually waiting,
+ *          so pushing from a high rate ISR costs one atomic load when the consumer is busy.
+ *
+ * @tparam TSize Capacity. Must be a power of 2.
+ * @tparam TElement Element type. Must be trivially copyable.
+ */
+template<size_t TSize, typename TElement>
+class SignalingRingBuffer : public RingBuffer<TSize, TElement>
+{
+
+public:
+
+    using BaseType = RingBuffer<TSize, TElement>;
+
+    /// @brief Creates a new empty ring buffer.
+    SignalingRingBuffer() : BaseType(), m_event(), m_isWaiting(false) { }
+
+    /// @brief Writes one element and wakes up the consumer. ISR safe.
+    /// @param element Element reference.
+    /// @returns True if written, false if the buffer is full.
+    bool push(const TElement& element)
+    {
+        if (!BaseType::push(element)) return false;
+        notify();
+        return true;
+    }
+
+    /// @brief Writes as many elements as it fits and wakes up the consumer. ISR safe.
+    /// @param elements Source elements.
+    /// @param count The number of elements to write.
+    /// @returns The number of elements actually written.
+    size_t pushN(const TElement* elements, size_t count)
+    {
+        count = BaseType::pushN(elements, count);
+        if (count) notify();
+        return count;
+    }
+
+    /// @brief Publishes elements written directly to the region returned by `writeSpan()` and wakes up the consumer. ISR safe.
+    /// @param count The number of elements written. Must not exceed the span length.
+    void commitWrite(size_t count)
+    {
+        BaseType::commitWrite(count);
+        if (count) notify();
+    }
+
+    /// @brief Blocks the consumer thread until any data is available. DO NOT CALL FROM ISR!
+    /// @param timeout Time limit in RTOS ticks. Default: `waitForever`.
+    /// @returns True if the data is available, false on timeout.
+    bool wait(TickCount timeout = waitForever)
+    {
+        if (BaseType::any()) return true;
+        m_event.wait(dataReady, waitAny, 0); // Creates the event group in the thread context and clears a stale signal.
+        m_isWaiting.store(true, std::memory_order_seq_cst);
+        if (!BaseType::any()) m_event.wait(dataReady, waitAny, timeout);
+        m_isWaiting.store(false, std::memory_order_relaxed);
+        return BaseType::any();
+    }
+
+private:
+
+    static constexpr EventFlags dataReady = 1; // The event flag set when new data is written.
+
+    /// @brief Signals the event if the consumer is waiting.
+    inline void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isWaiting.load(std::memory_order_relaxed)) m_event.signal(dataReady);
+    }
+
+    EventGroup m_event;                 // Consumer wake-up event.
+    std::atomic<bool> m_isWaiting;      // True when the consumer is about to block or blocked.
+
+};
+
+}
@@ -0,0 +1,81 @@
+/**
+ * @file        StackMonitor.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Reports the stack usage of all RTOS threads. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "StackMonitor.hpp"
+#include "ThreadBase.hpp"
+#include "Log.hpp"
+
+#if defined(USE_AZURE_RTOS)
+
+#include "tx_thread.h"
+
+size_t OS::StackMonitor::get(StackInfo* info, size_t capacity)
+{
+    size_t count = 0;
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    TX_THREAD* thread = _tx_thread_created_ptr;
+    ULONG remaining = _tx_thread_created_count;
+    TX_RESTORE
+    for (; thread && remaining && count < capacity; --remaining, thread = thread->tx_thread_created_next)
+    {
+        ThreadBase t(thread);
+        info[count++] = { thread, thread->tx_thread_name, t.stackSize(), t.stackHighWaterMark(), t.stackHeadroom() };
+    }
+    return count;
+}
+
+#elif defined(USE_FREE_RTOS)
+
+#include "task.h"
+
+size_t OS::StackMonitor::get(StackInfo* info, size_t capacity)
+{
+#if configUSE_TRACE_FACILITY == 1
+    static TaskStatus_t status[maxThreads];
+    size_t count = uxTaskGetSystemState(status, maxThreads, nullptr);
+    if (count > capacity) count = capacity;
+    for (size_t i = 0; i < count; ++i)
+        info[i] = { status[i].xHandle, status[i].pcTaskName, 0, 0, status[i].usStackHighWaterMark * sizeof(StackType_t) };
+    return count;
+#else
+    (void)info;
+    (void)capacity;
+    return 0; // Enumerating tasks requires `configUSE_TRACE_FACILITY`.
+#endif
+}
+
+#elif defined(USE_POSIX)
+
+size_t OS::StackMonitor::get(StackInfo* info, size_t capacity)
+{
+    (void)info;
+    (void)capacity;
+    return 0; // The host threads run on the system allocated stacks.
+}
+
+#endif
+
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS) or defined(USE_POSIX)
+
+void OS::StackMonitor::dump(void)
+{
+    static StackInfo info[maxThreads];
+    size_t count = get(info, maxThreads);
+    Log::msg("Thread stacks (size / high-water mark / headroom):");
+    for (size_t i = 0; i < count; ++i)
+        Log::msg("  %-32s %6u %6u %6u",
+            info[i].name ? info[i].name : "?",
+            static_cast<unsigned>(info[i].size),
+            static_cast<unsigned>(info[i].highWaterMark),
+            static_cast<unsigned>(info[i].headroom));
+}
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file        StackMonitor.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Reports the stack usage of all RTOS threads. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "StaticClass.hpp"
+#include "RTOS.hpp"
+
+namespace OS
+{
+
+/// @brief Stack usage of a single RTOS thread.
+struct StackInfo
+{
+    ThreadHandle handle;    ///< RTOS thread handle.
+    const char* name;       ///< Thread name, can be `nullptr`.
+    size_t size;            ///< Stack size in bytes, zero if unknown.
+    size_t highWaterMark;   ///< The maximal number of stack bytes used, zero if unknown.
+    size_t headroom;        ///< The number of stack bytes never used.
+};
+
+/// @brief Reports the stack usage of all RTOS threads, including the threads not created by the toolkit.
+/// @remarks Relies on the stacks being filled with the `stackFill` pattern on creation.
+class StackMonitor final
+{
+    STATIC(StackMonitor)
+
+public:
+
+    /// @brief Gets the stack usage of the RTOS threads. DO NOT CALL FROM ISR!
+    /// @param info An array to fill.
+    /// @param capacity The array length.
+    /// @returns The number of elements filled.
+    static size_t get(StackInfo* info, size_t capacity);
+
+    /// @brief Logs the stack usage of all RTOS threads. DO NOT CALL FROM ISR!
+    static void dump(void);
+
+private:
+
+    static constexpr size_t maxThreads = 32; // The maximal number of threads reported by `dump()`.
+
+};
+
+}
@@ -10,18 +10,49 @@
 
 #include "Task.hpp"
 
-void OS::Task::process(ThreadContext context, size_t* immediateCount, size_t* delayedCount)
+bool OS::Task::process(ThreadContext context, size_t* immediateCount, size_t* delayedCount, SchedulingStats* stats)
 {
     m_mutex.acquire();
     auto tcb = m_tcb; // Since we release mutex while the task is being run, we use a snapshot of the task control block.
     m_mutex.release();
-    if (!tcb.id || tcb.delayTicks || tcb.context != context) return;
+    if (!tcb.id || tcb.isDelayed || tcb.context != context) return false;
+    const TickCount start = getTick();
+    const uint32_t startCycles = CycleCounter::now();
     if (tcb.binding) tcb.action.binding(tcb.binding);
     else tcb.action.plain();
+    if (stats)
+    {
+        stats->duration.add(CycleCounter::since(startCycles));
+        stats->latency.add(startCycles - tcb.readyCycles);
+    }
     m_mutex.acquire();
+    if (m_tcb.id != tcb.id) // Canceled or replaced by the action, counters already updated.
+    {
+        m_mutex.release();
+        return true;
+    }
+    TaskTiming& timing = m_tcb.timing;
+    const TickCount lateness = start - tcb.releaseTick;
+    ++timing.runs;
+    timing.lastLateness = lateness;
+    if (lateness > timing.maxLateness) timing.maxLateness = lateness;
     if (m_tcb.resetTicks)
     {
-        m_tcb.delayTicks = m_tcb.resetTicks;
+        const TickCount period = m_tcb.resetTicks;
+        TickCount next = tcb.releaseTick + period;
+        const TickCount now = getTick();
+        if (static_cast<int32_t>(now - next) >= 0) // The next release time has already passed.
+        {
+            if (m_tcb.policy == skipMissed)
+            {
+                const TickCount skipped = (now - next) / period + 1;
+                timing.missed += skipped;
+                next += skipped * period;
+            }
+            else ++timing.missed;
+        }
+        m_tcb.releaseTick = next;
+        m_tcb.isDelayed = true;
         if (immediateCount && *immediateCount) --*immediateCount; // The task stops being immediate...
         if (delayedCount) ++*delayedCount; // ...and becomes delayed.
     }
@@ -31,21 +62,42 @@ void OS::Task::process(ThreadContext context, size_t* immediateCount, size_t* de
         m_tcb.clear();
     }
     m_mutex.release();
+    return true;
 }
 
-bool OS::Task::delayTick(size_t* immediateCount, size_t* delayedCount)
+bool OS::Task::tryRelease(TickCount now, TickCount& timeout, size_t* immediateCount, size_t* delayedCount)
 {
-    bool matched = false, zeroed = false;
+    bool released = false;
     m_mutex.acquire();
-    matched = m_tcb.id != 0 && m_tcb.delayTicks != 0;
-    zeroed = matched && --m_tcb.delayTicks == 0;
+    if (m_tcb.id && m_tcb.isDelayed)
+    {
+        const int32_t remaining = static_cast<int32_t>(m_tcb.releaseTick - now);
+        if (remaining <= 0)
+        {
+            // The task became ready at its release time, so the latency includes the delay thread wake-up time.
+            const uint32_t cyclesPerTick = CycleCounter::frequency() / WTK_OS_TICKS_PER_SECOND;
+            m_tcb.readyCycles = CycleCounter::now() - static_cast<uint32_t>(-remaining) * cyclesPerTick;
+            m_tcb.isDelayed = false;
+            released = true;
+        }
+        else if (static_cast<TickCount>(remaining) < timeout) timeout = remaining;
+    }
     m_mutex.release();
-    if (zeroed)
+    if (released)
     {
         if (immediateCount) ++*immediateCount; // The task becomes immediate...
         if (delayedCount && *delayedCount) --*delayedCount; // ...and stops being delayed.
     }
-    return zeroed;
+    return released;
+}
+
+bool OS::Task::timing(TaskId id, TaskTiming& timing)
+{
+    m_mutex.acquire();
+    bool matched = id && m_tcb.id == id;
+    if (matched) timing = m_tcb.timing;
+    m_mutex.release();
+    return matched;
 }
 
 bool OS::Task::cancel(TaskId &id, size_t* immediateCount, size_t* delayedCount)
@@ -56,7 +108,7 @@ bool OS::Task::cancel(TaskId &id, size_t* immediateCount, size_t* delayedCount)
     if (matched)
     {
         id = 0;
-        if (m_tcb.delayTicks)
+        if (m_tcb.isDelayed)
         {
             if (delayedCount && *delayedCount) --*delayedCount;
         }
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Mutex.hpp"
+#include "CycleCounter.hpp"
 #include "TaskControlBlock.hpp"
 
 namespace OS
@@ -70,12 +71,14 @@ private:
     /// @param action Action to call when `run` method is called.
     /// @param context Target thread context. Default: `application`.
     /// @param time The number of RTOS ticks to wait before the task can be run. Default: 0.
-    /// @param reset The number of RTOS ticks to reset the `time` value to when it elapses. Default: 0.
+    /// @param reset The repeat period in RTOS ticks. Default: 0 (one-shot).
+    /// @param policy What to do when a periodic task misses its release time. Default: `catchUp`.
     /// @returns Task identifier.
-    inline TaskId schedule(void* arg, OptionalBindingAction action, ThreadContext context = application, TickCount time = 0, TickCount reset = 0)
+    inline TaskId schedule(void* arg, OptionalBindingAction action, ThreadContext context = application,
+                           TickCount time = 0, TickCount reset = 0, MissedReleasePolicy policy = catchUp)
     {
         m_mutex.acquire();
-        TaskId id = scheduleUnsafe(arg, action, context, time, reset);
+        TaskId id = scheduleUnsafe(arg, action, context, time, reset, policy);
         m_mutex.release();
         return id;
     }
@@ -85,29 +88,47 @@ private:
     /// @param action Action to call when `run` method is called.
     /// @param context Target thread context. Default: `application`.
     /// @param time The number of RTOS ticks to wait before the task can be run. Default: 0.
-    /// @param reset The number of RTOS ticks to reset the `time` value to when it elapses. Default: 0.
+    /// @param reset The repeat period in RTOS ticks. Default: 0 (one-shot).
+    /// @param policy What to do when a periodic task misses its release time. Default: `catchUp`.
     /// @returns Task identifier.
-    inline TaskId scheduleUnsafe(void* arg, OptionalBindingAction action, ThreadContext context = application, TickCount time = 0, TickCount reset = 0)
+    inline TaskId scheduleUnsafe(void* arg, OptionalBindingAction action, ThreadContext context = application,
+                                 TickCount time = 0, TickCount reset = 0, MissedReleasePolicy policy = catchUp)
     {
         m_tcb.binding = arg;
         m_tcb.action = action;
         m_tcb.context = context;
-        m_tcb.delayTicks = time;
+        m_tcb.releaseTick = getTick() + time;
         m_tcb.resetTicks = reset;
+        m_tcb.isDelayed = time != 0;
+        m_tcb.policy = policy;
+        m_tcb.timing = {};
+        m_tcb.readyCycles = CycleCounter::now();
         return m_tcb.id;
     }
 
     // Processes the task:
-    // If the `id` is set and the `delayTicks` is zero, and the `context` is matched, the task action is called.
+    // If the `id` is set and the task is released, and the `context` is matched, the task action is called.
     // When the `resetTicks` is zero, the task is not recurring and will be cleared.
-    // Otherwise, the `delayTicks` value will be reset to the value of `resetTicks`.
-    void process(ThreadContext context, size_t* immediateCount = nullptr, size_t* delayedCount = nullptr);
-
-    /// @brief Decreases the `delayTick` for the task, optionally updates tasks counters. Thread safe.
+    // Otherwise, the next release time is the previous release time plus `resetTicks`,
+    // so the period does not drift by the action run time or the dispatch latency.
+    // When `stats` is set, the ready-to-start latency and the action run time are recorded in it.
+    // Returns true if the task action was called.
+    bool process(ThreadContext context, size_t* immediateCount = nullptr, size_t* delayedCount = nullptr,
+                 SchedulingStats* stats = nullptr);
+
+    /// @brief Releases the task if its release time has come, optionally updates tasks counters. Thread safe.
+    /// @param now Current RTOS tick count.
+    /// @param timeout Reference to the number of ticks to the nearest release time, reduced if this task is released earlier.
     /// @param immediateCount An optional pointer to the immediate tasks counter.
     /// @param delayedCount An optional pointer to the delayed tasks counter.
-    /// @returns True if the delay was active and was zeroed. False otherwise.
-    bool delayTick(size_t* immediateCount = nullptr, size_t* delayedCount = nullptr);
+    /// @returns True if the task was delayed and got released. False otherwise.
+    bool tryRelease(TickCount now, TickCount& timeout, size_t* immediateCount = nullptr, size_t* delayedCount = nullptr);
+
+    /// @brief Gets the timing statistics of the task if the identifier is matched. Thread safe.
+    /// @param id Task identifier.
+    /// @param timing Target reference.
+    /// @returns True if the task was matched.
+    bool timing(TaskId id, TaskTiming& timing);
 
     /// @brief Clears the task control block if the identifier is matched. Thread safe.
     /// @param id Task identifier reference.
@@ -11,11 +11,35 @@
 #pragma once
 
 #include "Action.hpp"
+#include "Log2Histogram.hpp"
 #include "RTOS.hpp"
 
 namespace OS
 {
 
+/// @brief Defines what a periodic task does when its release time has passed before the previous run completed.
+enum MissedReleasePolicy : uint8_t
+{
+    catchUp,        // Run the missed periods as soon as possible, keeping the release times.
+    skipMissed      // Skip the missed periods, release at the next future period boundary.
+};
+
+/// @brief Timing statistics of a scheduled task.
+struct TaskTiming final
+{
+    uint32_t runs;          ///< The number of times the task action was called.
+    uint32_t missed;        ///< The number of release times missed (periodic tasks).
+    TickCount lastLateness; ///< RTOS ticks between the release time and the action call, last run.
+    TickCount maxLateness;  ///< RTOS ticks between the release time and the action call, maximum (jitter).
+};
+
+/// @brief Scheduling statistics of a thread context in CPU cycles.
+struct SchedulingStats final
+{
+    Log2Histogram latency;  ///< From the task becoming ready (scheduled or released) to the action call.
+    Log2Histogram duration; ///< The action run time.
+};
+
 /// @brief An action binding structure for a scheduled function call.
 struct TaskControlBlock final
 {
@@ -23,11 +47,16 @@ struct TaskControlBlock final
     void* binding;                  // Optional action binding.
     OptionalBindingAction action;   // Action callback.
     ThreadContext context;          // Thread context.
-    TickCount delayTicks;           // RTOS ticks to wait before this task is called.
-    TickCount resetTicks;           // RTOS ticks to reset the `delayTicks` to repeat the task.
+    TickCount releaseTick;          // Absolute RTOS tick the task is released at.
+    TickCount resetTicks;           // Repeat period in RTOS ticks, zero for one-shot tasks.
+    bool isDelayed;                 // True if the task waits for its release time.
+    MissedReleasePolicy policy;     // What to do when a periodic task misses its release time.
+    TaskTiming timing;              // Timing statistics.
+    uint32_t readyCycles;           // CPU cycle count at the moment the task became ready to run.
 
     /// @brief Creates an empty task control block.
-    TaskControlBlock() : id(0), binding(), action(), context(none), delayTicks(0), resetTicks(0) { }
+    TaskControlBlock() : id(0), binding(), action(), context(none), releaseTick(0), resetTicks(0),
+        isDelayed(false), policy(catchUp), timing(), readyCycles(0) { }
 
     /// @brief Resets the task control block to an empty state.
     inline void clear(void)
@@ -36,8 +65,12 @@ struct TaskControlBlock final
         binding = nullptr;
         action = nullptr;
         context = none;
-        delayTicks = 0;
+        releaseTick = 0;
         resetTicks = 0;
+        isDelayed = false;
+        policy = catchUp;
+        timing = {};
+        readyCycles = 0;
     }
 
 };
@@ -9,22 +9,23 @@
  */
 
 #include "TaskScheduler.hpp"
+#include "CycleCounter.hpp"
+#include "Log.hpp"
 
-OS::TaskId OS::TaskScheduler::schedule(void *arg, OptionalBindingAction action, ThreadContext context, TickCount time, TickCount reset)
+OS::TaskId OS::TaskScheduler::schedule(void *arg, OptionalBindingAction action, ThreadContext context,
+                                       TickCount time, TickCount reset, MissedReleasePolicy policy)
 {
     TaskId id = 0;
+    CycleCounter::init(); // Tasks are stamped with the cycle count.
     for (auto& task : m_tasks)
     {
         task.lock();
         if (task.acquireUnsafe())
         {
             if (time) ++m_delayed; else ++m_immediate;
-            id = task.scheduleUnsafe(arg, action, context, time, reset);
+            id = task.scheduleUnsafe(arg, action, context, time, reset, policy);
             task.unlock();
-            if (time)
-                m_delaySemaphore.release();
-            else
-                m_dispatchSemaphore.release();
+            m_events.signal(time ? delayEvent : dispatchEvent);
             return id;
         }
         task.unlock();
@@ -32,3 +33,71 @@ OS::TaskId OS::TaskScheduler::schedule(void *arg, OptionalBindingAction action,
     Crash::here(); // Crash if task pool depleted.
     return id; // Silence compiler warning.
 }
+
+void OS::TaskScheduler::frameTick(void)
+{
+    CycleCounter::init();
+    if (!m_frameBudget) m_frameBudget = CycleCounter::fromMicroseconds(WTK_OS_FRAME_BUDGET_US);
+    const uint32_t start = CycleCounter::now();
+    ++m_frameStats.frames;
+    if (immediateCount())
+    {
+        size_t visited = 0;
+        bool any = false;
+        for (; visited < size; ++visited)
+        {
+            if (CycleCounter::since(start) >= m_frameBudget) break; // The rest is carried over to the next frame.
+            any |= m_tasks[(m_frameCursor + visited) % size].process(frame, &m_immediate, &m_delayed, &m_stats[1]);
+        }
+        if (any && m_delayed) m_events.signal(delayEvent); // Periodic tasks got new release times.
+        if (visited < size)
+        {
+            m_frameCursor = (m_frameCursor + visited) % size;
+            ++m_frameStats.deferrals;
+        }
+    }
+    const uint32_t elapsed = CycleCounter::since(start);
+    m_frameStats.lastCycles = elapsed;
+    if (elapsed > m_frameStats.maxCycles) m_frameStats.maxCycles = elapsed;
+    if (elapsed <= m_frameBudget) return;
+    ++m_frameStats.overruns;
+    const TickCount now = getTick();
+    if (m_lastOverrunReport && now - m_lastOverrunReport < WTK_OS_TICKS_PER_SECOND) return; // Report once per second at most.
+    m_lastOverrunReport = now ? now : 1;
+    Log::msg(LogMessage::warning, "Frame tasks overrun: %luus of %luus budget, %lu overruns in %lu frames.",
+        static_cast<unsigned long>(CycleCounter::toMicroseconds(elapsed)),
+        static_cast<unsigned long>(CycleCounter::toMicroseconds(m_frameBudget)),
+        static_cast<unsigned long>(m_frameStats.overruns),
+        static_cast<unsigned long>(m_frameStats.frames));
+}
+
+/// @brief Logs a histogram with the bin bounds in microseconds.
+/// @param title Histogram title.
+/// @param histogram Histogram reference.
+static void dumpHistogram(const char* title, const Log2Histogram& histogram)
+{
+    Log::msg("  %s: %lu samples, mean %luus, p99 %luus, max %luus", title,
+        static_cast<unsigned long>(histogram.count()),
+        static_cast<unsigned long>(CycleCounter::toMicroseconds(histogram.mean())),
+        static_cast<unsigned long>(CycleCounter::toMicroseconds(histogram.percentile(99))),
+        static_cast<unsigned long>(CycleCounter::toMicroseconds(histogram.max())));
+    for (size_t i = 0; i < Log2Histogram::bins; ++i)
+    {
+        if (!histogram.at(i)) continue;
+        Log::msg("    <= %10luus %8lu",
+            static_cast<unsigned long>(CycleCounter::toMicroseconds(Log2Histogram::upperBound(i))),
+            static_cast<unsigned long>(histogram.at(i)));
+    }
+}
+
+void OS::TaskScheduler::dumpSchedulingStats(void)
+{
+    static const char* const names[] = { "application", "frame" };
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const SchedulingStats stats = m_stats[i]; // A snapshot, the other context can be adding samples.
+        Log::msg("Scheduling stats, %s context:", names[i]);
+        dumpHistogram("latency", stats.latency);
+        dumpHistogram("duration", stats.duration);
+    }
+}
@@ -13,12 +13,24 @@
 #include "Crash.hpp"
 #include "Task.hpp"
 #include "Thread.hpp"
-#include "Semaphore.hpp"
+#include "EventGroup.hpp"
+#include "TimerService.hpp"
+#include "EventBus.hpp"
 #include <tuple>
 
 namespace OS
 {
 
+/// @brief Frame context processing statistics.
+struct FrameStats
+{
+    uint32_t frames;        ///< The number of frames processed.
+    uint32_t overruns;      ///< The number of frames that exceeded the budget.
+    uint32_t deferrals;     ///< The number of frames that left the tasks for the next frame.
+    uint32_t lastCycles;    ///< CPU cycles used by the last frame.
+    uint32_t maxCycles;     ///< The maximal number of CPU cycles used by a frame.
+};
+
 /// @brief A pool of scheduled action calls.
 class TaskScheduler final
 {
@@ -30,20 +42,21 @@ public:
     /// @param action Action to call when task `run` method is called.
     /// @param context Target thread context. Default: `application`.
     /// @param time The number of RTOS ticks to wait before the task can be run. Default: 0.
-    /// @param reset The number of RTOS ticks to reset the `time` value to when it elapses. Default: 0.
+    /// @param reset The repeat period in RTOS ticks. Default: 0 (one-shot).
+    /// @param policy What to do when a periodic task misses its release time. Default: `catchUp`.
     /// @returns Task identifier.
     TaskId schedule(void* arg, OptionalBindingAction action, ThreadContext context = application,
-                    TickCount time = 0, TickCount reset = 0);
+                    TickCount time = 0, TickCount reset = 0, MissedReleasePolicy policy = catchUp);
 
     /// @brief Starts the task scheduler, immediatelly calls immediate tasks, starts waiting for delayed tasks if any.
     void start(void)
     {
+        m_events.wait(dispatchEvent | delayEvent, noClear, 0); // Creates the event group before the delay thread starts.
         m_delayThread.start(this, delayTask, "TaskScheduler::delayTask", ThreadPriority::belowNormal);
-        if (!immediateCount()) m_dispatchSemaphore.wait();
         for (;;)
         {
             if (immediateCount()) processImmediate(application);
-            m_dispatchSemaphore.wait();
+            m_events.wait(dispatchEvent);
         }
     }
 
@@ -54,16 +67,49 @@ public:
         for (auto& task : m_tasks) if (task.cancel(id, &m_immediate, &m_delayed)) return;
     }
 
-    void frameTick(void)
+    /// @brief Wakes up the delay thread, so it recalculates the nearest deadline. ISR safe.
+    inline void wake(void) { m_events.signal(delayEvent); }
+
+    /// @brief Gets the timing statistics of an active task. Thread safe.
+    /// @param id Task identifier.
+    /// @param timing Target reference.
+    /// @returns True if the task was found.
+    inline bool timing(TaskId id, TaskTiming& timing)
     {
-        if (!immediateCount()) return;
-        processImmediate(frame);
+        for (auto& task : m_tasks) if (task.timing(id, timing)) return true;
+        return false;
     }
 
+    /// @brief Processes the tasks scheduled to the `frame` context within the frame time budget.
+    ///        Tasks not started before the budget is used are carried over to the next frame.
+    ///        Call from the GUI thread on each display frame.
+    void frameTick(void);
+
+    /// @returns The frame context time budget in CPU cycles.
+    inline uint32_t frameBudget() const { return m_frameBudget; }
+
+    /// @brief Sets the frame context time budget.
+    /// @param cycles The number of CPU cycles the frame tasks can use in one frame.
+    inline void frameBudget(uint32_t cycles) { m_frameBudget = cycles; }
+
+    /// @returns Frame context processing statistics.
+    inline const FrameStats& frameStats() const { return m_frameStats; }
+
+    /// @param context Thread context, `application` or `frame`.
+    /// @returns The latency and duration histograms of the tasks run in the context.
+    inline const SchedulingStats& schedulingStats(ThreadContext context) const { return m_stats[context == frame]; }
+
+    /// @brief Clears the latency and duration histograms.
+    inline void clearSchedulingStats() { for (auto& stats : m_stats) stats = {}; }
+
+    /// @brief Logs the latency and duration histograms of the `application` and `frame` contexts.
+    void dumpSchedulingStats(void);
+
 friend class AppThread;
 private:
 
-    TaskScheduler() : m_tasks(), m_immediate(0), m_delayed(0), m_delayThread(), m_delaySemaphore(), m_dispatchSemaphore() { }
+    TaskScheduler() : m_tasks(), m_immediate(0), m_delayed(0), m_delayThread(), m_events(),
+        m_frameBudget(), m_frameCursor(0), m_frameStats(), m_lastOverrunReport(0), m_stats() { }
     TaskScheduler(const TaskScheduler&) = delete;
     TaskScheduler(TaskScheduler&&) = delete;
 
@@ -71,17 +117,22 @@ private:
     /// @param context Target thread context.
     inline void processImmediate(ThreadContext context = application)
     {
-        for (auto& task : m_tasks) task.process(context, &m_immediate, &m_delayed);
+        bool any = false;
+        for (auto& task : m_tasks) any |= task.process(context, &m_immediate, &m_delayed, &m_stats[context == frame]);
+        if (any && m_delayed) m_events.signal(delayEvent); // Periodic tasks got new release times.
     }
 
     // Processes all delayed tasks in the pool.
-    // Decreases tick counters.
-    // Makes task immediate when the tick counter is zeroed.
-    inline void processDelayed(void)
+    // Makes tasks immediate when their release time has come.
+    // Returns the number of ticks to the nearest release time or `waitForever`.
+    inline TickCount processDelayed(void)
     {
-        for (auto& task : m_tasks)
-            if (task.delayTick(&m_immediate, &m_delayed))
-                m_dispatchSemaphore.release();
+        const TickCount now = getTick();
+        TickCount timeout = waitForever;
+        bool any = false;
+        for (auto& task : m_tasks) any |= task.tryRelease(now, timeout, &m_immediate, &m_delayed);
+        if (any) m_events.signal(dispatchEvent);
+        return timeout;
     }
 
     /// @returns The immediate scheduled tasks count.
@@ -90,20 +141,26 @@ private:
     /// @returns The delayed scheduled tasks count.
     inline size_t delayedCount() const { return m_delayed; }
 
-    /// @brief A loop that decreases delayed tasks tick counters and notifies the application thread when a task is ready to run.
+    /// @brief A loop that sleeps until the nearest release time or timer expiry,
+    ///        and notifies the application thread when a task is ready to run.
     /// @param arg Scheduler instance as `void*` pointer.
     static inline void delayTask(OS::ThreadArg arg)
     {
         TaskScheduler& instance = *reinterpret_cast<TaskScheduler*>(arg);
         for (;;)
         {
-            if (instance.m_delayed) instance.processDelayed();
-            if (instance.m_delayed) OS::delay(1); else instance.m_delaySemaphore.wait();
+            TickCount timeout = instance.processDelayed();
+            TickCount timerTimeout = TimerService::process(getTick());
+            EventDispatcher::flush();
+            instance.m_events.wait(delayEvent, waitAny, timerTimeout < timeout ? timerTimeout : timeout);
         }
     }
 
 private:
 
+    static constexpr EventFlags dispatchEvent = 1;  // Wakes up the application thread.
+    static constexpr EventFlags delayEvent = 2;     // Wakes up the delay thread.
+
     /// @brief Maximum number of tasks that can be scheduled at the same time.
     static constexpr size_t size = WTK_OS_TASKS;
 
@@ -117,13 +174,30 @@ private:
     size_t m_delayed;
 
     /// @brief Thread responsible for scheduling delayed tasks.
-    Thread m_delayThread;
+    /// @remarks Runs no user code, only the task release, `TimerService::process()` and `EventDispatcher::flush()`.
+    ///          The deepest path, `TimerService::process()`, `AppThread::sync()`, `schedule()`, `EventGroup::signal()`
+    ///          and `tx_event_flags_set()`, takes about 400 bytes, the FPU context saved on preemption up to 200 more,
+    ///          so `WTK_OS_SCHEDULER_STACK` leaves about 40% unused. Check the headroom with `StackMonitor::dump()`
+    ///          after the timers and the ISR events ran, keep it above 256 bytes.
+    ThreadT<WTK_OS_SCHEDULER_STACK> m_delayThread;
+
+    /// @brief Events used to wake up the application thread and the delay thread. Signals are never lost.
+    EventGroup m_events;
+
+    /// @brief Frame context time budget in CPU cycles, zero until the first frame.
+    uint32_t m_frameBudget;
+
+    /// @brief The index of the task the next frame starts with.
+    size_t m_frameCursor;
+
+    /// @brief Frame context processing statistics.
+    FrameStats m_frameStats;
 
-    /// @brief Semaphore used to suspend the delay task.
-    Semaphore m_delaySemaphore;
+    /// @brief The tick count of the last overrun log message.
+    TickCount m_lastOverrunReport;
 
-    /// @brief Semaphore used to supend the main task.
-    Semaphore m_dispatchSemaphore;
+    /// @brief Latency and duration histograms of the `application` [0] and `frame` [1] contexts.
+    SchedulingStats m_stats[2];
 
 };
 
@@ -0,0 +1,285 @@
+/**
+ * @file        Test.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       Tests the RTOS module and the toolkit concurrency primitives. Header only.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @remarks     The tests run 2 or 3 threads at once, so on the host build they run truly parallel on different cores.
+ *
+ * @copyright	(c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "Log.hpp"
+#include "RTOS.hpp"
+#include "Seqlock.hpp"
+#include "SignalingRingBuffer.hpp"
+#include "Thread.hpp"
+#include "Timeout.hpp"
+#include "StaticClass.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace OS
+{
+
+/// @brief RTOS API test.
+class Test final
+{
+
+STATIC(Test)
+
+public:
+
+    /// @brief Tests the single-producer / single-consumer ring buffer with a producer thread and the calling thread
+    ///        as the consumer. The producer writes a counter with `push()`, `pushN()` and `writeSpan()`,
+    ///        the consumer reads it with `pop()`, `popN()` and `readSpan()`, waiting when the buffer is empty.
+    ///        Fails on an element lost, duplicated or out of order, or when the consumer is not woken up in 1 second.
+    /// @param elements The number of elements to pass.
+    /// @returns True if passed, false if failed.
+    static bool ringBuffer(uint32_t elements = 1000000)
+    {
+        Log::msg("Testing OS ring buffer, %lu elements:", static_cast<unsigned long>(elements));
+        m_ring.clear();
+        m_ringElements = elements;
+        ThreadT<WTK_OS_THREAD_STACK> producer;
+        producer.start(ringProducer, "Ring producer", ThreadPriority::normal);
+        uint32_t expected = 0;
+        uint32_t waits = 0;
+        uint32_t batch[ringBatch];
+        for (uint32_t step = 0; expected < elements; ++step)
+        {
+            if (!m_ring.any())
+            {
+                ++waits;
+                if (!m_ring.wait(msToTicks(1000))) return ringFailed("Consumer not woken up!", expected);
+            }
+            size_t count = 0;
+            switch (step % 3)
+            {
+            case 0:
+                count = m_ring.pop(batch[0]) ? 1 : 0;
+                break;
+            case 1:
+                count = m_ring.popN(batch, step % ringBatch + 1);
+                break;
+            default:
+            {
+                auto span = m_ring.readSpan();
+                count = span.length < ringBatch ? span.length : ringBatch;
+                for (size_t i = 0; i < count; ++i) batch[i] = span.data[i];
+                m_ring.commitRead(count);
+                break;
+            }
+            }
+            for (size_t i = 0; i < count; ++i, ++expected)
+                if (batch[i] != expected) return ringFailed("Invalid element!", expected);
+        }
+        if (m_ring.any()) return ringFailed("Unexpected element!", expected);
+        Log::msg("Passed %lu elements, the consumer waited %lu times.",
+            static_cast<unsigned long>(elements), static_cast<unsigned long>(waits));
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the sequence lock with a writer thread and 2 readers, a reader thread and the calling thread.
+    ///        The writer publishes the counter in all words of a 256 byte value, the readers check each value read
+    ///        has all words equal (not torn) and is not older than the previous one.
+    ///        The threads yield rarely, so on a single core they are switched in the middle of a write too.
+    /// @param writes The number of values to publish.
+    /// @returns True if passed, false if failed.
+    static bool seqlock(uint32_t writes = 1000000)
+    {
+        Log::msg("Testing seqlock, %lu writes:", static_cast<unsigned long>(writes));
+        m_seqlock.write(SeqlockValue());
+        m_seqlockWrites = writes;
+        m_seqlockErrors = 0;
+        m_seqlockReads = 0;
+        ThreadT<WTK_OS_THREAD_STACK> writer;
+        ThreadT<WTK_OS_THREAD_STACK> reader;
+        reader.start(seqlockReader, "Seqlock reader", ThreadPriority::normal);
+        writer.start(seqlockWriter, "Seqlock writer", ThreadPriority::normal);
+        seqlockReader(nullptr);
+        for (uint32_t i = 0; m_seqlockReads < 2; ++i)
+        {
+            if (i >= 1000) return seqlockFailed("Reader not finished!");
+            delay(msToTicks(1));
+        }
+        if (m_seqlockErrors) return seqlockFailed("Torn or stale value read!");
+        if (m_seqlock.sequence() != 2 * (writes + 1)) return seqlockFailed("Invalid sequence number!");
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+    /// @brief Tests the timer service with timeouts armed at once, in milliseconds and in seconds, one of them stopped.
+    ///        Fails when a timeout fires before its time, doesn't fire in 1 second after its time or fires when stopped.
+    /// @returns True if passed, false if failed.
+    static bool timers()
+    {
+        Log::msg("Testing OS timers, %lu timeouts:", static_cast<unsigned long>(timerCount));
+        TimerProbe probes[timerCount];
+        const TickCount start = getTick();
+        for (size_t i = 0; i < timerCount; ++i)
+        {
+            if (i & 1) probes[i].timeout.set(timerDelay(i) / 1000.0);
+            else probes[i].timeout.set(Milliseconds(timerDelay(i)));
+        }
+        probes[timerStopped].timeout.clear();
+        const TickCount end = start + msToTicks(timerDelay(timerCount - 1) + 1000); // The last timeout index has the longest delay.
+        for (size_t fired = 0; fired < timerCount - 1 && static_cast<int32_t>(getTick() - end) < 0; )
+        {
+            delay(msToTicks(10));
+            fired = 0;
+            for (const TimerProbe& probe : probes) if (probe.fired) ++fired;
+        }
+        for (size_t i = 0; i < timerCount; ++i)
+        {
+            const TickCount tick = probes[i].fired;
+            if (i == timerStopped) { if (tick) return timerFailed("Stopped timeout fired!", i); }
+            else if (!tick) return timerFailed("Timeout not fired!", i);
+            else if (tick - start < msToTicks(timerDelay(i))) return timerFailed("Timeout fired early!", i);
+        }
+        Log::msg("SUCCESS!");
+        return true;
+    }
+
+private:
+
+    /// @brief Sequence lock test value, large, so a write is often interrupted when the writer is preempted.
+    struct SeqlockValue final
+    {
+        uint32_t words[64]; // All words set to the same counter value.
+    };
+
+    static constexpr uint32_t seqlockYield = 4095; // The sequence lock test threads yield every this + 1 iterations.
+    static constexpr size_t timerCount = 24; // The number of timeouts tested, more than the wheel slots passed by the longest.
+    static constexpr size_t timerStopped = 7; // The index of the timeout stopped right after arming.
+    static constexpr size_t ringSize = 256; // Ring buffer test capacity.
+    static constexpr size_t ringBatch = 13; // The maximal number of elements per ring buffer test operation, not a divisor of the size.
+
+    /// @brief Writes the counter to the ring buffer with all write methods, yields when the buffer is full.
+    static void ringProducer(ThreadArg)
+    {
+        const uint32_t elements = m_ringElements;
+        uint32_t batch[ringBatch];
+        uint32_t next = 0;
+        for (uint32_t step = 0; next < elements; ++step)
+        {
+            const size_t wanted = std::min<size_t>(step % ringBatch + 1, elements - next);
+            size_t count = 0;
+            switch (step % 3)
+            {
+            case 0:
+                count = m_ring.push(next) ? 1 : 0;
+                break;
+            case 1:
+                for (size_t i = 0; i < wanted; ++i) batch[i] = next + i;
+                count = m_ring.pushN(batch, wanted);
+                break;
+            default:
+            {
+                auto span = m_ring.writeSpan();
+                count = span.length < wanted ? span.length : wanted;
+                for (size_t i = 0; i < count; ++i) span.data[i] = next + i;
+                m_ring.commitWrite(count);
+                break;
+            }
+            }
+            if (!count) yield();
+            next += count;
+        }
+    }
+
+    /// @brief Logs the ring buffer test failure.
+    /// @param message Message to log.
+    /// @param expected The expected element value.
+    /// @returns False.
+    static bool ringFailed(const char* message, uint32_t expected)
+    {
+        Log::msg(LogMessage::error, "%s Expected element %lu.", message, static_cast<unsigned long>(expected));
+        return false;
+    }
+
+    /// @brief A timeout storing the tick it fired at.
+    struct TimerProbe final
+    {
+        TimerProbe() : timeout(Milliseconds(0), this, fire), fired(0) { }
+
+        /// @brief Stores the current tick, never 0.
+        /// @param arg The probe pointer.
+        static void fire(void* arg)
+        {
+            const TickCount now = getTick();
+            static_cast<TimerProbe*>(arg)->fired = now ? now : 1;
+        }
+
+        Timeout timeout;                // Timeout under test.
+        std::atomic<TickCount> fired;   // The tick the timeout fired at, 0 if not fired.
+    };
+
+    /// @param index Timeout index.
+    /// @returns The timeout delay in milliseconds, not in the index order except the last, the longest. Some in the later wheel turns.
+    static constexpr uint32_t timerDelay(size_t index) { return static_cast<uint32_t>(10 + (index * 13 + 12) % timerCount * 9); }
+
+    /// @brief Logs the timer test failure.
+    /// @param message Message to log.
+    /// @param index Timeout index.
+    /// @returns False.
+    static bool timerFailed(const char* message, size_t index)
+    {
+        Log::msg(LogMessage::error, "%s Timeout %lu, %lu ms.", message,
+            static_cast<unsigned long>(index), static_cast<unsigned long>(timerDelay(index)));
+        return false;
+    }
+
+    /// @brief Publishes the counter values, yields now and then, so the readers run on a target without time slicing.
+    static void seqlockWriter(ThreadArg)
+    {
+        const uint32_t writes = m_seqlockWrites;
+        SeqlockValue value;
+        for (uint32_t counter = 1; counter <= writes; ++counter)
+        {
+            for (uint32_t& word : value.words) word = counter;
+            m_seqlock.write(value);
+            if (!(counter & seqlockYield)) yield();
+        }
+    }
+
+    /// @brief Reads the values until the last one is read, counts the torn and stale values.
+    static void seqlockReader(ThreadArg)
+    {
+        const uint32_t writes = m_seqlockWrites;
+        uint32_t previous = 0;
+        uint32_t reads = 0;
+        while (previous < writes)
+        {
+            const SeqlockValue value = m_seqlock.read();
+            for (uint32_t word : value.words) if (word != value.words[0]) ++m_seqlockErrors;
+            if (value.words[0] < previous) ++m_seqlockErrors;
+            previous = value.words[0];
+            if (!(++reads & seqlockYield)) yield();
+        }
+        ++m_seqlockReads;
+    }
+
+    /// @brief Logs the sequence lock test failure.
+    /// @param message Message to log.
+    /// @returns False.
+    static bool seqlockFailed(const char* message)
+    {
+        Log::msg(LogMessage::error, message);
+        return false;
+    }
+
+    static inline SignalingRingBuffer<ringSize, uint32_t> m_ring = {};  // Ring buffer under test.
+    static inline std::atomic<uint32_t> m_ringElements = {};            // The number of elements the producer writes.
+    static inline Seqlock<SeqlockValue> m_seqlock = {};                 // Sequence lock under test.
+    static inline std::atomic<uint32_t> m_seqlockWrites = {};           // The number of values the writer publishes.
+    static inline std::atomic<uint32_t> m_seqlockErrors = {};           // The number of torn or stale values read.
+    static inline std::atomic<uint32_t> m_seqlockReads = {};            // The number of readers finished.
+
+};
+
+}
@@ -18,9 +18,13 @@
 // Azure RTOS implementation
 //
 
-OS::Thread::Thread() : ThreadBase(), m_controlBlock() { }
+OS::ThreadStorage::ThreadStorage(uint32_t* stack, size_t stackSize)
+    : ThreadBase(), m_controlBlock(), m_stack(stack)
+{
+    m_stackSize = stackSize;
+}
 
-OS::Thread::~Thread()
+OS::ThreadStorage::~ThreadStorage()
 {
     if (m_handle)
     {
@@ -29,16 +33,17 @@ OS::Thread::~Thread()
     }
 }
 
-void OS::Thread::start(void *arg, ThreadEntry entry, const char *name, Priority priority)
+void OS::ThreadStorage::start(void *arg, ThreadEntry entry, const char *name, Priority priority)
 {
     if (m_handle) Crash::here(); // The thread is already started!
+    fillStack(m_stack, m_stackSize);
     auto result = tx_thread_create(
         &m_controlBlock,
         (char*)name,
         entry,
         reinterpret_cast<UINT>(arg),
         m_stack,
-        sizeof(m_stack),
+        m_stackSize,
         priority,
         priority + 1, // Preemtion threshold.
         0, // Do not use time slices.
@@ -54,18 +59,59 @@ void OS::Thread::start(void *arg, ThreadEntry entry, const char *name, Priority
 // FreeRTOS implementation
 //
 
-OS::Thread::Thread() : ThreadBase(), m_buffer() { }
+OS::ThreadStorage::ThreadStorage(uint32_t* stack, size_t stackSize)
+    : ThreadBase(), m_buffer(), m_stack(stack)
+{
+    m_stackSize = stackSize;
+}
 
-OS::Thread::~Thread()
+OS::ThreadStorage::~ThreadStorage()
 {
     if (m_handle) terminate();
 }
 
-void OS::Thread::start(void *arg, ThreadEntry entry, const char *name, Priority priority)
+void OS::ThreadStorage::start(void *arg, ThreadEntry entry, const char *name, Priority priority)
 {
     if (m_handle) Crash::here(); // The thread is already started!
-    m_handle = xTaskCreateStatic(entry, name, sizeof(m_stack) >> 2, arg, priority, m_stack, &m_buffer);
+    fillStack(m_stack, m_stackSize);
+    m_handle = xTaskCreateStatic(entry, name, m_stackSize >> 2, arg, priority, m_stack, &m_buffer);
     if (!m_handle) Crash::here(); // Thread creation failed!
 }
 
+#elif defined(USE_POSIX)
+
+///
+// Host implementation, the threads use the system allocated stacks, the stack memory is not used.
+//
+
+OS::ThreadStorage::ThreadStorage(uint32_t* stack, size_t stackSize)
+    : ThreadBase(), m_controlBlock(), m_stack(stack)
+{
+    (void)stackSize; // The stack usage can't be measured on a host.
+}
+
+OS::ThreadStorage::~ThreadStorage()
+{
+    if (m_handle) terminate();
+}
+
+void OS::ThreadStorage::start(void *arg, ThreadEntry entry, const char *name, Priority priority)
+{
+    if (m_handle) Crash::here(); // The thread is already started!
+    m_controlBlock.entry = entry;
+    m_controlBlock.arg = arg;
+    m_controlBlock.name = name;
+    m_controlBlock.priority = priority;
+    m_handle = &m_controlBlock;
+    if (pthread_create(&m_controlBlock.thread, nullptr, hostEntry, &m_controlBlock)) Crash::here(); // Thread creation failed!
+}
+
+void* OS::ThreadStorage::hostEntry(void* controlBlock)
+{
+    HostThread* thread = static_cast<HostThread*>(controlBlock);
+    CurrentThread::m_handle = thread;
+    thread->entry(thread->arg);
+    return nullptr;
+}
+
 #endif
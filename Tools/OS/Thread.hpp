@@ -10,24 +10,19 @@
 
 #pragma once
 
+#include <cstddef>
 #include "RTOS.hpp"
 #include "ThreadBase.hpp"
 
 namespace OS
 {
 
-/// @brief Represents a RTOS thread, including the control block and the stack memory.
-class Thread final : public ThreadBase
+/// @brief Represents a RTOS thread, including the control block, using the stack memory provided by the derived class.
+class ThreadStorage : public ThreadBase
 {
 
 public:
 
-    /// @brief Creates an empty thread container for the thread to be started later.
-    Thread();
-
-    /// @brief Terminates the RTOS thread on going out of scope.
-    ~Thread();
-
     /// @brief Starts the thread with the given entry point.
     ///        Do not call from ISR, or when the thread is already started.
     ///        It can be called again after `terminate` method is called.
@@ -48,15 +43,54 @@ public:
     /// @param priority Thread priority, default `Priority::normal`.
     void start(void *arg, ThreadEntry entry, const char *name = nullptr, Priority priority = Priority::normal);
 
+protected:
+
+    /// @brief Creates an empty thread container for the thread to be started later.
+    /// @param stack Stack memory aligned to the MCU word boundary.
+    /// @param stackSize Stack size in bytes.
+    ThreadStorage(uint32_t* stack, size_t stackSize);
+
+    /// @brief Terminates the RTOS thread on going out of scope.
+    ~ThreadStorage();
+
 private:
 
 #if defined(USE_AZURE_RTOS)
     TX_THREAD m_controlBlock;   // Contains the thread control block.
 #elif defined(USE_FREE_RTOS)
     StaticTask_t m_buffer;      // A statically allocated buffer for the data.
+#elif defined(USE_POSIX)
+    HostThread m_controlBlock;  // Contains the host thread control block.
+
+    /// @brief Calls the thread entry function in the host thread.
+    /// @param controlBlock Host thread control block pointer.
+    /// @returns `nullptr`.
+    static void* hostEntry(void* controlBlock);
 #endif
-    uint32_t m_stack[WTK_OS_THREAD_STACK >> 2]; // Thread stack memory aligned to the MCU word boundary.
+    uint32_t* m_stack;          // Thread stack memory.
 
 };
 
+/// @brief Represents a RTOS thread, including the control block and the stack memory.
+/// @tparam TStackSize Stack size in bytes. Must be a multiple of 8.
+template<size_t TStackSize>
+class ThreadT final : public ThreadStorage
+{
+
+    static_assert(TStackSize % 8 == 0, "Thread stack size must be a multiple of 8.");
+
+public:
+
+    /// @brief Creates an empty thread container for the thread to be started later.
+    ThreadT() : ThreadStorage(m_stackMemory, TStackSize) { }
+
+private:
+
+    alignas(8) uint32_t m_stackMemory[TStackSize >> 2]; // Thread stack memory aligned to the double word boundary.
+
+};
+
+/// @brief Represents a RTOS thread with the default stack size of `WTK_OS_THREAD_STACK` bytes.
+using Thread = ThreadT<WTK_OS_THREAD_STACK>;
+
 }
@@ -28,6 +28,26 @@ void OS::ThreadBase::terminate(void)
     m_handle = nullptr;
 }
 
+size_t OS::ThreadBase::stackSize() const
+{
+    return m_handle ? m_handle->tx_thread_stack_size : 0;
+}
+
+size_t OS::ThreadBase::stackHighWaterMark() const
+{
+    return m_handle ? m_handle->tx_thread_stack_size - stackHeadroom() : 0;
+}
+
+size_t OS::ThreadBase::stackHeadroom() const
+{
+    if (!m_handle) return 0;
+    const uint32_t* start = static_cast<const uint32_t*>(m_handle->tx_thread_stack_start);
+    const uint32_t* end = start + (m_handle->tx_thread_stack_size >> 2);
+    const uint32_t* p = start;
+    while (p < end && *p == stackFill) ++p; // The stack grows down, so the untouched area is at the start.
+    return (p - start) << 2;
+}
+
 #elif defined(USE_FREE_RTOS)
 
 OS::ThreadPriority OS::ThreadBase::changePriority(Priority newPriority)
@@ -44,4 +64,62 @@ void OS::ThreadBase::terminate(void)
     m_handle = nullptr;
 }
 
+size_t OS::ThreadBase::stackSize() const
+{
+    return m_handle ? m_stackSize : 0;
+}
+
+size_t OS::ThreadBase::stackHighWaterMark() const
+{
+    return m_handle && m_stackSize ? m_stackSize - stackHeadroom() : 0;
+}
+
+size_t OS::ThreadBase::stackHeadroom() const
+{
+    return m_handle ? uxTaskGetStackHighWaterMark(m_handle) * sizeof(StackType_t) : 0;
+}
+
+#elif defined(USE_POSIX)
+
+OS::ThreadPriority OS::ThreadBase::changePriority(Priority newPriority)
+{
+    if (!m_handle) Crash::here();
+    Priority old(m_handle->priority);
+    m_handle->priority = newPriority;
+    return old;
+}
+
+void OS::ThreadBase::terminate(void)
+{
+    if (!m_handle) Crash::here();
+    if (pthread_equal(m_handle->thread, pthread_self())) pthread_exit(nullptr);
+    pthread_cancel(m_handle->thread);
+    pthread_join(m_handle->thread, nullptr);
+    m_handle = nullptr;
+}
+
+size_t OS::ThreadBase::stackSize() const
+{
+    return 0; // The host threads run on the system allocated stacks.
+}
+
+size_t OS::ThreadBase::stackHighWaterMark() const
+{
+    return 0;
+}
+
+size_t OS::ThreadBase::stackHeadroom() const
+{
+    return 0;
+}
+
+#endif
+
+#if defined(USE_AZURE_RTOS) or defined(USE_FREE_RTOS)
+
+void OS::ThreadBase::fillStack(uint32_t* stack, size_t size)
+{
+    for (uint32_t* end = stack + (size >> 2); stack < end; ++stack) *stack = stackFill;
+}
+
 #endif
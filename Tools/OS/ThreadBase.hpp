@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "IThread.hpp"
 
 namespace OS
@@ -23,11 +24,11 @@ class ThreadBase : public IThread
 public:
 
     /// @brief Creates an empty / inactive thread base.
-    ThreadBase() : m_handle() { }
+    ThreadBase() : m_handle(), m_stackSize() { }
 
     /// @brief Creates an active thread base for a RTOS thread handle.
     /// @param handle RTOS thread handle.
-    ThreadBase(ThreadHandle handle) : m_handle(handle) { }
+    ThreadBase(ThreadHandle handle) : m_handle(handle), m_stackSize() { }
 
     /// @returns A value indicating that the thread is active / started.
     inline bool active() const override { return m_handle != nullptr; };
@@ -43,8 +44,25 @@ public:
     /// @brief Terminates the RTOS thread. Do not terminate inactive threads. DO NOT CALL FROM ISR!
     void terminate(void) override;
 
+    /// @returns The thread stack size in bytes, zero if the thread is inactive or the size is unknown.
+    size_t stackSize() const;
+
+    /// @returns The maximal number of stack bytes used since the thread was started (the high-water mark).
+    ///          Zero if the thread is inactive or the stack size is unknown.
+    size_t stackHighWaterMark() const;
+
+    /// @returns The number of stack bytes that were never used since the thread was started.
+    size_t stackHeadroom() const;
+
 protected:
-    ThreadHandle m_handle;
+
+    /// @brief Fills the stack memory with the `stackFill` pattern, so the high-water mark can be measured.
+    /// @param stack Stack memory.
+    /// @param size Stack size in bytes.
+    static void fillStack(uint32_t* stack, size_t size);
+
+    ThreadHandle m_handle;  // RTOS thread handle.
+    size_t m_stackSize;     // Stack size in bytes if known by the toolkit, zero otherwise.
 };
 
 }
@@ -35,9 +35,9 @@ struct ThreadPriority final
         realtime      = 0
     };
 
-#elif defined(USE_FREE_RTOS)
+#elif defined(USE_FREE_RTOS) or defined(USE_POSIX)
 
-    /// @brief FreeRTOS priority presets, where the lowest (idle) priority is 1.
+    /// @brief FreeRTOS and host priority presets, where the lowest (idle) priority is 1.
     enum Preset : NativePriority
     {
         none          =  0,         // No priority (not initialized).
@@ -183,7 +183,7 @@ struct ThreadPriority final
         return *this;
     }
 
-#elif defined(USE_FREE_RTOS)
+#elif defined(USE_FREE_RTOS) or defined(USE_POSIX)
 
     /// @brief Tests if this priority is lower (closer to idle) than the other priority.
     /// @param other The other priority level to compare with.
@@ -2,54 +2,66 @@
  * @file        Timeout.cpp
  * @author      Adam Łyskawa
  *
- * @brief       A scheduled task wrapper to be used for resettable and cancellable timeouts. Implementation.
+ * @brief       A timer wrapper to be used for resettable and cancellable timeouts. Implementation.
  * @remark      A part of the Woof Toolkit (WTK), RTOS API.
  *
  * @copyright	(c)2024 CodeDog, All rights reserved.
  */
 
-#include "AppThread.hpp"
 #include "Timeout.hpp"
+#include <cmath>
 
 OS::Timeout::Timeout(double seconds, Action action)
-    : m_taskId(0), m_ticks(WTK_OS_TICKS_PER_SECOND * seconds), m_action(action), m_binding() { }
+    : m_node(secondsToTicks(seconds), action) { }
 
 OS::Timeout::Timeout(double seconds, void *arg, BindingAction action)
-    : m_taskId(0), m_ticks(WTK_OS_TICKS_PER_SECOND * seconds), m_action(action), m_binding(arg) { }
+    : m_node(secondsToTicks(seconds), action, arg) { }
+
+OS::Timeout::Timeout(Milliseconds time, Action action)
+    : m_node(time.ticks(), action) { }
+
+OS::Timeout::Timeout(Milliseconds time, void *arg, BindingAction action)
+    : m_node(time.ticks(), action, arg) { }
 
 OS::Timeout::~Timeout()
 {
-    if (!m_taskId) return;
-    AppThread::cancel(m_taskId);
-    m_ticks = 0;
-    m_action = nullptr;
-    m_binding = nullptr;
+    TimerService::stop(m_node);
 }
 
 void OS::Timeout::set()
 {
-    if (m_taskId || !m_ticks) return;
-    m_taskId = m_binding
-        ? AppThread::delay(m_ticks, m_binding, m_action.binding)
-        : AppThread::delay(m_ticks, m_action.plain);
+    if (active() || !m_node.ticks) return;
+    TimerService::start(m_node);
 }
 
 void OS::Timeout::set(double seconds)
 {
-    if (seconds <= 0 || m_taskId || !m_ticks) return;
-    m_ticks = WTK_OS_TICKS_PER_SECOND * seconds;
-    m_taskId = m_binding
-        ? AppThread::delay(m_ticks, m_binding, m_action.binding)
-        : AppThread::delay(m_ticks, m_action.plain);
+    const TickCount ticks = secondsToTicks(seconds);
+    if (!ticks || active()) return;
+    m_node.ticks = ticks;
+    TimerService::start(m_node);
+}
+
+void OS::Timeout::set(Milliseconds time)
+{
+    if (!time.value || active()) return;
+    m_node.ticks = time.ticks();
+    TimerService::start(m_node);
 }
 
 void OS::Timeout::reset()
 {
-    clear();
-    set();
+    if (!m_node.ticks) return;
+    TimerService::start(m_node);
 }
 
 void OS::Timeout::clear()
 {
-    AppThread::cancel(m_taskId);
+    TimerService::stop(m_node);
+}
+
+OS::TickCount OS::Timeout::secondsToTicks(double seconds)
+{
+    if (!(seconds > 0)) return 0;
+    return static_cast<TickCount>(std::ceil(seconds * WTK_OS_TICKS_PER_SECOND));
 }
@@ -2,7 +2,7 @@
  * @file        Timeout.hpp
  * @author      Adam Łyskawa
  *
- * @brief       A scheduled task wrapper to be used for resettable and cancellable timeouts. Header file.
+ * @brief       A timer wrapper to be used for resettable and cancellable timeouts. Header file.
  * @remark      A part of the Woof Toolkit (WTK), RTOS API.
  *
  * @copyright	(c)2024 CodeDog, All rights reserved.
@@ -12,11 +12,14 @@
 
 #include "RTOS.hpp"
 #include "Action.hpp"
+#include "TimerService.hpp"
 
 namespace OS
 {
 
-/// @brief A scheduled task wrapper to be used for resettable and cancellable timeouts.
+/// @brief A timer wrapper to be used for resettable and cancellable timeouts.
+/// @remarks The timer node is embedded, so any number of timeouts can be armed at the same time.
+///          The action is called in the application thread context.
 class Timeout
 {
 
@@ -33,33 +36,56 @@ public:
     /// @param action An action to be called when the time elapses.
     Timeout(double seconds, void* arg, BindingAction action);
 
+    /// @brief Defines a timeout. Doesn't start the timer.
+    /// @param time A time amount in milliseconds before the action is called.
+    /// @param action An action to be called when the time elapses.
+    Timeout(Milliseconds time, Action action);
+
+    /// @brief Defines a timeout. Doesn't start the timer.
+    /// @param time A time amount in milliseconds before the action is called.
+    /// @param arg A pointer that will be passed as the action argument.
+    /// @param action An action to be called when the time elapses.
+    Timeout(Milliseconds time, void* arg, BindingAction action);
+
     /// @brief This type cannot be copied.
     Timeout(const Timeout&) = delete;
 
     /// @brief This type cannot be moved.
     Timeout(Timeout&&) = delete;
 
-    /// @brief Releases the scheduled task instance and resets the data.
+    /// @brief Stops the timer.
     ~Timeout();
 
-    /// @brief Sets the timeout. The action assigned in the constructor will be called after specified number of secods.
+    /// @brief Sets the timeout. The action assigned in the constructor will be called after specified time.
+    ///        Does nothing if the timeout is already set. ISR safe.
     void set();
 
-    /// @brief Sets the timeout. The action assigned in the constructor will be called after specified number of secods.
+    /// @brief Sets the timeout. The action assigned in the constructor will be called after specified time.
+    ///        Does nothing if the timeout is already set. ISR safe.
     /// @param seconds New time interval value in seconds. Accepts fractional values.
     void set(double seconds);
 
-    /// @brief Resets the time interval value, so the full interval time must be elapsed again since now.
+    /// @brief Sets the timeout. The action assigned in the constructor will be called after specified time.
+    ///        Does nothing if the timeout is already set. ISR safe.
+    /// @param time New time interval value in milliseconds.
+    void set(Milliseconds time);
+
+    /// @brief Resets the time interval value, so the full interval time must be elapsed again since now. ISR safe.
     void reset();
 
-    /// @brief Clears the timeout, so the action will not be called again until `set` or `reset` method is called.
+    /// @brief Clears the timeout, so the action will not be called again until `set` or `reset` method is called. ISR safe.
     void clear();
 
+    /// @returns True if the timeout is set and the action was not called yet.
+    inline bool active() const { return m_node.state != TimerNode::idle; }
+
 protected:
-    TaskId m_taskId;                // Timeout task identifier.
-    TickCount m_ticks;              // A time interval in RTOS ticks to call the associated action.
-    OptionalBindingAction m_action; // An action to call after the timeout elapses.
-    void* m_binding;                // An optional pointer passed to the action.
+
+    /// @param seconds Time in seconds.
+    /// @returns The number of RTOS ticks, rounded up, 0 for the negative values.
+    static TickCount secondsToTicks(double seconds);
+
+    TimerNode m_node; // Timer node containing the interval and the action.
 
 };
 
@@ -0,0 +1,142 @@
+/**
+ * @file        TimerService.cpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A hashed timing wheel for one-shot timers with intrusive nodes. Implementation.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#include "TimerService.hpp"
+#include "AppThread.hpp"
+#include "CriticalSection.hpp"
+
+void OS::TimerService::start(TimerNode& node)
+{
+    bool wake = false;
+    {
+        CriticalSection cs;
+        init();
+        if (node.state != TimerNode::idle) remove(node);
+        if (node.state == TimerNode::armed) --m_armedCount;
+        node.expiry = getTick() + (node.ticks ? node.ticks : 1);
+        node.state = TimerNode::armed;
+        TimerLink& head = m_wheel[node.expiry & mask];
+        TickCount& earliest = m_slotExpiry[node.expiry & mask];
+        if (head.next == &head || static_cast<int32_t>(node.expiry - earliest) < 0) earliest = node.expiry;
+        insert(head, node);
+        ++m_armedCount;
+        if (!m_hasNext || static_cast<int32_t>(node.expiry - m_nextExpiry) < 0)
+        {
+            m_nextExpiry = node.expiry;
+            m_hasNext = true;
+            wake = true;
+        }
+    }
+    if (wake) AppThread::wake(); // The delay thread must shorten its sleep.
+}
+
+void OS::TimerService::stop(TimerNode& node)
+{
+    CriticalSection cs;
+    if (node.state == TimerNode::idle) return;
+    if (node.state == TimerNode::armed) --m_armedCount;
+    remove(node);
+    node.state = TimerNode::idle;
+}
+
+OS::TickCount OS::TimerService::process(TickCount now)
+{
+    if (!m_isInitialized) return waitForever;
+    bool anyExpired = false;
+    TickCount steps = now - m_lastTick;
+    if (steps > wheelSize) steps = wheelSize;
+    for (TickCount i = 1; i <= steps; ++i)
+    {
+        CriticalSection cs; // One slot at a time to keep the interrupt latency low.
+        const TickCount slot = (m_lastTick + i) & mask;
+        TimerLink& head = m_wheel[slot];
+        bool isPending = false; // True if a timer stays in the slot, `m_slotExpiry` is recalculated for the pending timers.
+        for (TimerLink* link = head.next; link != &head;)
+        {
+            TimerNode& node = *static_cast<TimerNode*>(link);
+            link = link->next;
+            if (static_cast<int32_t>(node.expiry - now) > 0) // Due in one of the next wheel turns.
+            {
+                if (!isPending || static_cast<int32_t>(node.expiry - m_slotExpiry[slot]) < 0) m_slotExpiry[slot] = node.expiry;
+                isPending = true;
+                continue;
+            }
+            remove(node);
+            insert(m_expired, node);
+            node.state = TimerNode::expired;
+            --m_armedCount;
+            anyExpired = true;
+        }
+    }
+    m_lastTick = now;
+    TickCount timeout = waitForever;
+    for (TickCount i = 1; i <= wheelSize; ++i) // The slots in the expiry order, a timer in slot `i` is due in `i` ticks or more.
+    {
+        CriticalSection cs;
+        const TickCount slot = (now + i) & mask;
+        if (m_wheel[slot].next == &m_wheel[slot]) continue;
+        const int32_t remaining = static_cast<int32_t>(m_slotExpiry[slot] - now);
+        const TickCount ticks = remaining > 0 ? remaining : 1;
+        if (ticks < timeout) timeout = ticks;
+        if (ticks <= i) break; // Due in this wheel turn, the next slots are due later.
+    }
+    {
+        CriticalSection cs;
+        m_hasNext = timeout != waitForever;
+        m_nextExpiry = now + timeout;
+    }
+    if (anyExpired && !m_isDispatchPending.exchange(true)) AppThread::sync(dispatch);
+    return timeout;
+}
+
+void OS::TimerService::init(void)
+{
+    if (m_isInitialized) return;
+    for (auto& head : m_wheel) head.prev = head.next = &head;
+    m_expired.prev = m_expired.next = &m_expired;
+    m_lastTick = getTick();
+    m_isInitialized = true;
+}
+
+void OS::TimerService::insert(TimerLink& head, TimerLink& link)
+{
+    link.prev = head.prev;
+    link.next = &head;
+    head.prev->next = &link;
+    head.prev = &link;
+}
+
+void OS::TimerService::remove(TimerLink& link)
+{
+    link.prev->next = link.next;
+    link.next->prev = link.prev;
+    link.prev = link.next = nullptr;
+}
+
+void OS::TimerService::dispatch(void)
+{
+    m_isDispatchPending = false;
+    for (;;)
+    {
+        OptionalBindingAction action;
+        void* binding;
+        {
+            CriticalSection cs;
+            if (m_expired.next == &m_expired) return;
+            TimerNode& node = *static_cast<TimerNode*>(m_expired.next);
+            remove(node);
+            node.state = TimerNode::idle;
+            action = node.action;
+            binding = node.binding;
+        }
+        if (binding) action.binding(binding);
+        else if (action.plain) action.plain();
+    }
+}
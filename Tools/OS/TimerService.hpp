@@ -0,0 +1,114 @@
+/**
+ * @file        TimerService.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A hashed timing wheel for one-shot timers with intrusive nodes. Header file.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "Action.hpp"
+#include "RTOS.hpp"
+#include "StaticClass.hpp"
+
+namespace OS
+{
+
+/// @brief Doubly linked list link used by the timer wheel.
+struct TimerLink
+{
+    TimerLink* prev;    // Previous link in a circular list.
+    TimerLink* next;    // Next link in a circular list.
+};
+
+/// @brief A timer node embedded in the timer owner, so arming a timer never allocates.
+struct TimerNode : TimerLink
+{
+
+    /// @brief Timer node state.
+    enum State : uint8_t
+    {
+        idle,       // Not armed.
+        armed,      // Waiting in the wheel.
+        expired     // Waiting for the action to be called.
+    };
+
+    TickCount expiry;               // Absolute RTOS tick the timer expires at.
+    TickCount ticks;                // Timer interval in RTOS ticks.
+    OptionalBindingAction action;   // An action to call when the timer expires.
+    void* binding;                  // An optional pointer passed to the action.
+    volatile State state;           // Timer node state.
+
+    /// @brief Creates an idle timer node.
+    /// @param ticks Timer interval in RTOS ticks.
+    /// @param action An action to call when the timer expires.
+    /// @param binding An optional pointer passed to the action.
+    TimerNode(TickCount ticks, OptionalBindingAction action, void* binding = nullptr)
+        : TimerLink{ nullptr, nullptr }, expiry(0), ticks(ticks), action(action), binding(binding), state(idle) { }
+
+};
+
+/// @brief A hashed timing wheel for one-shot timers.
+/// @remarks Start, stop and restart are O(1) and ISR safe.
+///          Expired timers are collected by the `TaskScheduler` delay thread,
+///          then their actions are called in a single batch in the application thread context.
+///          Each slot keeps its earliest expiry, so finding the nearest expiry doesn't walk the timer lists,
+///          only the slots passed since the last call are walked.
+class TimerService final
+{
+    STATIC(TimerService)
+
+public:
+
+    static constexpr size_t wheelSize = WTK_OS_TIMER_WHEEL; ///< The number of wheel slots.
+
+    /// @brief Arms the timer for `node.ticks` from now. Restarts the timer if already armed.
+    /// @param node Timer node reference.
+    static void start(TimerNode& node);
+
+    /// @brief Disarms the timer. Does nothing if the timer is not armed.
+    /// @param node Timer node reference.
+    static void stop(TimerNode& node);
+
+    /// @returns The number of armed timers.
+    static inline size_t armedCount() { return m_armedCount; }
+
+    /// @brief Moves the expired timers to the expired list and schedules their actions. Called by the `TaskScheduler` delay thread.
+    /// @param now Current RTOS tick count.
+    /// @returns The number of ticks to the nearest expiry or `waitForever`.
+    static TickCount process(TickCount now);
+
+private:
+
+    static_assert((wheelSize & (wheelSize - 1)) == 0, "Timer wheel size must be a power of 2.");
+    static constexpr TickCount mask = wheelSize - 1;
+
+    /// @brief Initializes the list heads if not initialized. Call in a critical section.
+    static void init(void);
+
+    /// @brief Inserts the link before the head (at the list end). Call in a critical section.
+    static void insert(TimerLink& head, TimerLink& link);
+
+    /// @brief Removes the link from its list. Call in a critical section.
+    static void remove(TimerLink& link);
+
+    /// @brief Calls the actions of all expired timers. Runs in the application thread context.
+    static void dispatch(void);
+
+    static inline TimerLink m_wheel[wheelSize] = {};          // Wheel slot list heads.
+    static inline TickCount m_slotExpiry[wheelSize] = {};     // The earliest expiry in each non-empty slot, may be earlier if a timer was stopped.
+    static inline TimerLink m_expired = {};                   // Expired timers list head.
+    static inline size_t m_armedCount = {};                   // The number of armed timers.
+    static inline TickCount m_lastTick = {};                  // The last tick processed.
+    static inline TickCount m_nextExpiry = {};                // The nearest expiry known to the delay thread.
+    static inline bool m_hasNext = {};                        // True if `m_nextExpiry` is valid.
+    static inline std::atomic<bool> m_isDispatchPending = {}; // True if the dispatch task is scheduled.
+    static inline bool m_isInitialized = {};                  // True if the list heads are initialized.
+
+};
+
+}
@@ -0,0 +1,192 @@
+/**
+ * @file        RingBuffer.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A lock-free single-producer / single-consumer ring buffer. Header only.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @remarks     One context (ISR or thread) pushes, one other context pops. No locks, no blocking.
+ *              Indexes are free-running counters published with release semantics and read with
+ *              acquire semantics, so the elements are always visible before the index that covers them.
+ *              The buffer has no RTOS or HAL dependencies, so it can be compiled and tested on the host.
+ *              For a consumer that blocks until the data arrives see `OS::SignalingRingBuffer`.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief A lock-free single-producer / single-consumer ring buffer.
+ *
+ * @tparam TSize Capacity. Must be a power of 2.
+ * @tparam TElement Element type. Must be trivially copyable.
+ */
+template<size_t TSize, typename TElement>
+class RingBuffer
+{
+
+    static_assert(TSize > 1 && (TSize & (TSize - 1)) == 0, "Ring buffer capacity must be a power of 2.");
+    static_assert(std::is_trivially_copyable<TElement>::value, "Ring buffer elements must be trivially copyable.");
+
+public: // Type aliases:
+
+    using ValueType = TElement;
+
+    /// @brief A contiguous region of the buffer memory.
+    struct Span
+    {
+        TElement* data; ///< The first element of the region.
+        size_t length;  ///< The number of elements in the region.
+    };
+
+public: // Static:
+
+    static constexpr size_t capacity = TSize;   ///< Fixed buffer capacity.
+    static constexpr size_t cacheLine = 32;     ///< Index alignment preventing false sharing.
+
+public: // Common API:
+
+    /// @brief Creates a new empty ring buffer.
+    RingBuffer() : m_head(0), m_tail(0), m_elements() { }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// @returns The number of elements available for reading. Exact only when called from the consumer.
+    inline size_t length() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    /// @returns The number of free elements available for writing. Exact only when called from the producer.
+    inline size_t available() const { return capacity - length(); }
+
+    /// @returns True if there are any elements to read.
+    inline bool any() const { return length() > 0; }
+
+    /// @returns True if no more elements can be written.
+    inline bool full() const { return length() >= capacity; }
+
+public: // Producer API:
+
+    /// @brief Writes one element.
+    /// @param element Element reference.
+    /// @returns True if written, false if the buffer is full.
+    bool push(const TElement& element)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= capacity) return false;
+        m_elements[head & mask] = element;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Writes as many elements as it fits, using at most 2 block copies.
+    /// @param elements Source elements.
+    /// @param count The number of elements to write.
+    /// @returns The number of elements actually written.
+    size_t pushN(const TElement* elements, size_t count)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t space = capacity - (head - m_tail.load(std::memory_order_acquire));
+        if (count > space) count = space;
+        if (!count) return 0;
+        const size_t offset = head & mask;
+        const size_t first = count < capacity - offset ? count : capacity - offset;
+        std::memcpy(&m_elements[offset], elements, first * sizeof(TElement));
+        if (count > first) std::memcpy(&m_elements[0], elements + first, (count - first) * sizeof(TElement));
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /// @brief Gets the largest contiguous free region that can be written directly (by DMA or `memcpy`).
+    /// @remarks The region is not visible to the consumer until `commitWrite()` is called.
+    /// @returns A span of free elements. The length is zero if the buffer is full.
+    Span writeSpan()
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t space = capacity - (head - m_tail.load(std::memory_order_acquire));
+        const size_t offset = head & mask;
+        const size_t toEnd = capacity - offset;
+        return { &m_elements[offset], space < toEnd ? space : toEnd };
+    }
+
+    /// @brief Publishes elements written directly to the region returned by `writeSpan()`.
+    /// @param count The number of elements written. Must not exceed the span length.
+    void commitWrite(size_t count)
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+public: // Consumer API:
+
+    /// @brief Reads one element.
+    /// @param element Target reference.
+    /// @returns True if read, false if the buffer is empty.
+    bool pop(TElement& element)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_head.load(std::memory_order_acquire) == tail) return false;
+        element = m_elements[tail & mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Reads as many elements as available, using at most 2 block copies.
+    /// @param elements Target elements.
+    /// @param count The maximal number of elements to read.
+    /// @returns The number of elements actually read.
+    size_t popN(TElement* elements, size_t count)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t stored = m_head.load(std::memory_order_acquire) - tail;
+        if (count > stored) count = stored;
+        if (!count) return 0;
+        const size_t offset = tail & mask;
+        const size_t first = count < capacity - offset ? count : capacity - offset;
+        std::memcpy(elements, &m_elements[offset], first * sizeof(TElement));
+        if (count > first) std::memcpy(elements + first, &m_elements[0], (count - first) * sizeof(TElement));
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// @brief Gets the largest contiguous region of stored elements that can be read directly.
+    /// @remarks The region is not released to the producer until `commitRead()` is called.
+    /// @returns A span of stored elements. The length is zero if the buffer is empty.
+    Span readSpan()
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t stored = m_head.load(std::memory_order_acquire) - tail;
+        const size_t offset = tail & mask;
+        const size_t toEnd = capacity - offset;
+        return { &m_elements[offset], stored < toEnd ? stored : toEnd };
+    }
+
+    /// @brief Releases elements read directly from the region returned by `readSpan()`.
+    /// @param count The number of elements consumed. Must not exceed the span length.
+    void commitRead(size_t count)
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /// @brief Discards all stored elements.
+    void clear()
+    {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+
+    static constexpr size_t mask = TSize - 1; // Index mask.
+
+    alignas(cacheLine) std::atomic<size_t> m_head;  // Free-running write counter, owned by the producer.
+    alignas(cacheLine) std::atomic<size_t> m_tail;  // Free-running read counter, owned by the consumer.
+    alignas(cacheLine) TElement m_elements[TSize];  // Element storage.
+
+};
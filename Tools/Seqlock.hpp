@@ -0,0 +1,116 @@
+/**
+ * @file        Seqlock.hpp
+ * @author      Adam Łyskawa
+ *
+ * @brief       A sequence lock publishing a value from one writer to many readers without blocking. Header only.
+ * @remark      A part of the Woof Toolkit (WTK).
+ *
+ * @remarks     The writer makes the sequence odd, stores the value, then makes the sequence even again.
+ *              A reader copies the value between two sequence reads and retries if the sequence was odd
+ *              or changed in the meantime, so it never returns a torn value.
+ *              The value is stored as relaxed atomic words, which compile to plain loads and stores on
+ *              32-bit targets and keep the concurrent copy well defined.
+ *              The lock has no RTOS or HAL dependencies, so it can be compiled and tested on the host.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief A sequence lock for sharing a small value (like a multi-field sensor snapshot) between contexts.
+ *
+ * @remarks Only one context may write. Writing from multiple contexts must be serialized by the caller.
+ *          `read()` retries while a write is in progress, so it must not be called from a context
+ *          that preempts the writer (like an ISR with a higher priority), use `tryRead()` there.
+ *
+ * @tparam T Value type. Must be trivially copyable.
+ */
+template<typename T>
+class Seqlock
+{
+
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock value must be trivially copyable.");
+
+public:
+
+    using ValueType = T;
+
+    /// @brief Creates a sequence lock with a value-initialized value.
+    Seqlock() : m_sequence(0), m_words() { store(T()); }
+
+    /// @brief Creates a sequence lock with an initial value.
+    /// @param value Initial value.
+    Seqlock(const T& value) : m_sequence(0), m_words() { store(value); }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    /// @brief Publishes a new value. Never blocks. ISR safe.
+    /// @param value Value to publish.
+    void write(const T& value)
+    {
+        const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        store(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// @brief Reads a consistent copy of the value, retrying while a write is in progress.
+    /// @returns The last published value.
+    T read() const
+    {
+        T value;
+        while (!tryRead(value));
+        return value;
+    }
+
+    /// @brief Makes one attempt to read a consistent copy of the value. Never blocks. ISR safe.
+    /// @param value Target reference. Not modified if the attempt fails.
+    /// @returns True if read, false if a write was in progress.
+    bool tryRead(T& value) const
+    {
+        const uint32_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        uint32_t words[wordCount];
+        for (size_t i = 0; i < wordCount; ++i) words[i] = m_words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /// @returns The current sequence number. Incremented by 2 with each write, odd while a write is in progress.
+    /// @remarks Can be compared with a previously returned value to skip processing an unchanged value.
+    inline uint32_t sequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+    /// @brief Publishes a new value.
+    Seqlock& operator=(const T& value) { write(value); return *this; }
+
+    /// @returns A consistent copy of the last published value.
+    operator T() const { return read(); }
+
+private:
+
+    static constexpr size_t wordCount = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t); // Storage length.
+
+    /// @brief Copies the value to the storage words.
+    /// @param value Value to store.
+    void store(const T& value)
+    {
+        uint32_t words[wordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < wordCount; ++i) m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> m_sequence;           // Write sequence number, odd while a write is in progress.
+    std::atomic<uint32_t> m_words[wordCount];   // Value storage.
+
+};
@@ -92,6 +92,33 @@ uint8_t isValidDateTime(DateTimeTypeDef* dt)
             && isValidTime(dt->time.h, dt->time.m, dt->time.s) && dt->time.f < 1.0;
 }
 
+#if defined(USE_POSIX)
+
+#include <time.h>
+
+/**
+ * @fn uint8_t SYS_GetDateTime(DateTimeTypeDef*)
+ * @brief Gets the current host system local time as ISO time, the RTC replacement for the host build.
+ * @param dateTime ISO date/time pointer.
+ * @return 1: Success. 0: Failure.
+ */
+uint8_t SYS_GetDateTime(DateTimeTypeDef* dt)
+{
+    struct timespec ts;
+    struct tm lt;
+    if (clock_gettime(CLOCK_REALTIME, &ts) || !localtime_r(&ts.tv_sec, &lt)) return 0;
+    dt->date.y = 1900 + lt.tm_year;
+    dt->date.m = lt.tm_mon + 1;
+    dt->date.d = lt.tm_mday;
+    dt->time.h = lt.tm_hour;
+    dt->time.m = lt.tm_min;
+    dt->time.s = lt.tm_sec;
+    dt->time.f = ts.tv_nsec / 1e9;
+    return 1;
+}
+
+#else
+
 /**
  * @fn void RTC2DateTime(RTC_DateTypeDef*, RTC_TimeTypeDef*, DateTimeTypeDef*)
  * @brief Converts the RTC date and time to ISO date/time.
@@ -174,3 +201,5 @@ HAL_StatusTypeDef RTC_SetDateTime(DateTimeTypeDef* dt)
     status = HAL_RTC_SetTime(&hrtc, &rt, RTC_FORMAT_BIN);
     return status;
 }
+
+#endif
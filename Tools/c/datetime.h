@@ -14,7 +14,11 @@
 
 #pragma once
 
+#if defined(USE_POSIX)
+#include <stdint.h>
+#else
 #include "hal.h"
+#endif
 
 #define ISO_DATE_F "%04u-%02u-%02u" // ISO8601 date format.
 #define ISO_DATE_L 11 // Date string length (trailing zero included).
@@ -29,7 +33,9 @@
 #define ISO_DATE_TIME_NS_F "%04u-%02u-%02u %02u:%02u:%012.9f" // ISO8601 date/time + nanoseconds format.
 #define ISO_DATE_TIME_NS_L 30 // ISO8601 date/time + nanoseconds length (trailing zero included).
 
+#if !defined(USE_POSIX)
 extern RTC_HandleTypeDef hrtc;
+#endif
 
 /**
  * @typedef DateTypeDef
@@ -73,7 +79,11 @@ uint8_t isDayInMonth(uint16_t y, uint8_t m, uint8_t d);
 uint8_t isValidDate(uint16_t y, uint8_t m, uint8_t d);
 uint8_t isValidTime(uint8_t h, uint8_t m, uint8_t s);
 uint8_t isValidDateTime(DateTimeTypeDef* dt);
+#if defined(USE_POSIX)
+uint8_t SYS_GetDateTime(DateTimeTypeDef* dt);
+#else
 void RTC2DateTime(RTC_DateTypeDef* rd, RTC_TimeTypeDef* rt, DateTimeTypeDef* dt);
 void DateTime2RTC(DateTimeTypeDef* dt, RTC_DateTypeDef* rd, RTC_TimeTypeDef* rt);
 HAL_StatusTypeDef RTC_GetDateTime(DateTimeTypeDef* dt);
 HAL_StatusTypeDef RTC_SetDateTime(DateTimeTypeDef* dt);
+#endif
@@ -25,7 +25,7 @@ typedef struct __FS_Placeholder
 /// @brief Physical media type.
 typedef enum
 {
-    FS_MEDIA_NONE, FS_MEDIA_eMMC, FS_MEDIA_SD, FS_MEDIA_USB
+    FS_MEDIA_NONE, FS_MEDIA_eMMC, FS_MEDIA_SD, FS_MEDIA_USB, FS_MEDIA_RAM
 } FS_MediaType;
 
 /// @brief Media format enumeration.
@@ -50,6 +50,15 @@ typedef FX_MEDIA        FS_Media;
 typedef FX_DIR_ENTRY    FS_DirectoryEntry;
 typedef FX_FILE         FS_FileControlBlock;
 typedef ULONG           FS_FileOffset;
+
+/// @brief Open directory handle. The local path keeps the enumeration position.
+typedef struct
+{
+    FX_MEDIA* media;        // Media pointer, `NULL` when closed.
+    FX_LOCAL_PATH path;     // Directory local path.
+    UINT isStarted;         // 1: The first entry was already fetched.
+} FS_DirectoryHandle;
+
 typedef UINT            FS_Status;
 
 #elif defined(USE_FATFS)
@@ -61,10 +70,45 @@ typedef FATFS                               FS_Media;
 
 typedef struct { DIR dir; FILINFO info; }   FS_DirectoryEntry;
 typedef FIL                                 FS_FileControlBlock;
+typedef DIR                                 FS_DirectoryHandle;
 
 typedef FSIZE_t                             FS_FileOffset;
 typedef FRESULT                             FS_Status;
 
+#elif defined(USE_POSIX)
+
+// POSIX types:
+
+#include <dirent.h>
+
+/// @brief POSIX media, a host directory used as the file system root.
+typedef struct
+{
+    const char* directory;  // Host directory path.
+} FS_PosixMedia;
+
+/// @brief POSIX open file.
+typedef struct
+{
+    int fd;                 // File descriptor.
+} FS_PosixFile;
+
+/// @brief POSIX open directory handle.
+typedef struct
+{
+    DIR* dir;               // Directory stream, `NULL` when closed.
+    char path[512];         // Host directory path, used to get the entries metadata.
+} FS_PosixDirectory;
+
+typedef void*               FS_MediaDriver;
+typedef void*               FS_MediaDriverInfo;
+typedef FS_PosixMedia       FS_Media;
+typedef FS_Placeholder      FS_DirectoryEntry;
+typedef FS_PosixFile        FS_FileControlBlock;
+typedef FS_PosixDirectory   FS_DirectoryHandle;
+typedef size_t              FS_FileOffset;
+typedef int                 FS_Status;
+
 #else
 
 // `NullAdapter` types:
@@ -74,6 +118,7 @@ typedef void*           FS_MediaDriverInfo;
 typedef FS_Placeholder  FS_Media;
 typedef FS_Placeholder  FS_DirectoryEntry;
 typedef FS_Placeholder  FS_FileControlBlock;
+typedef FS_Placeholder  FS_DirectoryHandle;
 typedef size_t          FS_FileOffset;
 typedef int             FS_Status;
 
@@ -113,4 +158,17 @@ int fs_umount(const char* root);
 /// @returns 1 if the media was successfully unmounted, 0 otherwise.
 int fs_umount_media(FS_Media* media);
 
+/// @brief Formats the RAM disk and mounts it at the root registered for `FS_MEDIA_RAM`.
+/// @returns 1 if the RAM disk was successfully mounted, 0 otherwise.
+int fs_ram_mount(void);
+
+#if defined(USE_FILEX)
+/// @brief FileX RAM disk driver, registered for `FS_MEDIA_RAM`.
+/// @param media Media pointer.
+VOID fs_ram_driver(FX_MEDIA* media);
+#elif defined(USE_FATFS)
+/// @brief FATFS RAM disk driver, its address is registered for `FS_MEDIA_RAM`.
+extern const Diskio_drvTypeDef fs_ram_driver;
+#endif
+
 EXTERN_C_END
@@ -10,6 +10,8 @@
  * @copyright   (c)2024 CodeDog, All rights reserved.
  */
 
+#if !defined(USE_POSIX)
+
 #include "hal.h"
 #include "itm.h"
 
@@ -42,3 +44,5 @@ int _write(int file, char *ptr, int len)
     for (int i = 0; i < len; i++) ITM_SendChar(*ptr++);
     return len;
 }
+
+#endif
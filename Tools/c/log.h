@@ -12,14 +12,18 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#if !defined(USE_POSIX)
 #include "hal.h"
+#endif
 
 /// @brief Initializes the default log level.
 /// @param isRelease 1: RELEASE build, fewer messages. 0: DEBUG build, more messages.
 void log_level(bool isRelease);
 
+#if !defined(USE_POSIX)
 /// @brief Initializes the UART debug module by providing the configured UART handle pointer.
 void log_init(UART_HandleTypeDef* huart);
+#endif
 
 /// @brief Sends a debug message.
 /// @param severity 0: error, 1: warning, 2: info, 3: debug, 4: detail, 5: spam.
@@ -0,0 +1,30 @@
+/**
+ * @file        os_bindings.h
+ * @author      Adam Łyskawa
+ *
+ * @brief       RTOS API C bindings.
+ * @remark      A part of the Woof Toolkit (WTK), RTOS API.
+ *
+ * @copyright   (c)2024 CodeDog, All rights reserved.
+ */
+
+#pragma once
+
+#include "bindings.h"
+
+EXTERN_C_BEGIN
+
+/// @brief Profiler hook: the task is scheduled to run (FreeRTOS `traceTASK_SWITCHED_IN`).
+/// @param handle RTOS task handle.
+void os_profiler_switched_in(void* handle);
+
+/// @brief Profiler hook: the current task stops running (FreeRTOS `traceTASK_SWITCHED_OUT`).
+void os_profiler_switched_out(void);
+
+/// @brief Profiler hook: call at the start of an interrupt service routine to attribute its cycles to interrupts.
+void os_profiler_isr_enter(void);
+
+/// @brief Profiler hook: call at the end of an interrupt service routine.
+void os_profiler_isr_exit(void);
+
+EXTERN_C_END
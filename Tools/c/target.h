@@ -16,11 +16,14 @@
 #define MCU_PREFIX              stm32u5a9           // MCU specific include file name prefix.
 #define HAL_PREFIX              stm32u5xx_hal       // MCU specific HAL include file name prefix.
 
+#if !defined(USE_POSIX) // Host builds select the POSIX backend on the compiler command line.
 #define USE_AZURE_RTOS                              // Use AzureRTOS as the Real Time Operating System.
 #define USE_FILEX                                   // Use FILEX as the file system access backend.
+#endif
 
 // #define USE_FREE_RTOS                               // Use FreeRTOS as the Real Time Operationg System.
 // #define USE_FATFS                                   // Use FATFS as the file system access backend.
+// #define USE_POSIX                                   // Host build: POSIX files and threads, no HAL, no RTOS. See `Tools/Host/Makefile`.
 
 // FOLLOWING VALUES AFFECT BOTH SYSTEM PERFORMANCE AND MEMORY REQUIREMENTS:
 
@@ -28,7 +31,42 @@
 #define WTK_LOG_Q               64                  // The number of log messages that can be stored in RAM before the first one is committed.
 #define WTK_LOG_MSG_SIZE        128                 // The number of bytes allocated for 1 system log message.
 #define WTK_OS_TASKS            16                  // The number of pre-allocated scheduled tasks, default 16.
+#define WTK_OS_FRAME_BUDGET_US  2000                // The CPU time in microseconds the `frame` context tasks can use in one display frame.
+#define WTK_OS_PROFILER_THREADS 24                  // The number of `OS::Profiler` slots, 3 of them are reserved for idle, interrupts and other.
+#define WTK_OS_TIMER_WHEEL      64                  // The number of `OS::TimerService` wheel slots, must be a power of 2.
+#define WTK_OS_LOCK_STATS       16                  // The number of `OS::LockProfiler` slots for profiled mutexes and semaphores.
 #define WTK_OS_THREAD_STACK     4096                // The number of bytes allocated for `OS::Thread` instance stack.
+#define WTK_OS_SCHEDULER_STACK  1024                // The number of bytes allocated for the `TaskScheduler` delay thread stack, about 600 used at most.
+#define WTK_LOG_THREAD_STACK    1024                // The number of bytes allocated for the asynchronous log sender thread stack.
+#define WTK_FS_ASYNC_QUEUE      16                  // The number of `FS::AsyncIO` requests that can be queued, must be a power of 2.
+#define WTK_FS_ASYNC_FILES      4                   // The number of files that can be open with `FS::AsyncIO` at the same time.
+#define WTK_FS_ASYNC_CHUNK      32768               // The maximal number of bytes `FS::AsyncIO` transfers in one file system call.
+#define WTK_FS_ASYNC_STACK      4096                // The number of bytes allocated for the `FS::AsyncIO` thread stack.
+#define WTK_FS_DIRECTORY_BATCH  2                   // The number of entries `FS::Directory` fetches from the file system at a time, about 280 bytes each.
+#define WTK_FS_STAT_CACHE       16                  // The number of `FS::StatCache` entries for `FS::stat()` results.
+#define WTK_FS_MEDIA_CACHE      131072              // The number of bytes of the FileX sector cache for one media, up to `FX_MAX_SECTOR_CACHE` sectors.
+#define WTK_FS_MEDIA_CACHE_SLOTS 1                  // The number of `FS::MediaCache` buffers for the media opened by other middlewares (USB MSC).
+#define WTK_FS_MEDIA_CACHE_SECTION "MediaCacheSection" // The linker section of the media cache buffers.
+#define WTK_FS_MEDIA_FLUSH      1000                // The period in milliseconds of writing the cached sectors of the mounted media, 0 to disable.
+#define WTK_FS_RAM_DISK         262144              // The number of bytes of the `FS::RamDisk` scratch media, a multiple of 4096.
+#define WTK_FS_RAM_DISK_SECTION "RamDiskSection"    // The linker section of the RAM disk, internal SRAM or a writable memory mapped device.
+#define WTK_FS_BENCHMARK_SECTION "BenchmarkSection" // The linker section of the `FS::Test::benchmark()` buffer, `FS::Benchmark::maxBlockSize` bytes.
+#define WTK_FS_COPY_BUFFER      65536               // The number of bytes of the `FS::CopyEngine` buffer ring.
+#define WTK_FS_COPY_BUFFERS     4                   // The maximal number of `FS::CopyEngine` buffers in the ring, at least 2.
+#define WTK_FS_COPY_STACK       4096                // The number of bytes allocated for the `FS::CopyEngine` writer thread stack.
+#define WTK_FS_COPY_DEPTH       4                   // The maximal directory depth `FS::copyTree()` descends to.
+#define WTK_FS_KV_KEY           31                  // The maximal `FS::KVStore` key length in characters.
+#define WTK_FS_KV_VALUE         256                 // The maximal `FS::KVStore` value size in bytes.
+#define WTK_FS_KV_SEGMENT       16384               // The number of bytes after which `FS::KVStore` starts a new segment file.
+#define WTK_FS_KV_SEGMENTS      4                   // The number of `FS::KVStore` segment files above which the oldest one is compacted.
+#define WTK_FS_TS_CHUNK         10000               // The default `FS::TimeSeries` chunk duration in milliseconds.
+#define WTK_FS_TS_SAMPLES       256                 // The number of samples `FS::TimeSeriesT` buffers before a chunk is written.
+#define WTK_FS_LZ4_BLOCK        16384               // The default `FS::CompressedFileT` block size in bytes, up to 65536.
+#define WTK_FS_LZ4_HASH_BITS    12                  // The number of bits of the `FS::CompressedFile` match finder hash, the table has 2 bytes per entry.
+#define WTK_FS_WRITE_STREAMS    8                   // The number of `FS::ScheduledFile` streams `FS::WriteScheduler` serves at the same time.
+#define WTK_FS_WRITE_PERIOD     100                 // The default `FS::WriteScheduler` write period in milliseconds.
+#define WTK_FS_WRITE_BURST      32768               // The maximal number of bytes written from one stream in one `FS::WriteScheduler` cycle.
+#define WTK_FS_WRITE_STACK      4096                // The number of bytes allocated for the `FS::WriteScheduler` thread stack.
 
 // SET EXACTLY AS IN THE TARGET RTOS CONFIGURATION:
 
@@ -36,3 +74,4 @@
 
 #define FS_SD_ROOT              "0:/"
 #define FS_USB_ROOT             "1:/"
+#define FS_RAM_ROOT             "2:/"
@@ -2,6 +2,7 @@
 #include <gui/model/ModelListener.hpp>
 #if DEVICE
 #include "HMI.hpp"
+#include "OS/AppThread.hpp"
 #endif
 
 Model::Model() : modelListener(0)
@@ -19,4 +20,7 @@ void Model::tick()
         HMI::init(HMI_DISPLAY);
 #endif
     }
+#if DEVICE
+    OS::AppThread::frame();
+#endif
 }
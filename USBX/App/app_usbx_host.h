@@ -40,7 +40,7 @@ extern "C" {
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
-#define USBX_HOST_MEMORY_STACK_SIZE     46*1024
+#define USBX_HOST_MEMORY_STACK_SIZE     62*1024
 
 #define UX_HOST_APP_THREAD_STACK_SIZE   4*1024
 #define UX_HOST_APP_THREAD_PRIO         10